@@ -1,6 +1,29 @@
 #!/bin/bash
 set -e
+# VEGA_THREADED_DISPATCH=0 builds run_threaded() as a switch loop instead of computed goto
+THREADED=${VEGA_THREADED_DISPATCH:-1}
 cd libs
-g++ -std=c++20 -O3 -c vega.cpp -o vega.o 
-ar rcs libvega.a vega.o
+g++ -std=c++20 -O3 -c wavefront.cpp -o wavefront.o
+g++ -std=c++20 -O3 -c uop_cache.cpp -o uop_cache.o
+g++ -std=c++20 -O3 -c fold.cpp -o fold.o
+g++ -std=c++20 -O3 -c liveness.cpp -o liveness.o
+g++ -std=c++20 -O3 -c fuse.cpp -o fuse.o
+g++ -std=c++20 -O3 -DVEGA_THREADED_DISPATCH=$THREADED -c threaded.cpp -o threaded.o
+g++ -std=c++20 -O3 -c jit_x64.cpp -o jit_x64.o
+g++ -std=c++20 -O3 -c valu.cpp -o valu.o
+g++ -std=c++20 -O3 -c salu.cpp -o salu.o
+g++ -std=c++20 -O3 -pthread -c dispatcher.cpp -o dispatcher.o
+g++ -std=c++20 -O3 -c assembler.cpp -o assembler.o
+g++ -std=c++20 -O3 -c disassembler.cpp -o disassembler.o
+g++ -std=c++20 -O3 -c elf.cpp -o elf.o
+g++ -std=c++20 -O3 -c mapped_file.cpp -o mapped_file.o
+g++ -std=c++20 -O3 -c memory.cpp -o memory.o
+g++ -std=c++20 -O3 -c code_object.cpp -o code_object.o
+g++ -std=c++20 -O3 -c timing.cpp -o timing.o
+g++ -std=c++20 -O3 -c profile.cpp -o profile.o
+g++ -std=c++20 -O3 -c checkpoint.cpp -o checkpoint.o
+g++ -std=c++20 -O3 -pthread -c trace.cpp -o trace.o
+# ar only adds members, so start from an empty archive
+rm -f libvega.a
+ar rcs libvega.a wavefront.o uop_cache.o fold.o liveness.o fuse.o threaded.o jit_x64.o valu.o salu.o dispatcher.o assembler.o disassembler.o elf.o mapped_file.o memory.o code_object.o timing.o trace.o profile.o checkpoint.o
 cd ..
@@ -0,0 +1,4 @@
+#!/bin/bash
+set -e
+# Needs libs/libvega.a from BUILD.sh
+g++ -std=c++20 -O3 bench.cpp libs/libvega.a -o bench
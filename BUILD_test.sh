@@ -1,4 +1,4 @@
 #!/bin/bash
 set -e
-g++ -std=c++20 test.cpp -o test
-
+# Needs libs/libvega.a from BUILD.sh
+g++ -std=c++20 -O3 -pthread test.cpp libs/libvega.a -o test
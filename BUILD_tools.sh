@@ -0,0 +1,5 @@
+#!/bin/bash
+set -e
+# Needs libs/libvega.a from BUILD.sh
+g++ -std=c++20 -O3 tools/disasm.cpp libs/libvega.a -o tools/disasm
+g++ -std=c++20 -O3 -pthread tools/trace.cpp libs/libvega.a -o tools/trace
@@ -0,0 +1,266 @@
+#include "libs/assembler.hpp"
+#include "libs/registry.hpp"
+#include "libs/threaded.hpp"
+#include "libs/uop_cache.hpp"
+#include "libs/wavefront.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Microbenchmarks for every struct in vega::SOP1::ALL / vega::SOP2::ALL.
+//   execute  - T::execute() called directly
+//   registry - SOP*_REGISTRY entry ->run(), entry looked up once
+//   lookup   - find_sop*(NAME)->run(), name lookup on every call
+// and for whole programs, in ns per executed instruction:
+//   decode   - Wavefront::run(code), decoding every word as it goes
+//   uop      - Wavefront::run(translation), an indirect call per µop
+//   threaded - run_threaded(), the direct-threaded loop
+// Usage: bench [--csv|--json] [--min-time=SECONDS] [--filter=SUBSTRING]
+
+namespace
+{
+    constexpr size_t INPUTS = 1024; // power of two, indexed with a mask
+
+    template<typename T>
+    inline void keep(const T& value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    struct Inputs
+    {
+        std::vector<uint64_t> S0;
+        std::vector<uint64_t> S1;
+
+        Inputs()
+        {
+            std::mt19937_64 rng(0x5EEDULL);
+            for (size_t i = 0; i < INPUTS; ++i)
+            {
+                // Mix of sparse, dense and random words so data-dependent loops see all cases.
+                const uint64_t r = rng();
+                S0.push_back(i % 3 == 0 ? r : i % 3 == 1 ? (r & (r >> 7)) : ~(r & (r >> 5)));
+                S1.push_back(rng());
+            }
+        }
+    };
+
+    constexpr const char* INSTRUCTION_PATHS[3] = { "execute", "registry", "lookup" };
+    constexpr const char* PROGRAM_PATHS[3]     = { "decode", "uop", "threaded" };
+
+    struct Result
+    {
+        std::string        name;
+        const char*        format = "";
+        double             ns[3]  = {}; // by path
+        const char* const* paths  = INSTRUCTION_PATHS;
+    };
+
+    double min_time = 0.2;
+
+    // Doubles the iteration count until one batch lasts min_time, returns ns per call.
+    template<typename F>
+    double measure(F&& body)
+    {
+        using clock = std::chrono::steady_clock;
+        for (uint64_t iters = 1024;; iters *= 2)
+        {
+            const auto start = clock::now();
+            for (uint64_t i = 0; i < iters; ++i)
+            {
+                body(i & (INPUTS - 1));
+            }
+            const double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+            if (elapsed >= min_time || iters >= (1ULL << 40))
+            {
+                return elapsed * 1e9 / static_cast<double>(iters);
+            }
+        }
+    }
+
+    template<typename T>
+    void direct_sop1(const Inputs& in, size_t i, uint64_t& D, bool& scc)
+    {
+        using E   = vega::Execute<T>;
+        using D_t = std::remove_reference_t<typename E::template Arg<1>>;
+        const auto S0 = static_cast<typename E::template Arg<0>>(in.S0[i]);
+        D_t d = static_cast<D_t>(D);
+        if constexpr (E::ARITY == 3) T::execute(S0, d, scc);
+        else                         T::execute(S0, d);
+        D = d;
+    }
+
+    template<typename T>
+    void direct_sop2(const Inputs& in, size_t i, uint64_t& D, bool& scc)
+    {
+        using E   = vega::Execute<T>;
+        using D_t = std::remove_reference_t<typename E::template Arg<2>>;
+        const auto S0 = static_cast<typename E::template Arg<0>>(in.S0[i]);
+        const auto S1 = static_cast<typename E::template Arg<1>>(in.S1[i]);
+        D_t d = 0;
+        if constexpr (E::ARITY == 4) T::execute(S0, S1, d, scc);
+        else                         T::execute(S0, S1, d);
+        D = d;
+    }
+
+    template<typename T>
+    Result bench_sop1(const Inputs& in)
+    {
+        Result   r{ T::NAME, "SOP1" };
+        uint64_t D   = 0;
+        bool     scc = false;
+
+        r.ns[0] = measure([&](size_t i) { direct_sop1<T>(in, i, D, scc); keep(D); });
+
+        const vega::SOP1_Entry* entry = vega::find_sop1(T::NAME);
+        r.ns[1] = measure([&](size_t i) { entry->run(in.S0[i], D, scc); keep(D); });
+
+        const std::string name = T::NAME;
+        r.ns[2] = measure([&](size_t i) { vega::find_sop1(name)->run(in.S0[i], D, scc); keep(D); });
+        return r;
+    }
+
+    template<typename T>
+    Result bench_sop2(const Inputs& in)
+    {
+        Result   r{ T::NAME, "SOP2" };
+        uint64_t D   = 0;
+        bool     scc = false;
+
+        r.ns[0] = measure([&](size_t i) { direct_sop2<T>(in, i, D, scc); keep(D); });
+
+        const vega::SOP2_Entry* entry = vega::find_sop2(T::NAME);
+        r.ns[1] = measure([&](size_t i) { entry->run(in.S0[i], in.S1[i], D, scc); keep(D); });
+
+        const std::string name = T::NAME;
+        r.ns[2] = measure([&](size_t i) { vega::find_sop2(name)->run(in.S0[i], in.S1[i], D, scc); keep(D); });
+        return r;
+    }
+
+    struct Counter
+    {
+        uint64_t instructions = 0;
+        void issue(const vega::Wavefront&, uint32_t, const vega::Instruction&, uint32_t) { ++instructions; }
+        void retire(const vega::Wavefront&, const vega::Instruction&) {}
+    };
+
+    // Loops whose bodies are mostly ALU work, or mostly branches.
+    struct Program
+    {
+        const char* name;
+        const char* source;
+    };
+
+    constexpr Program PROGRAMS[] = {
+        { "alu_loop",
+          "s_movk_i32 s20, 0x400\n"
+          "s_mov_b32 s1, 0x1234567\n s_mov_b32 s2, 0x89abcdef\n"
+          "loop:\n"
+          "  s_add_u32 s1, s1, s2\n  s_addc_u32 s3, s3, 0\n  s_xor_b32 s2, s2, s1\n"
+          "  s_lshl_b32 s4, s1, 3\n  s_and_b32 s5, s4, s2\n  s_or_b32 s6, s5, s3\n"
+          "  s_max_u32 s7, s6, s1\n  s_bcnt1_i32_b32 s8, s7\n  s_add_u32 s9, s9, s8\n"
+          "  s_addk_i32 s20, -1\n  s_cmp_lg_u32 s20, 0\n  s_cbranch_scc1 loop\n  s_endpgm\n" },
+        { "branch_loop",
+          "s_movk_i32 s20, 0x400\n"
+          "loop:\n"
+          "  s_and_b32 s1, s20, 1\n  s_cmp_eq_u32 s1, 0\n  s_cbranch_scc1 even\n"
+          "  s_add_u32 s2, s2, s20\n  s_branch next\n"
+          "even:\n"
+          "  s_xor_b32 s3, s3, s20\n"
+          "next:\n"
+          "  s_addk_i32 s20, -1\n  s_cmp_lg_u32 s20, 0\n  s_cbranch_scc1 loop\n  s_endpgm\n" },
+    };
+
+    Result bench_program(const Program& program)
+    {
+        Result r{ program.name, "program" };
+        r.paths = PROGRAM_PATHS;
+
+        std::vector<uint32_t> code;
+        if (!vega::assemble(program.source, code)) return r;
+        const vega::Translation  translation = vega::translate(code);
+        const vega::ThreadedCode threaded    = vega::thread_code(translation);
+
+        // One wavefront reused across runs: constructing one clears its whole VGPR file.
+        auto    wave = std::make_unique<vega::Wavefront>();
+        Counter count;
+        wave->run(translation, count);
+        const double per_run = static_cast<double>(count.instructions);
+
+        r.ns[0] = measure([&](size_t) { wave->PC = 0; wave->run(code); keep(wave->SGPR[9]); }) / per_run;
+        r.ns[1] = measure([&](size_t) { wave->run(translation); keep(wave->SGPR[9]); }) / per_run;
+        r.ns[2] = measure([&](size_t) { vega::run_threaded(*wave, threaded); keep(wave->SGPR[9]); }) / per_run;
+        return r;
+    }
+
+    template<typename... Ts>
+    void run_sop1(vega::InstructionList<Ts...>, const Inputs& in, const char* filter, std::vector<Result>& out)
+    {
+        ((std::strstr(Ts::NAME, filter) ? out.push_back(bench_sop1<Ts>(in)) : void()), ...);
+    }
+
+    template<typename... Ts>
+    void run_sop2(vega::InstructionList<Ts...>, const Inputs& in, const char* filter, std::vector<Result>& out)
+    {
+        ((std::strstr(Ts::NAME, filter) ? out.push_back(bench_sop2<Ts>(in)) : void()), ...);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool        json   = false;
+    const char* filter = "";
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--json") == 0)               json = true;
+        else if (std::strcmp(argv[i], "--csv") == 0)           json = false;
+        else if (std::strncmp(argv[i], "--min-time=", 11) == 0) min_time = std::atof(argv[i] + 11);
+        else if (std::strncmp(argv[i], "--filter=", 9) == 0)   filter = argv[i] + 9;
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--csv|--json] [--min-time=SECONDS] [--filter=SUBSTRING]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    const Inputs        inputs;
+    std::vector<Result> results;
+    run_sop2(vega::SOP2::ALL{}, inputs, filter, results);
+    run_sop1(vega::SOP1::ALL{}, inputs, filter, results);
+    for (const Program& program : PROGRAMS)
+    {
+        if (std::strstr(program.name, filter)) results.push_back(bench_program(program));
+    }
+    if (json)
+    {
+        std::printf("{\n  \"benchmarks\": [\n");
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            for (int p = 0; p < 3; ++p)
+            {
+                const bool last = i + 1 == results.size() && p == 2;
+                std::printf("    {\"name\": \"%s\", \"format\": \"%s\", \"path\": \"%s\", \"ns_per_op\": %.3f, \"ops_per_sec\": %.0f}%s\n",
+                            results[i].name.c_str(), results[i].format, results[i].paths[p], results[i].ns[p], 1e9 / results[i].ns[p], last ? "" : ",");
+            }
+        }
+        std::printf("  ]\n}\n");
+    }
+    else
+    {
+        std::printf("name,format,path,ns_per_op,ops_per_sec\n");
+        for (const Result& r : results)
+        {
+            for (int p = 0; p < 3; ++p)
+            {
+                std::printf("%s,%s,%s,%.3f,%.0f\n", r.name.c_str(), r.format, r.paths[p], r.ns[p], 1e9 / r.ns[p]);
+            }
+        }
+    }
+    return 0;
+}
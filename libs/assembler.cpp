@@ -0,0 +1,444 @@
+#include "assembler.hpp"
+#include "registry.hpp"
+#include "syntax.hpp"
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+namespace vega
+{
+    namespace
+    {
+        using syntax::Mnemonic;
+
+        template<typename... S1, typename... S2>
+        constexpr auto make_mnemonics(InstructionList<S1...>, InstructionList<S2...>)
+        {
+            return make_registry(std::array<Mnemonic, sizeof...(S1) + sizeof...(S2)>{ syntax::sop1<S1>()..., syntax::sop2<S2>()... });
+        }
+
+        template<typename... SC, typename... SK, typename... SP>
+        constexpr auto make_mnemonics(InstructionList<SC...>, InstructionList<SK...>, InstructionList<SP...>)
+        {
+            return make_registry(std::array<Mnemonic, sizeof...(SC) + sizeof...(SK) + sizeof...(SP)>{
+                syntax::sopc<SC>()..., syntax::sopk<SK>()..., syntax::sopp<SP>()... });
+        }
+
+        template<typename... SM>
+        constexpr auto make_smem_mnemonics(InstructionList<SM...>)
+        {
+            return make_registry(std::array<Mnemonic, sizeof...(SM)>{ syntax::smem<SM>()... });
+        }
+
+        // Several tables: a perfect hash over all of them at once takes the compiler too long to find.
+        constexpr auto MNEMONICS         = make_mnemonics(SOP1::ALL{}, SOP2::ALL{});
+        constexpr auto CONTROL_MNEMONICS = make_mnemonics(SOPC::ALL{}, SOPK::ALL{}, SOPP::ALL{});
+        constexpr auto MEMORY_MNEMONICS  = make_smem_mnemonics(SMEM::ALL{});
+
+        constexpr size_t MAX_MNEMONIC = 32;
+
+        struct Parsed
+        {
+            uint8_t  code    = 0;
+            bool     literal = false;
+            uint32_t value   = 0; // literal dword
+        };
+
+        constexpr bool is_ident(char c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+        }
+
+        constexpr char lower(char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c + ('a' - 'A')) : c; }
+
+        // A branch to a label, patched once every label is known.
+        struct Fixup
+        {
+            std::string_view label;
+            size_t           word;   // index of the SOPP word in `out`
+            uint32_t         line;
+            uint32_t         column;
+        };
+
+        struct Parser
+        {
+            const char* p;
+            const char* end;
+            const char* line_start;
+            uint32_t    line = 1;
+            const char* error = nullptr;
+            const char* error_at = nullptr;
+
+            std::unordered_map<std::string_view, size_t> labels; // index in `out` of the instruction after each
+            std::vector<Fixup>                           fixups;
+
+            explicit Parser(std::string_view source)
+                : p(source.data()), end(source.data() + source.size()), line_start(source.data()) {}
+
+            bool fail(const char* message, const char* at)
+            {
+                error    = message;
+                error_at = at;
+                return false;
+            }
+
+            void skip_blank()
+            {
+                while (p < end && (*p == ' ' || *p == '\t')) ++p;
+            }
+
+            bool at_line_end() const
+            {
+                return p == end || *p == '\n' || *p == '\r' || *p == ';' || (*p == '/' && p + 1 < end && p[1] == '/');
+            }
+
+            void next_line()
+            {
+                while (p < end && *p != '\n') ++p;
+                if (p < end) ++p;
+                line_start = p;
+                ++line;
+            }
+
+            // Register indices only, so anything past four digits is out of range anyway.
+            bool number(uint32_t& out)
+            {
+                const char* first = p;
+                out = 0;
+                while (p < end && *p >= '0' && *p <= '9' && p - first < 5) out = out * 10 + static_cast<uint32_t>(*p++ - '0');
+                return p != first && (p == end || *p < '0' || *p > '9');
+            }
+
+            bool sgpr(uint32_t& n, const char* at)
+            {
+                if (!number(n))              return fail("bad register", at);
+                if (n > Operand::SGPR_LAST)  return fail("SGPR index out of range", at);
+                return true;
+            }
+
+            // s<n>, s[<n>], s[<n>:<n+1>]; SMEM also takes s[<n>:<n+3>] and longer
+            bool registers(uint8_t bytes, Parsed& out)
+            {
+                const char* at = p;
+                ++p; // 's'
+                uint32_t lo = 0, hi = 0;
+                if (*p != '[')
+                {
+                    if (!sgpr(lo, at)) return false;
+                    hi = lo;
+                }
+                else
+                {
+                    ++p;
+                    if (!sgpr(lo, at)) return false;
+                    hi = lo;
+                    if (p < end && *p == ':')
+                    {
+                        ++p;
+                        if (!sgpr(hi, at)) return false;
+                    }
+                    if (p == end || *p != ']') return fail("expected ']'", p);
+                    ++p;
+                }
+                if (bytes > 8)
+                {
+                    if (hi < lo || (hi - lo + 1) * 4 != bytes) return fail("register range has the wrong length", at);
+                    if (lo % 4 != 0)                           return fail("register range must start on a multiple of 4", at);
+                    out.code = static_cast<uint8_t>(lo);
+                    return true;
+                }
+                const uint8_t width = hi == lo ? 4 : 8;
+                if (hi != lo && hi != lo + 1) return fail("register range must be a pair", at);
+                if (width != bytes)           return fail(bytes == 8 ? "operand needs a 64-bit pair s[n:n+1]" : "operand is 32-bit", at);
+                if (width == 8 && lo % 2 != 0) return fail("64-bit pair must start on an even register", at);
+                out.code = static_cast<uint8_t>(lo);
+                return true;
+            }
+
+            bool named(uint8_t bytes, bool destination, Parsed& out)
+            {
+                const char* at = p;
+                while (p < end && is_ident(*p)) ++p;
+                const size_t length = static_cast<size_t>(p - at);
+                for (const syntax::Named& n : syntax::NAMED)
+                {
+                    if (n.name.size() != length) continue;
+                    bool match = true;
+                    for (size_t i = 0; i < length && match; ++i) match = lower(at[i]) == n.name[i];
+                    if (!match) continue;
+                    if (n.bytes == 0 && destination) return fail("destination must be a register", at);
+                    if (n.bytes != 0 && n.bytes != bytes)
+                    {
+                        return fail(bytes == 8 ? "operand is 64-bit" : bytes == 4 ? "operand is 32-bit" : "operand needs a register range s[n:m]", at);
+                    }
+                    out.code = n.code;
+                    return true;
+                }
+                return fail("unknown operand", at);
+            }
+
+            bool constant(uint8_t bytes, Parsed& out)
+            {
+                const char* at = p;
+                const bool negative = *p == '-';
+                if (negative || *p == '+') ++p;
+
+                const char* digits = p;
+                bool is_float = false;
+                while (p < end && (is_ident(*p) || *p == '.' || ((*p == '-' || *p == '+') && (p[-1] == 'e' || p[-1] == 'E'))))
+                {
+                    is_float = is_float || *p == '.';
+                    ++p;
+                }
+                const bool hex = p - digits > 2 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X');
+                if (hex) is_float = false;
+
+                if (is_float)
+                {
+                    double value = 0;
+                    const auto [ptr, ec] = std::from_chars(digits, p, value);
+                    if (ec != std::errc() || ptr != p) return fail("bad number", at);
+                    if (negative) value = -value;
+                    for (int i = 0; i < 9; ++i)
+                    {
+                        if (value == syntax::INLINE_FLOATS[i] || (i == 8 && std::fabs(value - syntax::INLINE_FLOATS[i]) < 1e-8))
+                        {
+                            out.code = static_cast<uint8_t>(Operand::FLOAT_FIRST + i);
+                            return true;
+                        }
+                    }
+                    if (bytes == 8) return fail("64-bit float literals are not encodable", at);
+                    out.code    = Operand::LITERAL;
+                    out.literal = true;
+                    out.value   = std::bit_cast<uint32_t>(static_cast<float>(value));
+                    return true;
+                }
+
+                uint64_t magnitude = 0;
+                const char* first = hex ? digits + 2 : digits;
+                const auto [ptr, ec] = std::from_chars(first, p, magnitude, hex ? 16 : 10);
+                if (ec != std::errc() || ptr != p || first == p) return fail("bad number", at);
+                if (magnitude > (negative ? 0x80000000ULL : 0xFFFFFFFFULL)) return fail("constant does not fit in 32 bits", at);
+                const int64_t value = negative ? -static_cast<int64_t>(magnitude) : static_cast<int64_t>(magnitude);
+
+                if (value >= 0 && value <= 64)
+                {
+                    out.code = static_cast<uint8_t>(Operand::ZERO + value);
+                    return true;
+                }
+                if (value < 0 && value >= -16)
+                {
+                    out.code = static_cast<uint8_t>(Operand::INT_POS_MAX - value);
+                    return true;
+                }
+                // 64-bit operands sign-extend the literal dword.
+                if (bytes == 8 && value > INT32_MAX) return fail("64-bit literal must fit a signed 32-bit value", at);
+                out.code    = Operand::LITERAL;
+                out.literal = true;
+                out.value   = static_cast<uint32_t>(value);
+                return true;
+            }
+
+            bool operand(uint8_t bytes, bool destination, Parsed& out)
+            {
+                skip_blank();
+                if (at_line_end()) return fail("missing operand", p);
+                const char c = *p;
+                if ((c == 's' || c == 'S') && p + 1 < end && ((p[1] >= '0' && p[1] <= '9') || p[1] == '['))
+                {
+                    return registers(bytes, out);
+                }
+                if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+                {
+                    return named(bytes, destination, out);
+                }
+                if (destination) return fail("destination must be a register", p);
+                return constant(bytes, out);
+            }
+
+            // Decimal or 0x hex, optionally signed, within [-min_magnitude, max].
+            bool integer(int64_t& out, uint32_t min_magnitude, uint32_t max, const char* range_error)
+            {
+                skip_blank();
+                if (at_line_end()) return fail("missing operand", p);
+                const char* at = p;
+                const bool negative = *p == '-';
+                if (negative || *p == '+') ++p;
+                const char* digits = p;
+                while (p < end && is_ident(*p)) ++p;
+                const bool  hex   = p - digits > 2 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X');
+                const char* first = hex ? digits + 2 : digits;
+                uint32_t magnitude = 0;
+                const auto [ptr, ec] = std::from_chars(first, p, magnitude, hex ? 16 : 10);
+                if (ec != std::errc() || ptr != p || first == p) return fail("bad number", at);
+                if (magnitude > (negative ? min_magnitude : max)) return fail(range_error, at);
+                out = negative ? -static_cast<int64_t>(magnitude) : static_cast<int64_t>(magnitude);
+                return true;
+            }
+
+            // SOPK/SOPP immediate: 0..0xFFFF, or -0x8000..-1 for its two's complement.
+            bool simm16(uint16_t& out)
+            {
+                int64_t value = 0;
+                if (!integer(value, 0x8000, 0xFFFF, "immediate does not fit in 16 bits")) return false;
+                out = static_cast<uint16_t>(value);
+                return true;
+            }
+
+            // `name:` at the start of a line; false (consuming nothing) if this is not one.
+            bool label(size_t word)
+            {
+                const char* q = p;
+                while (q < end && is_ident(*q)) ++q;
+                if (q == p || q == end || *q != ':') return false;
+                if (!labels.emplace(std::string_view(p, static_cast<size_t>(q - p)), word).second) return fail("label defined twice", p);
+                p = q + 1;
+                return true;
+            }
+
+            bool resolve(std::vector<uint32_t>& out)
+            {
+                for (const Fixup& f : fixups)
+                {
+                    const auto target = labels.find(f.label);
+                    line       = f.line;
+                    line_start = f.label.data() - (f.column - 1);
+                    if (target == labels.end()) return fail("undefined label", f.label.data());
+                    // The offset counts dwords from the instruction after the branch.
+                    const int64_t offset = static_cast<int64_t>(target->second) - static_cast<int64_t>(f.word + 1);
+                    if (offset < INT16_MIN || offset > INT16_MAX) return fail("branch target out of range", f.label.data());
+                    out[f.word] |= static_cast<uint16_t>(offset);
+                }
+                return true;
+            }
+
+            bool comma()
+            {
+                skip_blank();
+                if (p == end || *p != ',') return fail("expected ','", p);
+                ++p;
+                return true;
+            }
+
+            bool instruction(std::vector<uint32_t>& out)
+            {
+                const char* at = p;
+                char name[MAX_MNEMONIC];
+                size_t length = 0;
+                while (p < end && is_ident(*p))
+                {
+                    if (length == MAX_MNEMONIC) return fail("unknown mnemonic", at);
+                    const char c = *p++;
+                    name[length++] = c >= 'a' && c <= 'z' ? static_cast<char>(c - ('a' - 'A')) : c;
+                }
+                if (length == 0) return fail("expected a mnemonic", at);
+                const Mnemonic* m = MNEMONICS.find(std::string_view(name, length));
+                if (m == nullptr) m = CONTROL_MNEMONICS.find(std::string_view(name, length));
+                if (m == nullptr) m = MEMORY_MNEMONICS.find(std::string_view(name, length));
+                if (m == nullptr) return fail("unknown mnemonic", at);
+
+                if (m->format == Format::SOPK || m->format == Format::SOPP) return immediate(*m, out);
+                if (m->format == Format::SMEM) return memory(*m, out);
+
+                Parsed d, s0, s1;
+                if (m->format == Format::SOPC)
+                {
+                    if (!operand(m->S0_bytes, false, s0) || !comma() || !operand(m->S1_bytes, false, s1)) return false;
+                }
+                else if (!operand(m->D_bytes, true, d) || !comma() || !operand(m->S0_bytes, false, s0)) return false;
+                if (m->format == Format::SOP2 && (!comma() || !operand(m->S1_bytes, false, s1))) return false;
+                skip_blank();
+                if (!at_line_end()) return fail("unexpected text after the operands", p);
+                if (s0.literal && s1.literal && s0.value != s1.value) return fail("only one literal per instruction", at);
+
+                out.push_back(m->hex | (static_cast<uint32_t>(d.code) << 16) | (static_cast<uint32_t>(s1.code) << 8) | s0.code);
+                if (s0.literal || s1.literal) out.push_back(s0.literal ? s0.value : s1.value);
+                return true;
+            }
+
+            // SMEM `sdata, sbase, offset [glc]`: the offset is a register holding a byte offset, or
+            // one of -0x100000..0xFFFFF in the instruction.
+            bool memory(const Mnemonic& m, std::vector<uint32_t>& out)
+            {
+                Parsed d, base, offset;
+                if (!operand(m.D_bytes, true, d) || !comma()) return false;
+                skip_blank();
+                const char* at = p;
+                if (!operand(m.S0_bytes, false, base) || !comma()) return false;
+                if (base.code > Operand::EXEC_HI) return fail("base must be registers", at);
+
+                skip_blank();
+                uint32_t word = 0;
+                bool     imm  = !(p < end && ((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z')));
+                if (!imm)
+                {
+                    if (!operand(4, true, offset)) return false;
+                    word = offset.code;
+                }
+                else
+                {
+                    int64_t value = 0;
+                    if (!integer(value, 0x100000, 0xFFFFF, "offset does not fit in 21 bits")) return false;
+                    word = static_cast<uint32_t>(value) & 0x1FFFFF;
+                }
+
+                skip_blank();
+                bool glc = false;
+                if (p + 3 <= end && lower(p[0]) == 'g' && lower(p[1]) == 'l' && lower(p[2]) == 'c' && (p + 3 == end || !is_ident(p[3])))
+                {
+                    glc = true;
+                    p  += 3;
+                    skip_blank();
+                }
+                if (!at_line_end()) return fail("unexpected text after the operands", p);
+                out.push_back(m.hex | (uint32_t{ imm } << 17) | (uint32_t{ glc } << 16) | (static_cast<uint32_t>(d.code) << 6) | (base.code >> 1));
+                out.push_back(word);
+                return true;
+            }
+
+            // SOPK `d, imm16`; SOPP `imm16`, a label for branches, nothing for S_ENDPGM.
+            bool immediate(const Mnemonic& m, std::vector<uint32_t>& out)
+            {
+                Parsed   d;
+                uint16_t imm = 0;
+                if (m.format == Format::SOPK && (!operand(m.D_bytes, true, d) || !comma())) return false;
+                skip_blank();
+                const bool branch = m.format == Format::SOPP && is_control(decode(m.hex)) && m.S0_bytes != 0;
+                if (branch && p < end && ((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z') || *p == '_'))
+                {
+                    const char* at = p;
+                    while (p < end && is_ident(*p)) ++p;
+                    fixups.push_back({ std::string_view(at, static_cast<size_t>(p - at)), out.size(), line,
+                                       static_cast<uint32_t>(at - line_start) + 1 });
+                }
+                else if (m.S0_bytes != 0 && !simm16(imm)) return false;
+                skip_blank();
+                if (!at_line_end()) return fail("unexpected text after the operands", p);
+                out.push_back(m.hex | (static_cast<uint32_t>(d.code) << 16) | imm);
+                return true;
+            }
+        };
+    }
+
+    AssembleResult assemble(std::string_view source, std::vector<uint32_t>& out)
+    {
+        Parser parser(source);
+        const auto failed = [&]() -> AssembleResult
+        {
+            return { parser.error, parser.line, static_cast<uint32_t>(parser.error_at - parser.line_start) + 1 };
+        };
+        out.reserve(out.size() + source.size() / 16);
+        while (parser.p < parser.end)
+        {
+            parser.skip_blank();
+            if (parser.label(out.size())) parser.skip_blank();
+            if (parser.error != nullptr) return failed();
+            if (!parser.at_line_end() && !parser.instruction(out)) return failed();
+            parser.next_line();
+        }
+        if (!parser.resolve(out)) return failed();
+        return {};
+    }
+}
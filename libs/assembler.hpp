@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Text assembler for the scalar formats (SOP1, SOP2, SOPC, SOPK, SOPP, SMEM), one instruction
+// per line, optionally after a `label:`:
+//
+//     s_add_u32   s0, s1, 0x1234      ; comment
+//     S_MOV_B64   s[4:5], exec        // comment
+//     s_cselect_b64 vcc, -1, 0
+// loop:
+//     s_addk_i32  s2, -1
+//     s_cmp_lg_u32 s2, 0
+//     s_cbranch_scc1 loop             ; or a dword offset: s_cbranch_scc1 -3
+//     s_load_dwordx4 s[4:7], s[0:1], 0x10
+//     s_buffer_load_dword s8, s[4:7], s9 glc
+//     s_endpgm
+//
+// Mnemonics are the struct NAMEs in either case. Operands: s<n>, s[<n>] and s[<n>:<n+1>]
+// (64-bit pairs start on an even register), vcc/vcc_lo/vcc_hi, exec/exec_lo/exec_hi, m0,
+// vccz, execz, scc, integers (decimal or 0x hex) and floats. Values with an inline encoding
+// use it, anything else becomes the literal dword; an instruction has at most one literal.
+// SOPK and SOPP immediates are 16 bits, written unsigned or negative. Branch labels may be
+// used before they are defined. SMEM loads name their whole SDATA range (s[n:n+3] and longer
+// ranges start on a multiple of 4) and take a register or a 21-bit signed byte offset.
+namespace vega
+{
+    struct AssembleResult
+    {
+        const char* error  = nullptr; // nullptr on success
+        uint32_t    line   = 0;       // 1-based position of the error
+        uint32_t    column = 0;
+
+        explicit operator bool() const { return error == nullptr; }
+    };
+
+    // Appends the encoded words to `out`; stops at the first error.
+    AssembleResult assemble(std::string_view source, std::vector<uint32_t>& out);
+}
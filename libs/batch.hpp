@@ -0,0 +1,150 @@
+#pragma once
+
+#include "wavefront.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+// One opcode over many independent (S0, S1, D, SCC) lanes, structure-of-arrays. Each kernel
+// is the plain execute() loop instantiated per target ISA so the compiler vectorises it at
+// that width; batch_isa() picks the widest one the host supports at runtime. Every feature
+// a kernel's target string names must be checked in detect_batch_isa().
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define VEGA_BATCH_X86 1
+#else
+#define VEGA_BATCH_X86 0
+#endif
+
+namespace vega
+{
+    enum class BatchIsa : uint8_t
+    {
+        SCALAR,
+        SSE4,
+        AVX2,
+        AVX512,
+    };
+
+    inline BatchIsa detect_batch_isa()
+    {
+    #if VEGA_BATCH_X86
+        __builtin_cpu_init();
+        const bool sse4   = __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt");
+        const bool avx2   = sse4 && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2");
+        const bool avx512 = avx2 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")
+                         && __builtin_cpu_supports("avx512vl");
+        if (avx512) return BatchIsa::AVX512;
+        if (avx2)   return BatchIsa::AVX2;
+        if (sse4)   return BatchIsa::SSE4;
+    #endif
+        return BatchIsa::SCALAR;
+    }
+
+    inline BatchIsa batch_isa()
+    {
+        static const BatchIsa ISA = detect_batch_isa();
+        return ISA;
+    }
+
+    // Lane types follow the struct's execute() signature; B64 results are 64-bit D lanes.
+    template<typename T>
+    struct BatchTypes
+    {
+        using E = Execute<T>;
+        using S0 = typename E::template Arg<0>;
+        using S1 = std::conditional_t<std::is_reference_v<typename E::template Arg<1>>, void, typename E::template Arg<1>>;
+        using D  = std::remove_reference_t<typename E::template Arg<std::is_void_v<S1> ? 1 : 2>>;
+    };
+
+    namespace batch_detail
+    {
+        // The spans may overlap (S0 and D over one buffer runs in place), so nothing is
+        // __restrict: each lane reads its inputs into locals and stores once.
+        template<typename T, typename S0, typename D>
+        [[gnu::always_inline]] inline void sop1_lanes(const S0* s0, D* d, bool* scc, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                const S0 a = s0[i];
+                D        r = d[i];
+                bool     c = scc[i];
+                if constexpr (Execute<T>::ARITY == 3) T::execute(a, r, c);
+                else                                  T::execute(a, r);
+                d[i]   = r;
+                scc[i] = c;
+            }
+        }
+
+        template<typename T, typename S0, typename S1, typename D>
+        [[gnu::always_inline]] inline void sop2_lanes(const S0* s0, const S1* s1, D* d, bool* scc, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                const S0 a = s0[i];
+                const S1 b = s1[i];
+                D        r = d[i];
+                bool     c = scc[i];
+                if constexpr (Execute<T>::ARITY == 4) T::execute(a, b, r, c);
+                else                                  T::execute(a, b, r);
+                d[i]   = r;
+                scc[i] = c;
+            }
+        }
+
+    #if VEGA_BATCH_X86
+        #define VEGA_BATCH_KERNELS(SUFFIX, TARGET) \
+            template<typename T, typename S0, typename D> \
+            [[gnu::target(TARGET)]] void sop1_##SUFFIX(const S0* s0, D* d, bool* scc, size_t n) { sop1_lanes<T>(s0, d, scc, n); } \
+            template<typename T, typename S0, typename S1, typename D> \
+            [[gnu::target(TARGET)]] void sop2_##SUFFIX(const S0* s0, const S1* s1, D* d, bool* scc, size_t n) { sop2_lanes<T>(s0, s1, d, scc, n); }
+
+        VEGA_BATCH_KERNELS(sse4,   "sse4.2,popcnt")
+        VEGA_BATCH_KERNELS(avx2,   "avx2,bmi,bmi2,popcnt")
+        VEGA_BATCH_KERNELS(avx512, "avx512f,avx512bw,avx512vl,avx2,bmi,bmi2,popcnt")
+        #undef VEGA_BATCH_KERNELS
+    #endif
+    }
+
+    // SOP1: D[i], SCC[i] = T(S0[i]); D and SCC are also read by the conditional moves.
+    // D and SCC hold at least S0.size() lanes; D may be S0's buffer.
+    template<typename T>
+    void batch_sop1(std::span<const typename BatchTypes<T>::S0> S0,
+                    std::span<typename BatchTypes<T>::D> D,
+                    std::span<bool> SCC)
+    {
+        const size_t n = S0.size();
+        assert(D.size() >= n && SCC.size() >= n);
+        switch (batch_isa())
+        {
+        #if VEGA_BATCH_X86
+            case BatchIsa::AVX512: batch_detail::sop1_avx512<T>(S0.data(), D.data(), SCC.data(), n); return;
+            case BatchIsa::AVX2:   batch_detail::sop1_avx2<T>(S0.data(), D.data(), SCC.data(), n);   return;
+            case BatchIsa::SSE4:   batch_detail::sop1_sse4<T>(S0.data(), D.data(), SCC.data(), n);   return;
+        #endif
+            default: batch_detail::sop1_lanes<T>(S0.data(), D.data(), SCC.data(), n); return;
+        }
+    }
+
+    // SOP2: D[i], SCC[i] = T(S0[i], S1[i], SCC[i]); SCC is carry-in/select input where the op reads it.
+    // S1, D and SCC hold at least S0.size() lanes; D may be S0's or S1's buffer.
+    template<typename T>
+    void batch_sop2(std::span<const typename BatchTypes<T>::S0> S0,
+                    std::span<const typename BatchTypes<T>::S1> S1,
+                    std::span<typename BatchTypes<T>::D> D,
+                    std::span<bool> SCC)
+    {
+        const size_t n = S0.size();
+        assert(S1.size() >= n && D.size() >= n && SCC.size() >= n);
+        switch (batch_isa())
+        {
+        #if VEGA_BATCH_X86
+            case BatchIsa::AVX512: batch_detail::sop2_avx512<T>(S0.data(), S1.data(), D.data(), SCC.data(), n); return;
+            case BatchIsa::AVX2:   batch_detail::sop2_avx2<T>(S0.data(), S1.data(), D.data(), SCC.data(), n);   return;
+            case BatchIsa::SSE4:   batch_detail::sop2_sse4<T>(S0.data(), S1.data(), D.data(), SCC.data(), n);   return;
+        #endif
+            default: batch_detail::sop2_lanes<T>(S0.data(), S1.data(), D.data(), SCC.data(), n); return;
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+// Bit primitives behind BREV/BCNT/FF/FLBIT/WQM. <bit> lowers to POPCNT/TZCNT/LZCNT when the
+// build enables them (-mpopcnt, -mbmi, -mlzcnt or -march=...); bit reversal uses RBIT on
+// AArch64, __builtin_bitreverse on Clang and a byte-swap + swap-network elsewhere.
+namespace vega::bits
+{
+    static constexpr uint32_t NOT_FOUND = 0xFFFFFFFF;
+
+    template<typename V>
+    constexpr uint32_t count_ones(V v)
+    {
+        return static_cast<uint32_t>(std::popcount(v));
+    }
+
+    template<typename V>
+    constexpr uint32_t count_zeros(V v)
+    {
+        return static_cast<uint32_t>(sizeof(V) * 8 - std::popcount(v));
+    }
+
+    // Index of the lowest set bit, NOT_FOUND for 0.
+    template<typename V>
+    constexpr uint32_t find_first_one(V v)
+    {
+        return v == 0 ? NOT_FOUND : static_cast<uint32_t>(std::countr_zero(v));
+    }
+
+    // Leading zeros before the highest set bit, NOT_FOUND for 0.
+    template<typename V>
+    constexpr uint32_t find_last_one(V v)
+    {
+        return v == 0 ? NOT_FOUND : static_cast<uint32_t>(std::countl_zero(v));
+    }
+
+    constexpr uint32_t reverse_portable(uint32_t v)
+    {
+        v = ((v >> 1) & 0x55555555u) | ((v & 0x55555555u) << 1);
+        v = ((v >> 2) & 0x33333333u) | ((v & 0x33333333u) << 2);
+        v = ((v >> 4) & 0x0F0F0F0Fu) | ((v & 0x0F0F0F0Fu) << 4);
+        return (v >> 24) | ((v >> 8) & 0xFF00u) | ((v << 8) & 0xFF0000u) | (v << 24);
+    }
+
+    constexpr uint32_t reverse(uint32_t v)
+    {
+    #if defined(__clang__)
+        return __builtin_bitreverse32(v);
+    #elif defined(__aarch64__) && defined(__GNUC__)
+        if (std::is_constant_evaluated()) return reverse_portable(v);
+        uint32_t r;
+        asm("rbit %w0, %w1" : "=r"(r) : "r"(v));
+        return r;
+    #else
+        return reverse_portable(v);
+    #endif
+    }
+
+    constexpr uint64_t reverse(uint64_t v)
+    {
+    #if defined(__clang__)
+        return __builtin_bitreverse64(v);
+    #else
+        return (static_cast<uint64_t>(reverse(static_cast<uint32_t>(v))) << 32) | reverse(static_cast<uint32_t>(v >> 32));
+    #endif
+    }
+
+    // Every nibble becomes 0xF if any of its bits is set (S_WQM).
+    template<typename V>
+    constexpr V whole_quad(V v)
+    {
+        constexpr V LOW = static_cast<V>(~V{ 0 } / 0xF); // 0x1111...
+        v |= v >> 1;
+        v |= v >> 2;
+        return (v & LOW) * 0xF;
+    }
+}
@@ -0,0 +1,197 @@
+#include "checkpoint.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace vega
+{
+    namespace
+    {
+        struct FileHeader
+        {
+            static constexpr uint32_t MAGIC   = 0x504B4356; // "VCKP"
+            static constexpr uint32_t VERSION = 1;
+
+            uint32_t magic     = MAGIC;
+            uint32_t version   = VERSION;
+            uint64_t interval  = 0;
+            uint64_t snapshots = 0;
+            uint64_t dwords    = 0; // size of `data`
+        };
+
+        // A page is a sequence of { uint16_t skip, uint16_t count } headers, each followed by
+        // `count` XOR dwords, placed `skip` dwords after the end of the previous run.
+        void encode(const uint32_t* now, const uint32_t* before, std::vector<uint32_t>& out)
+        {
+            int i = 0;
+            for (;;)
+            {
+                int skip = i;
+                while (i < Checkpointer::PAGE_DWORDS && now[i] == before[i]) ++i;
+                skip = i - skip;
+                int count = 0;
+                while (i + count < Checkpointer::PAGE_DWORDS && now[i + count] != before[i + count]) ++count;
+                out.push_back(static_cast<uint32_t>(skip) | (static_cast<uint32_t>(count) << 16));
+                for (int k = 0; k < count; ++k)
+                {
+                    out.push_back(now[i + k] ^ before[i + k]);
+                }
+                i += count;
+                if (i == Checkpointer::PAGE_DWORDS) return;
+            }
+        }
+
+        // Applies one encoded page to `page`; returns the position after it.
+        const uint32_t* decode(const uint32_t* in, uint32_t* page)
+        {
+            int i = 0;
+            while (i < Checkpointer::PAGE_DWORDS)
+            {
+                const uint32_t run = *in++;
+                i += run & 0xFFFF;
+                for (uint32_t k = 0; k < run >> 16; ++k)
+                {
+                    page[i++] ^= *in++;
+                }
+            }
+            return in;
+        }
+
+        // Dwords one encoded page takes from `in`, or 0 when a run would leave the page or
+        // read past `end`. decode() trusts what passes.
+        size_t encoded_size(const uint32_t* in, const uint32_t* end)
+        {
+            const uint32_t* start = in;
+            uint32_t i = 0;
+            while (i < Checkpointer::PAGE_DWORDS)
+            {
+                if (in == end) return 0;
+                const uint32_t run   = *in++;
+                const uint32_t skip  = run & 0xFFFF;
+                const uint32_t count = run >> 16;
+                if (skip + count == 0 || skip + count > Checkpointer::PAGE_DWORDS - i || count > static_cast<size_t>(end - in)) return 0;
+                i  += skip + count;
+                in += count;
+            }
+            return static_cast<size_t>(in - start);
+        }
+
+        bool valid(const Checkpointer::Snapshot& s, const std::vector<uint32_t>& data)
+        {
+            if (s.offset > data.size()) return false;
+            const uint32_t* in  = data.data() + s.offset;
+            const uint32_t* end = data.data() + data.size();
+            for (int page = 0; page < Checkpointer::PAGES; ++page)
+            {
+                if ((s.pages >> page & 1) == 0) continue;
+                const size_t size = encoded_size(in, end);
+                if (size == 0) return false;
+                in += size;
+            }
+            return true;
+        }
+    }
+
+    void Checkpointer::take(const Wavefront& w, uint32_t PC)
+    {
+        const bool keyframe = snapshots.size() % KEYFRAME_INTERVAL == 0;
+        if (keyframe)
+        {
+            dirty = ~uint64_t{ 0 };
+            std::fill(shadow.begin(), shadow.end(), 0);
+        }
+
+        Snapshot& s    = snapshots.emplace_back();
+        s.instructions = instructions;
+        s.pages        = dirty;
+        s.offset       = data.size();
+        s.PC           = PC;
+        s.SCC          = w.SCC;
+        std::memcpy(s.SGPR, w.SGPR, sizeof(s.SGPR));
+
+        const uint32_t* vgpr = &w.VGPR[0][0];
+        for (int page = 0; page < PAGES; ++page)
+        {
+            if ((dirty >> page & 1) == 0) continue;
+            uint32_t* before = &shadow[page * PAGE_DWORDS];
+            encode(vgpr + page * PAGE_DWORDS, before, data);
+            std::memcpy(before, vgpr + page * PAGE_DWORDS, PAGE_DWORDS * sizeof(uint32_t));
+        }
+        dirty = 0;
+    }
+
+    bool Checkpointer::restore(size_t index, Wavefront& w) const
+    {
+        if (index >= snapshots.size()) return false;
+
+        std::memset(w.VGPR, 0, sizeof(w.VGPR));
+        uint32_t* vgpr = &w.VGPR[0][0];
+        for (size_t i = index - index % KEYFRAME_INTERVAL; i <= index; ++i)
+        {
+            const uint32_t* in = data.data() + snapshots[i].offset;
+            for (int page = 0; page < PAGES; ++page)
+            {
+                if ((snapshots[i].pages >> page & 1) != 0) in = decode(in, vgpr + page * PAGE_DWORDS);
+            }
+        }
+
+        const Snapshot& s = snapshots[index];
+        std::memcpy(w.SGPR, s.SGPR, sizeof(w.SGPR));
+        w.SCC = s.SCC != 0;
+        w.PC  = s.PC;
+        return true;
+    }
+
+    bool Checkpointer::save(const char* path) const
+    {
+        std::FILE* f = std::fopen(path, "wb");
+        if (f == nullptr) return false;
+        FileHeader header;
+        header.interval  = interval;
+        header.snapshots = snapshots.size();
+        header.dwords    = data.size();
+        bool ok = std::fwrite(&header, sizeof(header), 1, f) == 1
+               && std::fwrite(snapshots.data(), sizeof(Snapshot), snapshots.size(), f) == snapshots.size()
+               && std::fwrite(data.data(), sizeof(uint32_t), data.size(), f) == data.size();
+        ok = std::fclose(f) == 0 && ok;
+        return ok;
+    }
+
+    bool Checkpointer::load(const char* path)
+    {
+        std::FILE* f = std::fopen(path, "rb");
+        if (f == nullptr) return false;
+        FileHeader header;
+        bool ok = std::fread(&header, sizeof(header), 1, f) == 1
+               && header.magic == FileHeader::MAGIC && header.version == FileHeader::VERSION && header.interval != 0;
+        // The counts must describe exactly the rest of the file before anything is allocated.
+        long here = 0, size = 0;
+        ok = ok && (here = std::ftell(f)) >= 0 && std::fseek(f, 0, SEEK_END) == 0 && (size = std::ftell(f)) >= 0
+                && std::fseek(f, here, SEEK_SET) == 0
+                && header.snapshots <= static_cast<uint64_t>(size - here) / sizeof(Snapshot)
+                && header.dwords <= static_cast<uint64_t>(size - here) / sizeof(uint32_t)
+                && header.snapshots * sizeof(Snapshot) + header.dwords * sizeof(uint32_t) == static_cast<uint64_t>(size - here);
+        if (ok)
+        {
+            clear();
+            interval = header.interval;
+            snapshots.resize(header.snapshots);
+            data.resize(header.dwords);
+            ok = std::fread(snapshots.data(), sizeof(Snapshot), snapshots.size(), f) == snapshots.size()
+              && std::fread(data.data(), sizeof(uint32_t), data.size(), f) == data.size()
+              && std::all_of(snapshots.begin(), snapshots.end(), [&](const Snapshot& s) { return valid(s, data); });
+        }
+        std::fclose(f);
+        if (!ok) clear();
+        return ok;
+    }
+
+    void Checkpointer::clear()
+    {
+        snapshots.clear();
+        data.clear();
+        instructions = 0;
+        countdown    = 1;
+        dirty        = ~uint64_t{ 0 };
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "wavefront.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Periodic snapshots of one wavefront, to restart a long run close to where it went wrong:
+//
+//     Checkpointer checkpoints;
+//     checkpoints.interval = 1 << 20;     // instructions between snapshots
+//     wave.run(program, checkpoints);
+//     ...
+//     Wavefront again;
+//     checkpoints.restore(k, again);      // state just before instruction k * interval
+//     again.run(program);                 // resumes at again.PC
+//
+// A snapshot is taken before the instruction that completes the interval, so it holds
+// everything up to it. Every snapshot stores the scalar state (SGPRs, SCC, PC) in full. The
+// VGPR file is tracked in PAGE_ROWS-row pages: a VOP marks its destination's page dirty when
+// it issues, and a snapshot stores only the dirty pages, as an XOR against that page in the
+// previous snapshot with runs of unchanged dwords skipped. Every KEYFRAME_INTERVAL-th snapshot
+// stores all pages against zero, so restore() replays at most that many snapshots.
+//
+// Writes made outside the run loop (a dispatcher seeding VGPRs, a debugger) are not seen;
+// call mark_all() after them. run(translation, ...) always starts from its first µop, so
+// resume with the decode loop, which starts at PC.
+namespace vega
+{
+    struct Checkpointer
+    {
+        static constexpr int      PAGE_ROWS         = 4;
+        static constexpr int      PAGE_DWORDS       = PAGE_ROWS * Wavefront::LANES;
+        static constexpr int      PAGES             = Wavefront::VGPR_COUNT / PAGE_ROWS;
+        static constexpr uint32_t KEYFRAME_INTERVAL = 64;
+        static_assert(PAGES == 64, "the dirty set is one uint64_t");
+
+        struct Snapshot
+        {
+            uint64_t instructions = 0; // executed before it was taken
+            uint64_t pages        = 0; // VGPR pages encoded in `data`, bit i = page i
+            uint64_t offset       = 0; // into `data`, in dwords
+            uint32_t PC           = 0;
+            uint32_t SCC          = 0;
+            uint32_t SGPR[128]    = {};
+        };
+
+        uint64_t interval = 1 << 20;
+
+        std::vector<Snapshot> snapshots;
+        std::vector<uint32_t> data; // encoded pages of every snapshot, in order
+
+        // Run-loop state
+        uint64_t              instructions = 0;
+        uint64_t              countdown    = 1; // instructions until the next snapshot
+        uint64_t              dirty        = ~uint64_t{ 0 };
+        std::vector<uint32_t> shadow = std::vector<uint32_t>(Wavefront::VGPR_COUNT * Wavefront::LANES); // VGPRs as of the last snapshot
+
+        void issue(const Wavefront& w, uint32_t PC, const Instruction& inst, uint32_t)
+        {
+            if (--countdown == 0)
+            {
+                take(w, PC);
+                countdown = interval;
+            }
+            ++instructions;
+            if (inst.format == Format::VOP1 || inst.format == Format::VOP2) dirty |= uint64_t{ 1 } << (inst.SDST / PAGE_ROWS);
+        }
+
+        void retire(const Wavefront&, const Instruction&) {}
+
+        void mark_all() { dirty = ~uint64_t{ 0 }; }
+
+        // Appends a snapshot of `w` about to execute the instruction at `PC`.
+        void take(const Wavefront& w, uint32_t PC);
+
+        // Rebuilds the state of snapshots[index] in `w`. False if there is no such snapshot.
+        bool restore(size_t index, Wavefront& w) const;
+
+        // Binary file: a header, the Snapshot array, then `data`. False on any I/O error, a
+        // file this version did not write, or encoded pages that run outside a page or `data`.
+        bool save(const char* path) const;
+        bool load(const char* path);
+
+        void clear();
+    };
+}
@@ -0,0 +1,132 @@
+#include "code_object.hpp"
+#include <cstring>
+
+namespace vega
+{
+    namespace
+    {
+        constexpr std::string_view DESCRIPTOR_SUFFIX = ".kd";
+        constexpr size_t           DESCRIPTOR_SIZE   = 64;
+
+        template<typename V>
+        V field(const uint8_t* descriptor, size_t at)
+        {
+            V value;
+            std::memcpy(&value, descriptor + at, sizeof(V));
+            return value;
+        }
+
+        bool is_descriptor(const elf::Symbol& symbol)
+        {
+            return symbol.name.size() > DESCRIPTOR_SUFFIX.size() && symbol.name.ends_with(DESCRIPTOR_SUFFIX);
+        }
+    }
+
+    CodeObject::Status CodeObject::open(const char* path)
+    {
+        if (!file.open(path)) return Status::CANNOT_OPEN;
+        return open(file.bytes());
+    }
+
+    CodeObject::Status CodeObject::open(std::span<const uint8_t> bytes)
+    {
+        image           = bytes;
+        symbols         = {};
+        symbols_located = false;
+        if (!elf::is_elf64(image) || elf::machine(image) != elf::EM_AMDGPU) return Status::NOT_AMDGPU;
+        return Status::OK;
+    }
+
+    CodeObject::Status CodeObject::locate_symbols()
+    {
+        if (!symbols_located)
+        {
+            if (!elf::is_elf64(image) || !elf::find_symbol_table(image, symbols)) return Status::NO_SYMBOLS;
+            symbols_located = true;
+        }
+        return Status::OK;
+    }
+
+    CodeObject::Status CodeObject::find(std::string_view name, Kernel& out)
+    {
+        if (const Status status = locate_symbols(); status != Status::OK) return status;
+
+        elf::Symbol symbol;
+        for (size_t i = 0; symbols.at(image, i, symbol); ++i)
+        {
+            if (symbol.name.size() == name.size() + DESCRIPTOR_SUFFIX.size() && is_descriptor(symbol) && symbol.name.starts_with(name))
+            {
+                return load(symbol, name, out);
+            }
+        }
+        return Status::NO_KERNEL;
+    }
+
+    CodeObject::Status CodeObject::kernel_names(std::vector<std::string_view>& out)
+    {
+        if (const Status status = locate_symbols(); status != Status::OK) return status;
+
+        elf::Symbol symbol;
+        for (size_t i = 0; symbols.at(image, i, symbol); ++i)
+        {
+            if (is_descriptor(symbol)) out.push_back(symbol.name.substr(0, symbol.name.size() - DESCRIPTOR_SUFFIX.size()));
+        }
+        return Status::OK;
+    }
+
+    CodeObject::Status CodeObject::load(const elf::Symbol& descriptor, std::string_view name, Kernel& out)
+    {
+        uint64_t at = 0;
+        if (!elf::file_offset(image, descriptor.section, descriptor.value, DESCRIPTOR_SIZE, at)) return Status::BAD_DESCRIPTOR;
+
+        const uint8_t*   d = image.data() + at;
+        KernelDescriptor kd;
+        kd.group_segment_size   = field<uint32_t>(d, 0);
+        kd.private_segment_size = field<uint32_t>(d, 4);
+        kd.kernarg_size         = field<uint32_t>(d, 8);
+        kd.entry_offset         = field<int64_t>(d, 16);
+        kd.rsrc3                = field<uint32_t>(d, 44);
+        kd.rsrc1                = field<uint32_t>(d, 48);
+        kd.rsrc2                = field<uint32_t>(d, 52);
+        kd.properties           = field<uint16_t>(d, 56);
+
+        // The kernel's function symbol gives the code size. In a relocatable object the entry
+        // offset is still a relocation against it, so the symbol is the entry point as well.
+        elf::Symbol function;
+        bool        has_function = false;
+        for (size_t i = 0; symbols.at(image, i, function); ++i)
+        {
+            if (function.type == elf::STT_FUNC && function.name == name)
+            {
+                has_function = true;
+                break;
+            }
+        }
+
+        const bool relocatable = elf::type(image) == elf::ET_REL;
+        if (relocatable && !has_function) return Status::BAD_DESCRIPTOR;
+        const uint64_t entry = relocatable ? function.value : descriptor.value + static_cast<uint64_t>(kd.entry_offset);
+
+        uint64_t offset = 0, size = 0;
+        if (has_function && function.value == entry)
+        {
+            size = function.size;
+            if (!elf::file_offset(image, function.section, entry, size, offset)) return Status::BAD_DESCRIPTOR;
+        }
+        else
+        {
+            elf::Section text; // no usable symbol: run to the end of .text
+            if (!elf::find_section(image, ".text", text) || entry < text.address || entry - text.address > text.size) return Status::BAD_DESCRIPTOR;
+            offset = text.offset + (entry - text.address);
+            size   = text.size - (entry - text.address);
+        }
+
+        const uint8_t* code = image.data() + offset;
+        if (reinterpret_cast<uintptr_t>(code) % alignof(uint32_t) != 0) return Status::MISALIGNED_CODE;
+
+        out.name       = descriptor.name.substr(0, name.size());
+        out.descriptor = kd;
+        out.code       = { reinterpret_cast<const uint32_t*>(code), static_cast<size_t>(size / 4) };
+        return Status::OK;
+    }
+}
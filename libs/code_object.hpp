@@ -0,0 +1,76 @@
+#pragma once
+
+#include "mapped_file.hpp"
+#include "elf.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// HSA/AMDGPU code objects (ELF64, code object v3+). open() maps the file and checks the ELF
+// header; the symbol table is located on first use, and a kernel's descriptor is read only
+// when that kernel is looked up. Kernel code is a view into the mapping: it can go straight
+// into Wavefront::run() or DispatchParams::kernel, and it stays valid while the CodeObject lives.
+namespace vega
+{
+    // The 64-byte kernel descriptor (llvm AMDGPUUsage, "Kernel Descriptor").
+    struct KernelDescriptor
+    {
+        uint32_t group_segment_size   = 0; // LDS bytes
+        uint32_t private_segment_size = 0; // scratch bytes per work-item
+        uint32_t kernarg_size         = 0;
+        int64_t  entry_offset         = 0; // code entry, relative to the descriptor's address
+        uint32_t rsrc3                = 0;
+        uint32_t rsrc1                = 0;
+        uint32_t rsrc2                = 0;
+        uint16_t properties           = 0;
+
+        // Allocation-granule counts as encoded in COMPUTE_PGM_RSRC1 (GFX9 wave64).
+        uint32_t vgprs() const { return ((rsrc1 & 0x3F) + 1) * 4; }
+        uint32_t sgprs() const { return (((rsrc1 >> 6) & 0xF) + 1) * 8; }
+        uint32_t user_sgprs() const { return (rsrc2 >> 1) & 0x1F; }
+    };
+
+    struct Kernel
+    {
+        std::string_view          name;       // without the ".kd" suffix, points into the mapping
+        KernelDescriptor          descriptor;
+        std::span<const uint32_t> code;       // entry point to the end of the kernel's function
+    };
+
+    struct CodeObject
+    {
+        enum class Status : uint8_t
+        {
+            OK,
+            CANNOT_OPEN,
+            NOT_AMDGPU,      // not an ELF64 AMDGPU image
+            NO_SYMBOLS,
+            NO_KERNEL,       // no "<name>.kd" symbol
+            BAD_DESCRIPTOR,  // descriptor or code outside the image
+            MISALIGNED_CODE, // entry point not dword aligned
+        };
+
+        MappedFile               file;
+        std::span<const uint8_t> image;
+
+        CodeObject() = default;
+        CodeObject(const CodeObject&) = delete;
+        CodeObject& operator=(const CodeObject&) = delete;
+
+        Status open(const char* path);
+        Status open(std::span<const uint8_t> bytes); // not copied: must outlive the CodeObject
+
+        Status find(std::string_view name, Kernel& out);
+
+        // Names of every kernel in the image, in symbol table order.
+        Status kernel_names(std::vector<std::string_view>& out);
+
+        elf::SymbolTable symbols;
+        bool             symbols_located = false;
+
+        Status locate_symbols();
+        Status load(const elf::Symbol& descriptor, std::string_view name, Kernel& out);
+    };
+}
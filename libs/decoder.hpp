@@ -0,0 +1,252 @@
+#pragma once
+
+#include "vega.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace vega
+{
+    enum class Format : uint8_t
+    {
+        UNKNOWN,
+        SOP2, // [31:30] = 0b10,        OP [29:23], SDST [22:16], SSRC1 [15:8], SSRC0 [7:0]
+        SOP1, // [31:23] = 0b101111101, SDST [22:16], OP [15:8], SSRC0 [7:0]
+        VOP2, // [31]    = 0,           OP [30:25], VDST [24:17], VSRC1 [16:9], SRC0 [8:0]
+        VOP1, // [31:25] = 0b0111111,   VDST [24:17], OP [16:9], SRC0 [8:0]
+        FOLDED, // never decoded: a precomputed result stored by fold_constants() (fold.hpp)
+        SOPC, // [31:23] = 0b101111110, OP [22:16], SSRC1 [15:8], SSRC0 [7:0]
+        SOPK, // [31:28] = 0b1011,      OP [27:23], SDST [22:16], SIMM16 [15:0]
+        SOPP, // [31:23] = 0b101111111, OP [22:16], SIMM16 [15:0]
+        FUSED, // never decoded: two instructions run by one handler, made by fuse_pairs() (fuse.hpp)
+        SMEM, // [31:26] = 0b110000,    OP [25:18], IMM [17], GLC [16], NV [15], SOE [14], SDATA [12:6], SBASE [5:0]
+    };
+
+    namespace Operand // SSRC/SDST encodings shared by all scalar formats
+    {
+        static constexpr uint8_t SGPR_LAST   = 101;
+        static constexpr uint8_t VCC_LO      = 106;
+        static constexpr uint8_t VCC_HI      = 107;
+        static constexpr uint8_t M0          = 124;
+        static constexpr uint8_t EXEC_LO     = 126;
+        static constexpr uint8_t EXEC_HI     = 127;
+        static constexpr uint8_t ZERO        = 128;
+        static constexpr uint8_t INT_POS_MAX = 192; // 129..192 ->  1..64
+        static constexpr uint8_t INT_NEG_MAX = 208; // 193..208 -> -1..-16
+        static constexpr uint8_t FLOAT_FIRST = 240; // 0.5, -0.5, 1.0, -1.0, 2.0, -2.0, 4.0, -4.0
+        static constexpr uint8_t INV_2PI     = 248;
+        static constexpr uint8_t VCCZ        = 251;
+        static constexpr uint8_t EXECZ       = 252;
+        static constexpr uint8_t SCC         = 253;
+        static constexpr uint8_t LITERAL     = 255;
+
+        constexpr bool is_inline(uint8_t src)
+        {
+            return (src >= ZERO && src <= INT_NEG_MAX) || (src >= FLOAT_FIRST && src <= INV_2PI);
+        }
+
+        constexpr uint32_t inline_b32(uint8_t src)
+        {
+            constexpr uint32_t FLOATS[] = { 0x3F000000, 0xBF000000, 0x3F800000, 0xBF800000,
+                                            0x40000000, 0xC0000000, 0x40800000, 0xC0800000,
+                                            0x3E22F983 };
+            if (src <= INT_POS_MAX) return static_cast<uint32_t>(src - ZERO);
+            if (src <= INT_NEG_MAX) return static_cast<uint32_t>(INT_POS_MAX - src);
+            return FLOATS[src - FLOAT_FIRST];
+        }
+
+        constexpr uint64_t inline_b64(uint8_t src)
+        {
+            constexpr uint64_t FLOATS[] = { 0x3FE0000000000000ULL, 0xBFE0000000000000ULL,
+                                            0x3FF0000000000000ULL, 0xBFF0000000000000ULL,
+                                            0x4000000000000000ULL, 0xC000000000000000ULL,
+                                            0x4010000000000000ULL, 0xC010000000000000ULL,
+                                            0x3FC45F306DC9C882ULL };
+            if (src <= INT_NEG_MAX) return static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(inline_b32(src))));
+            return FLOATS[src - FLOAT_FIRST];
+        }
+    }
+
+    struct Instruction
+    {
+        Format  format = Format::UNKNOWN;
+        uint8_t OP     = 0;
+        uint8_t SDST   = 0;
+        uint8_t SSRC0  = 0;
+        uint8_t SSRC1  = 0;
+        bool    VSRC0  = false; // VOP only: SRC0[8] set, SSRC0 is a VGPR index
+    };
+
+    // VOP formats reuse the scalar fields: SDST = VDST, SSRC1 = VSRC1, SSRC0 = SRC0[7:0].
+    // SOPK/SOPP keep SIMM16 in SSRC1:SSRC0. SMEM keeps SDATA in SDST, the base register
+    // (SBASE * 2) in SSRC0 and its SmemBits in SSRC1; its second dword is the literal.
+
+    namespace SmemBits
+    {
+        static constexpr uint8_t IMM = 1 << 0; // OFFSET is a byte offset, else OFFSET[7:0] names an SGPR holding one
+        static constexpr uint8_t SOE = 1 << 1; // also add the SGPR named by SOFFSET
+        static constexpr uint8_t GLC = 1 << 2;
+        static constexpr uint8_t NV  = 1 << 3;
+    }
+
+    constexpr uint16_t simm16(const Instruction& inst) { return static_cast<uint16_t>(inst.SSRC0 | (inst.SSRC1 << 8)); }
+
+    // A literal operand is the dword following the instruction word.
+    constexpr bool has_literal(const Instruction& inst)
+    {
+        if (inst.format == Format::VOP1 || inst.format == Format::VOP2)
+        {
+            return !inst.VSRC0 && inst.SSRC0 == Operand::LITERAL;
+        }
+        if (inst.format == Format::SOPK || inst.format == Format::SOPP) return false;
+        if (inst.format == Format::SMEM) return true;
+        return inst.SSRC0 == Operand::LITERAL
+            || ((inst.format == Format::SOP2 || inst.format == Format::SOPC) && inst.SSRC1 == Operand::LITERAL);
+    }
+
+    using SOP1_Handler = void (*)(uint64_t S0, uint64_t& D, bool& SCC);
+    using SOP2_Handler = void (*)(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC);
+
+    static constexpr size_t SOP1_OPCODES = 256; // OP [15:8]
+    static constexpr size_t SOP2_OPCODES = 128; // OP [29:23]
+    static constexpr size_t VOP1_OPCODES = 256; // OP [16:9]
+    static constexpr size_t VOP2_OPCODES = 64;  // OP [30:25]
+    static constexpr size_t SOPC_OPCODES = 128; // OP [22:16]
+    static constexpr size_t SOPK_OPCODES = 32;  // OP [27:23]
+    static constexpr size_t SOPP_OPCODES = 128; // OP [22:16]
+    static constexpr size_t SMEM_OPCODES = 256; // OP [25:18]
+
+    constexpr Instruction decode(uint32_t word)
+    {
+        if ((word >> 25) == (VOP1::BASE >> 25))
+        {
+            return { Format::VOP1,
+                     static_cast<uint8_t>(word >> 9),
+                     static_cast<uint8_t>(word >> 17),
+                     static_cast<uint8_t>(word),
+                     0,
+                     ((word >> 8) & 1) != 0 };
+        }
+        // OP 0x3E/0x3F in [30:25] are VOPC/VOP1.
+        if ((word >> 31) == 0 && ((word >> 25) & 0x3F) < 0x3E)
+        {
+            return { Format::VOP2,
+                     static_cast<uint8_t>((word >> 25) & 0x3F),
+                     static_cast<uint8_t>(word >> 17),
+                     static_cast<uint8_t>(word),
+                     static_cast<uint8_t>(word >> 9),
+                     ((word >> 8) & 1) != 0 };
+        }
+        if ((word >> 23) == (SOP1::BASE >> 23))
+        {
+            return { Format::SOP1,
+                     static_cast<uint8_t>(word >> 8),
+                     static_cast<uint8_t>((word >> 16) & 0x7F),
+                     static_cast<uint8_t>(word),
+                     0 };
+        }
+        if ((word >> 23) == (SOPC::BASE >> 23))
+        {
+            return { Format::SOPC,
+                     static_cast<uint8_t>((word >> 16) & 0x7F),
+                     0,
+                     static_cast<uint8_t>(word),
+                     static_cast<uint8_t>(word >> 8) };
+        }
+        if ((word >> 23) == (SOPP::BASE >> 23))
+        {
+            return { Format::SOPP,
+                     static_cast<uint8_t>((word >> 16) & 0x7F),
+                     0,
+                     static_cast<uint8_t>(word),
+                     static_cast<uint8_t>(word >> 8) };
+        }
+        if ((word >> 26) == (SMEM::BASE >> 26))
+        {
+            return { Format::SMEM,
+                     static_cast<uint8_t>(word >> 18),
+                     static_cast<uint8_t>((word >> 6) & 0x7F),
+                     static_cast<uint8_t>((word & 0x3F) << 1),
+                     static_cast<uint8_t>(((word >> 17) & 1) * SmemBits::IMM | ((word >> 14) & 1) * SmemBits::SOE
+                                          | ((word >> 16) & 1) * SmemBits::GLC | ((word >> 15) & 1) * SmemBits::NV) };
+        }
+        // What is left of 0b1011 in [31:28] is SOPK.
+        if ((word >> 28) == (SOPK::BASE >> 28))
+        {
+            return { Format::SOPK,
+                     static_cast<uint8_t>((word >> 23) & 0x1F),
+                     static_cast<uint8_t>((word >> 16) & 0x7F),
+                     static_cast<uint8_t>(word),
+                     static_cast<uint8_t>(word >> 8) };
+        }
+        // 0b1011 in [31:28] belongs to SOPK/SOP1/SOPC/SOPP, not to SOP2.
+        if ((word >> 30) == (SOP2::BASE >> 30) && (word >> 28) != 0xB)
+        {
+            return { Format::SOP2,
+                     static_cast<uint8_t>((word >> 23) & 0x7F),
+                     static_cast<uint8_t>((word >> 16) & 0x7F),
+                     static_cast<uint8_t>(word),
+                     static_cast<uint8_t>(word >> 8) };
+        }
+        return {};
+    }
+
+    template<typename... Ts>
+    constexpr std::array<SOP1_Handler, SOP1_OPCODES> make_sop1_table(InstructionList<Ts...>)
+    {
+        std::array<SOP1_Handler, SOP1_OPCODES> table{};
+        ((table[Ts::ID] = &call_execute_sop1<Ts>), ...);
+        return table;
+    }
+
+    template<typename... Ts>
+    constexpr std::array<SOP2_Handler, SOP2_OPCODES> make_sop2_table(InstructionList<Ts...>)
+    {
+        std::array<SOP2_Handler, SOP2_OPCODES> table{};
+        ((table[Ts::ID] = &call_execute_sop2<Ts>), ...);
+        return table;
+    }
+
+    inline constexpr auto SOP1_TABLE = make_sop1_table(SOP1::ALL{});
+    inline constexpr auto SOP2_TABLE = make_sop2_table(SOP2::ALL{});
+
+    // Every struct's hex() must decode back to its own format and ID.
+    template<Format F, typename... Ts>
+    constexpr bool decodes_to_self(InstructionList<Ts...>)
+    {
+        return ((decode(Ts::hex()).format == F && decode(Ts::hex()).OP == Ts::ID) && ...);
+    }
+    static_assert(decodes_to_self<Format::SOP1>(SOP1::ALL{}));
+    static_assert(decodes_to_self<Format::SOP2>(SOP2::ALL{}));
+    static_assert(decodes_to_self<Format::VOP1>(VOP1::ALL{}));
+    static_assert(decodes_to_self<Format::VOP2>(VOP2::ALL{}));
+    static_assert(decodes_to_self<Format::SOPC>(SOPC::ALL{}));
+    static_assert(decodes_to_self<Format::SOPK>(SOPK::ALL{}));
+    static_assert(decodes_to_self<Format::SOPP>(SOPP::ALL{}));
+    static_assert(decodes_to_self<Format::SMEM>(SMEM::ALL{}));
+
+    // Returns false when the word is not a known SOP1/SOP2 instruction.
+    inline bool dispatch(uint32_t word, uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
+    {
+        const Instruction inst = decode(word);
+        switch (inst.format)
+        {
+            case Format::SOP1:
+                if (SOP1_Handler fn = SOP1_TABLE[inst.OP])
+                {
+                    fn(S0, D, SCC);
+                    return true;
+                }
+                return false;
+            case Format::SOP2:
+                if (SOP2_Handler fn = SOP2_TABLE[inst.OP])
+                {
+                    fn(S0, S1, D, SCC);
+                    return true;
+                }
+                return false;
+            default:
+                return false;
+        }
+    }
+}
@@ -0,0 +1,366 @@
+#include "disassembler.hpp"
+#include "fuse.hpp"
+#include "syntax.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+
+namespace vega
+{
+    namespace
+    {
+        struct Spelling
+        {
+            char    text[24] = {};
+            uint8_t length   = 0; // 0: no instruction with this opcode
+            uint8_t D_bytes  = 0;
+            uint8_t S0_bytes = 0;
+            uint8_t S1_bytes = 0;
+        };
+
+        constexpr Spelling spell(const syntax::Mnemonic& m)
+        {
+            Spelling s;
+            for (char c : m.name)
+            {
+                s.text[s.length++] = c >= 'A' && c <= 'Z' ? static_cast<char>(c + ('a' - 'A')) : c;
+            }
+            s.D_bytes  = m.D_bytes;
+            s.S0_bytes = m.S0_bytes;
+            s.S1_bytes = m.S1_bytes;
+            return s;
+        }
+
+        // One Spelling per opcode, from the syntax:: function `mnemonic` calls for each type.
+        template<size_t N, typename... Ts, typename F>
+        constexpr std::array<Spelling, N> make_spelling(InstructionList<Ts...>, F mnemonic)
+        {
+            std::array<Spelling, N> table{};
+            ((table[Ts::ID] = spell(mnemonic.template operator()<Ts>())), ...);
+            return table;
+        }
+
+        constexpr auto SOP1_SPELLING = make_spelling<SOP1_OPCODES>(SOP1::ALL{}, []<typename T>() { return syntax::sop1<T>(); });
+        constexpr auto SOP2_SPELLING = make_spelling<SOP2_OPCODES>(SOP2::ALL{}, []<typename T>() { return syntax::sop2<T>(); });
+        constexpr auto SOPC_SPELLING = make_spelling<SOPC_OPCODES>(SOPC::ALL{}, []<typename T>() { return syntax::sopc<T>(); });
+        constexpr auto SOPK_SPELLING = make_spelling<SOPK_OPCODES>(SOPK::ALL{}, []<typename T>() { return syntax::sopk<T>(); });
+        constexpr auto SOPP_SPELLING = make_spelling<SOPP_OPCODES>(SOPP::ALL{}, []<typename T>() { return syntax::sopp<T>(); });
+        constexpr auto SMEM_SPELLING = make_spelling<SMEM_OPCODES>(SMEM::ALL{}, []<typename T>() { return syntax::smem<T>(); });
+
+        template<size_t N, typename... Ts>
+        constexpr std::array<const char*, N> make_names(InstructionList<Ts...>)
+        {
+            std::array<const char*, N> table{};
+            ((table[Ts::ID] = Ts::NAME), ...);
+            return table;
+        }
+
+        constexpr auto SOP1_NAMES = make_names<SOP1_OPCODES>(SOP1::ALL{});
+        constexpr auto SOP2_NAMES = make_names<SOP2_OPCODES>(SOP2::ALL{});
+        constexpr auto SOPC_NAMES = make_names<SOPC_OPCODES>(SOPC::ALL{});
+        constexpr auto SOPK_NAMES = make_names<SOPK_OPCODES>(SOPK::ALL{});
+        constexpr auto SOPP_NAMES = make_names<SOPP_OPCODES>(SOPP::ALL{});
+        constexpr auto SMEM_NAMES = make_names<SMEM_OPCODES>(SMEM::ALL{});
+        constexpr auto VOP1_NAMES = make_names<VOP1_OPCODES>(VOP1::ALL{});
+        constexpr auto VOP2_NAMES = make_names<VOP2_OPCODES>(VOP2::ALL{});
+
+        constexpr char HEX[] = "0123456789abcdef";
+
+        uint32_t load(const uint8_t* code)
+        {
+            uint32_t word;
+            std::memcpy(&word, code, sizeof(word));
+            return word;
+        }
+
+        void put(char*& p, std::string_view text)
+        {
+            std::memcpy(p, text.data(), text.size());
+            p += text.size();
+        }
+
+        void put_decimal(char*& p, uint64_t value)
+        {
+            char digits[20];
+            int  n = 0;
+            do
+            {
+                digits[n++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value != 0);
+            while (n != 0) *p++ = digits[--n];
+        }
+
+        void put_hex(char*& p, uint64_t value, int digits)
+        {
+            for (int shift = (digits - 1) * 4; shift >= 0; shift -= 4) *p++ = HEX[(value >> shift) & 0xF];
+        }
+
+        void put_hex_literal(char*& p, uint32_t value)
+        {
+            const int digits = value == 0 ? 1 : (35 - std::countl_zero(value)) / 4;
+            put(p, "0x");
+            put_hex(p, value, digits);
+        }
+
+        // False when `code` has no spelling the assembler accepts at this width and position.
+        bool put_operand(char*& p, uint8_t code, uint8_t bytes, bool destination, uint32_t literal)
+        {
+            if (code <= Operand::SGPR_LAST)
+            {
+                if (bytes == 4)
+                {
+                    *p++ = 's';
+                    put_decimal(p, code);
+                    return true;
+                }
+                // Pairs start on an even register, the longer SMEM ranges on a multiple of four.
+                const uint32_t count = bytes / 4u;
+                if (code % std::min(count, 4u) != 0 || code + count - 1 > Operand::SGPR_LAST) return false;
+                put(p, "s[");
+                put_decimal(p, code);
+                *p++ = ':';
+                put_decimal(p, code + count - 1);
+                *p++ = ']';
+                return true;
+            }
+            for (const syntax::Named& n : syntax::NAMED)
+            {
+                if (n.code != code || (n.bytes != 0 && n.bytes != bytes)) continue;
+                if (n.bytes == 0 && destination) return false;
+                put(p, n.name);
+                return true;
+            }
+            if (destination) return false;
+            if (code >= Operand::ZERO && code <= Operand::INT_NEG_MAX)
+            {
+                if (code > Operand::INT_POS_MAX) *p++ = '-';
+                put_decimal(p, code <= Operand::INT_POS_MAX ? code - Operand::ZERO : code - Operand::INT_POS_MAX);
+                return true;
+            }
+            if (code >= Operand::FLOAT_FIRST && code <= Operand::INV_2PI)
+            {
+                put(p, syntax::INLINE_FLOAT_TEXT[code - Operand::FLOAT_FIRST]);
+                return true;
+            }
+            if (code == Operand::LITERAL)
+            {
+                // 64-bit operands sign-extend the dword; the assembler reads that back from a negative number.
+                if (bytes == 8 && (literal & 0x80000000u) != 0)
+                {
+                    *p++ = '-';
+                    put_decimal(p, 0x100000000ULL - literal);
+                    return true;
+                }
+                put_hex_literal(p, literal);
+                return true;
+            }
+            return false;
+        }
+    }
+
+    const char* instruction_name(const Instruction& inst)
+    {
+        switch (inst.format)
+        {
+            case Format::SOP1: return SOP1_NAMES[inst.OP];
+            case Format::SOP2: return SOP2_NAMES[inst.OP];
+            case Format::SOPC: return SOPC_NAMES[inst.OP];
+            case Format::SOPK: return SOPK_NAMES[inst.OP];
+            case Format::SOPP: return SOPP_NAMES[inst.OP];
+            case Format::SMEM: return SMEM_NAMES[inst.OP];
+            case Format::FUSED: return inst.OP < Fused::COUNT ? FUSED_NAMES[inst.OP] : nullptr;
+            case Format::VOP1: return VOP1_NAMES[inst.OP];
+            case Format::VOP2: return VOP2_NAMES[inst.OP];
+            default:           return nullptr;
+        }
+    }
+
+    size_t disassemble_one(const uint8_t* code, size_t words, char* line, size_t& length)
+    {
+        char* p = line;
+        const uint32_t    word = load(code);
+        const Instruction inst = decode(word);
+
+        const Spelling* s = nullptr;
+        if (inst.format == Format::SOP1) s = &SOP1_SPELLING[inst.OP];
+        if (inst.format == Format::SOP2) s = &SOP2_SPELLING[inst.OP];
+        if (inst.format == Format::SOPC) s = &SOPC_SPELLING[inst.OP];
+        if (inst.format == Format::SOPK) s = &SOPK_SPELLING[inst.OP];
+        if (inst.format == Format::SOPP) s = &SOPP_SPELLING[inst.OP];
+        if (inst.format == Format::SMEM) s = &SMEM_SPELLING[inst.OP];
+
+        size_t covered = 1;
+        uint32_t literal = 0;
+        if (s != nullptr && (s->length != 0 || inst.format == Format::SMEM) && has_literal(inst)) // SMEM is always two dwords
+        {
+            if (words < 2) s = nullptr; // literal cut off
+            else
+            {
+                literal = load(code + 4);
+                covered = 2;
+            }
+        }
+
+        bool ok = s != nullptr && s->length != 0;
+        if (ok && inst.format == Format::SOPK)
+        {
+            // The immediate in hex, as LLVM prints it; the assembler takes it back unchanged.
+            put(p, { s->text, s->length });
+            *p++ = ' ';
+            ok = put_operand(p, inst.SDST, s->D_bytes, true, 0);
+            put(p, ", ");
+            put_hex_literal(p, simm16(inst));
+        }
+        else if (ok && inst.format == Format::SOPP)
+        {
+            // Branch offsets are signed dwords; S_ENDPGM only has a spelling with a zero immediate.
+            put(p, { s->text, s->length });
+            const uint16_t imm = simm16(inst);
+            if (s->S0_bytes != 0)
+            {
+                *p++ = ' ';
+                if (is_control(inst) && (imm & 0x8000) != 0)
+                {
+                    *p++ = '-';
+                    put_decimal(p, 0x10000u - imm);
+                }
+                else put_decimal(p, imm);
+            }
+            else ok = imm == 0;
+        }
+        else if (ok && inst.format == Format::SMEM)
+        {
+            // The offset in hex as LLVM prints it, or the register holding it; SOE and NV
+            // have no spelling, nor do bits the offset field does not use.
+            const bool imm = (inst.SSRC1 & SmemBits::IMM) != 0;
+            put(p, { s->text, s->length });
+            *p++ = ' ';
+            ok = (inst.SSRC1 & (SmemBits::SOE | SmemBits::NV)) == 0 && literal <= (imm ? 0x1FFFFFu : 0x7Fu)
+              && put_operand(p, inst.SDST, s->D_bytes, true, 0);
+            if (ok)
+            {
+                put(p, ", ");
+                ok = put_operand(p, inst.SSRC0, s->S0_bytes, false, 0);
+            }
+            if (ok)
+            {
+                put(p, ", ");
+                if (!imm) ok = put_operand(p, static_cast<uint8_t>(literal), 4, true, 0);
+                else if ((literal & 0x100000) == 0) put_hex_literal(p, literal);
+                else
+                {
+                    *p++ = '-';
+                    put_hex_literal(p, 0x200000 - literal);
+                }
+            }
+            if (ok && (inst.SSRC1 & SmemBits::GLC) != 0) put(p, " glc");
+        }
+        else if (ok && inst.format == Format::SOPC)
+        {
+            put(p, { s->text, s->length });
+            *p++ = ' ';
+            ok = put_operand(p, inst.SSRC0, s->S0_bytes, false, literal);
+            if (ok)
+            {
+                put(p, ", ");
+                ok = put_operand(p, inst.SSRC1, s->S1_bytes, false, literal);
+            }
+        }
+        else if (ok)
+        {
+            put(p, { s->text, s->length });
+            *p++ = ' ';
+            ok = put_operand(p, inst.SDST, s->D_bytes, true, 0);
+            if (ok)
+            {
+                put(p, ", ");
+                ok = put_operand(p, inst.SSRC0, s->S0_bytes, false, literal);
+            }
+            if (ok && inst.format == Format::SOP2)
+            {
+                put(p, ", ");
+                ok = put_operand(p, inst.SSRC1, s->S1_bytes, false, literal);
+            }
+        }
+        if (!ok)
+        {
+            p = line;
+            put(p, ".long 0x");
+            put_hex(p, word, 8);
+            if (covered == 2)
+            {
+                put(p, ", 0x");
+                put_hex(p, literal, 8);
+            }
+        }
+        length = static_cast<size_t>(p - line);
+        return covered;
+    }
+
+    size_t Disassembler::feed(std::span<const uint8_t> code, uint64_t address, bool last)
+    {
+        const size_t words = code.size() / 4;
+        size_t at = 0;
+        while (at < words)
+        {
+            const uint8_t*    bytes = code.data() + at * 4;
+            const Instruction inst  = decode(load(bytes));
+            if (!last && at + 1 == words && (inst.format == Format::SOP1 || inst.format == Format::SOP2 || inst.format == Format::SOPC
+                                             || inst.format == Format::SMEM)
+                && has_literal(inst))
+            {
+                break; // the literal arrives with the next call
+            }
+            if (BUFFER_SIZE - used < MAX_DISASSEMBLY_LINE && !flush()) return at * 4;
+
+            char*  line   = buffer + used;
+            size_t length = 0;
+            const size_t covered = disassemble_one(bytes, words - at, line, length);
+            char*  p = line + length;
+            if (line[0] == '.') ++unknown; // .long; mnemonics never start with '.'
+            else ++instructions;
+
+            if (annotate)
+            {
+                for (size_t pad = length; pad < 40; ++pad) *p++ = ' ';
+                put(p, " // ");
+                put_hex(p, address + at * 4, 12);
+                put(p, ": ");
+                put_hex(p, load(bytes), 8);
+                if (covered == 2)
+                {
+                    *p++ = ' ';
+                    put_hex(p, load(bytes + 4), 8);
+                }
+            }
+            *p++ = '\n';
+            used += static_cast<size_t>(p - line);
+            at += covered;
+        }
+
+        if (last && code.size() % 4 != 0)
+        {
+            if (BUFFER_SIZE - used < MAX_DISASSEMBLY_LINE && !flush()) return at * 4;
+            char* p = buffer + used;
+            put(p, ".byte");
+            for (size_t i = words * 4; i < code.size(); ++i)
+            {
+                put(p, i == words * 4 ? " 0x" : ", 0x");
+                put_hex(p, code[i], 2);
+            }
+            *p++ = '\n';
+            used = static_cast<size_t>(p - buffer);
+            return code.size();
+        }
+        return at * 4;
+    }
+
+    bool Disassembler::flush()
+    {
+        if (used != 0 && out != nullptr && std::fwrite(buffer, 1, used, out) != used) failed = true;
+        used = 0;
+        return !failed;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+
+// Scalar-format disassembler producing the syntax assemble() reads (assembler.hpp). Words
+// that are not SOP1/SOP2/SOPC/SOPK/SOPP/SMEM, or whose operands have no spelling there, come out
+// as `.long 0x...`. Literals that have an inline encoding reassemble to the inline form.
+// Branches print their dword offset, not a label.
+namespace vega
+{
+    struct Instruction;
+
+    static constexpr size_t MAX_DISASSEMBLY_LINE = 128;
+
+    // Struct NAME for any implemented opcode, nullptr otherwise.
+    const char* instruction_name(const Instruction& inst);
+
+    // Text for the instruction starting at `code` (`words` dwords available, any alignment),
+    // without a newline. Returns the dwords it covers: 2 with a literal, otherwise 1.
+    size_t disassemble_one(const uint8_t* code, size_t words, char* line, size_t& length);
+
+    // Single-pass text output through one reused buffer; nothing is allocated per instruction.
+    struct Disassembler
+    {
+        static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+        std::FILE* out          = nullptr;
+        bool       annotate     = true; // append "// address: words"
+        uint64_t   instructions = 0;
+        uint64_t   unknown      = 0;    // words printed as .long
+        bool       failed       = false; // a write to `out` failed
+
+        char   buffer[BUFFER_SIZE];
+        size_t used = 0;
+
+        explicit Disassembler(std::FILE* out) : out(out) {}
+        ~Disassembler() { flush(); }
+
+        // Disassembles whole instructions of `code`, which starts at `address`, and returns the
+        // bytes consumed. Unless `last`, an instruction whose literal lies past the end is left
+        // for the next call; with `last` every byte is printed.
+        size_t feed(std::span<const uint8_t> code, uint64_t address, bool last);
+
+        bool flush();
+    };
+}
@@ -0,0 +1,202 @@
+#include "dispatcher.hpp"
+#include <algorithm>
+
+namespace vega
+{
+    namespace
+    {
+        constexpr uint64_t pack(uint32_t begin, uint32_t end) { return (static_cast<uint64_t>(end) << 32) | begin; }
+        constexpr uint32_t begin_of(uint64_t range) { return static_cast<uint32_t>(range); }
+        constexpr uint32_t end_of(uint64_t range)   { return static_cast<uint32_t>(range >> 32); }
+
+        uint32_t div_up(uint32_t a, uint32_t b) { return (a + b - 1) / b; }
+    }
+
+    Dispatcher::Dispatcher(unsigned count)
+    {
+        count = std::max(count, 1u);
+        cache.fold = true;
+        for (unsigned i = 0; i < count; ++i)
+        {
+            workers.push_back(std::make_unique<Worker>());
+        }
+        for (unsigned i = 0; i < count; ++i)
+        {
+            threads.emplace_back(&Dispatcher::worker_loop, this, i);
+        }
+    }
+
+    Dispatcher::~Dispatcher()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        start.notify_all();
+        for (std::thread& t : threads)
+        {
+            t.join();
+        }
+    }
+
+    DispatchResult Dispatcher::dispatch(const DispatchParams& p)
+    {
+        DispatchResult result;
+        uint32_t groups[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            if (p.grid[i] == 0 || p.workgroup[i] == 0) return result;
+            groups[i] = div_up(p.grid[i], p.workgroup[i]);
+        }
+        const uint64_t total = static_cast<uint64_t>(groups[0]) * groups[1] * groups[2];
+        const uint64_t items = static_cast<uint64_t>(p.workgroup[0]) * p.workgroup[1] * p.workgroup[2];
+        if (total > UINT32_MAX || items > DispatchParams::MAX_WORKGROUP_SIZE)
+        {
+            result.status = Wavefront::Status::ILLEGAL;
+            return result;
+        }
+
+        const Translation& translation = cache.get(p.kernel);
+        const uint32_t     n           = static_cast<uint32_t>(total);
+        const uint32_t     share       = div_up(n, size());
+        for (unsigned i = 0; i < size(); ++i)
+        {
+            const uint32_t begin = std::min<uint64_t>(static_cast<uint64_t>(i) * share, n);
+            const uint32_t end   = std::min<uint64_t>(static_cast<uint64_t>(begin) + share, n);
+            workers[i]->range.store(pack(begin, end), std::memory_order_relaxed);
+            workers[i]->wavefronts = 0;
+            workers[i]->status     = Wavefront::Status::ENDED;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        params  = &p;
+        program = &translation;
+        running = size();
+        ++generation;
+        start.notify_all();
+        done.wait(lock, [this] { return running == 0; });
+
+        result.workgroups = n;
+        for (const auto& worker : workers)
+        {
+            result.wavefronts += worker->wavefronts;
+            if (worker->status != Wavefront::Status::ENDED) result.status = worker->status;
+        }
+        return result;
+    }
+
+    Profiler Dispatcher::take_profile()
+    {
+        Profiler total;
+        for (const auto& worker : workers)
+        {
+            total.merge(worker->profile);
+            worker->profile.reset();
+        }
+        return total;
+    }
+
+    void Dispatcher::worker_loop(unsigned index)
+    {
+        uint64_t seen = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                start.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+
+            uint32_t workgroup = 0;
+            while (next_workgroup(index, workgroup))
+            {
+                run_workgroup(*workers[index], workgroup);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--running == 0) done.notify_one();
+        }
+    }
+
+    bool Dispatcher::next_workgroup(unsigned index, uint32_t& workgroup)
+    {
+        std::atomic<uint64_t>& own = workers[index]->range;
+        for (;;)
+        {
+            uint64_t r = own.load(std::memory_order_acquire);
+            while (begin_of(r) < end_of(r))
+            {
+                if (own.compare_exchange_weak(r, pack(begin_of(r) + 1, end_of(r)), std::memory_order_acq_rel))
+                {
+                    workgroup = begin_of(r);
+                    return true;
+                }
+            }
+
+            // Own range is empty: take the back half of the first victim that has work left.
+            bool stole = false;
+            for (unsigned k = 1; k < size() && !stole; ++k)
+            {
+                std::atomic<uint64_t>& victim = workers[(index + k) % size()]->range;
+                uint64_t v = victim.load(std::memory_order_acquire);
+                while (begin_of(v) < end_of(v))
+                {
+                    const uint32_t split = end_of(v) - (end_of(v) - begin_of(v) + 1) / 2;
+                    if (victim.compare_exchange_weak(v, pack(begin_of(v), split), std::memory_order_acq_rel))
+                    {
+                        own.store(pack(split, end_of(v)), std::memory_order_release);
+                        stole = true;
+                        break;
+                    }
+                }
+            }
+            if (!stole) return false;
+        }
+    }
+
+    void Dispatcher::run_workgroup(Worker& worker, uint32_t workgroup)
+    {
+        const DispatchParams& p    = *params;
+        Wavefront&            wave = *worker.wave;
+
+        const uint32_t gx = div_up(p.grid[0], p.workgroup[0]);
+        const uint32_t gy = div_up(p.grid[1], p.workgroup[1]);
+        const uint32_t id[3] = { workgroup % gx, (workgroup / gx) % gy, workgroup / (gx * gy) };
+        const uint32_t items = p.workgroup[0] * p.workgroup[1] * p.workgroup[2]; // <= MAX_WORKGROUP_SIZE
+        if (wave.tlb.memory != p.memory) wave.tlb.attach(p.memory);
+
+        for (uint32_t base = 0; base < items; base += Wavefront::LANES)
+        {
+            uint64_t exec = 0;
+            for (uint32_t l = 0; l < Wavefront::LANES; ++l)
+            {
+                const uint32_t local = base + l;
+                const uint32_t lid[3] = { local % p.workgroup[0],
+                                          (local / p.workgroup[0]) % p.workgroup[1],
+                                          local / (p.workgroup[0] * p.workgroup[1]) };
+                bool active = local < items;
+                for (int d = 0; d < 3; ++d)
+                {
+                    wave.VGPR[Abi::WORKITEM_ID_VGPR + d][l] = lid[d];
+                    active = active && static_cast<uint64_t>(id[d]) * p.workgroup[d] + lid[d] < p.grid[d];
+                }
+                exec |= static_cast<uint64_t>(active) << l;
+            }
+
+            wave.PC  = 0;
+            wave.SCC = false;
+            wave.set_exec(exec);
+            wave.set_vcc(0);
+            wave.write<uint64_t>(Abi::KERNARG_SGPR, p.kernarg_address);
+            for (int d = 0; d < 3; ++d)
+            {
+                wave.SGPR[Abi::WORKGROUP_ID_SGPR + d] = id[d];
+            }
+
+            const Wavefront::Status status = profiling ? wave.run(*program, worker.profile) : wave.run(*program);
+            ++worker.wavefronts;
+            if (status != Wavefront::Status::ENDED) worker.status = status;
+        }
+    }
+}
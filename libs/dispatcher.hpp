@@ -0,0 +1,89 @@
+#pragma once
+
+#include "profile.hpp"
+#include "uop_cache.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace vega
+{
+    // Initial wavefront state written by the dispatcher before the first instruction.
+    namespace Abi
+    {
+        static constexpr uint8_t KERNARG_SGPR      = 0; // s[0:1] = kernarg segment address
+        static constexpr uint8_t WORKGROUP_ID_SGPR = 2; // s2, s3, s4 = workgroup id x, y, z
+        static constexpr uint8_t WORKITEM_ID_VGPR  = 0; // v0, v1, v2 = work-item id x, y, z in the workgroup
+    }
+
+    struct DispatchParams
+    {
+        static constexpr uint32_t MAX_WORKGROUP_SIZE = 1024; // work-items; larger workgroups are ILLEGAL
+
+        uint32_t                  grid[3]         = { 1, 1, 1 }; // in work-items, like an HSA AQL packet
+        uint32_t                  workgroup[3]    = { 64, 1, 1 };
+        std::span<const uint32_t> kernel;
+        const Memory*             memory          = nullptr; // SMEM loads read it; nullptr: they read zeros
+        uint64_t                  kernarg_address = 0;       // s[0:1]: guest address of the kernarg segment in `memory`
+    };
+
+    struct DispatchResult
+    {
+        Wavefront::Status status     = Wavefront::Status::ENDED; // first non-ENDED status, if any
+        uint64_t          workgroups = 0;
+        uint64_t          wavefronts = 0;
+    };
+
+    // Persistent pool; each worker owns its Wavefront and a range of workgroup indices it
+    // pops from the front of, and steals the back half of another worker's range once its
+    // own is empty. The per-instruction path only touches the worker's own Wavefront and
+    // the dispatch's read-only Translation.
+    struct Dispatcher
+    {
+        struct alignas(64) Worker
+        {
+            std::atomic<uint64_t>      range{ 0 }; // [begin, end) packed as end << 32 | begin
+            std::unique_ptr<Wavefront> wave = std::make_unique<Wavefront>();
+            uint64_t                   wavefronts = 0;
+            Wavefront::Status          status = Wavefront::Status::ENDED;
+            Profiler                   profile; // only used while Dispatcher::profiling
+        };
+
+        explicit Dispatcher(unsigned threads = std::thread::hardware_concurrency());
+        Dispatcher(const Dispatcher&) = delete;
+        Dispatcher& operator=(const Dispatcher&) = delete;
+        ~Dispatcher();
+
+        DispatchResult dispatch(const DispatchParams& params);
+
+        unsigned size() const { return static_cast<unsigned>(workers.size()); }
+
+        // The workers' profiles merged, after which they start again from zero. Call it
+        // between dispatches.
+        Profiler take_profile();
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::vector<std::thread>             threads;
+        UopCache                             cache; // touched only by the dispatching thread
+        bool                                 profiling = false; // run wavefronts under each worker's Profiler
+
+        std::mutex              mutex;
+        std::condition_variable start;
+        std::condition_variable done;
+        uint64_t                generation = 0;
+        unsigned                running    = 0;
+        bool                    stopping   = false;
+        const DispatchParams*   params     = nullptr;
+        const Translation*      program    = nullptr;
+
+        void worker_loop(unsigned index);
+        bool next_workgroup(unsigned index, uint32_t& workgroup);
+        void run_workgroup(Worker& worker, uint32_t workgroup);
+    };
+}
@@ -0,0 +1,145 @@
+#include "elf.hpp"
+#include <cstring>
+
+namespace vega::elf
+{
+    namespace
+    {
+        // Byte offsets into Elf64_Ehdr / Elf64_Shdr / Elf64_Sym.
+        constexpr size_t EHDR_SIZE   = 64;
+        constexpr size_t E_TYPE      = 0x10;
+        constexpr size_t E_MACHINE   = 0x12;
+        constexpr size_t E_SHOFF     = 0x28;
+        constexpr size_t E_SHENTSIZE = 0x3A;
+        constexpr size_t E_SHNUM     = 0x3C;
+        constexpr size_t E_SHSTRNDX  = 0x3E;
+        constexpr size_t SHDR_SIZE   = 64;
+        constexpr size_t SH_NAME     = 0x00;
+        constexpr size_t SH_TYPE     = 0x04;
+        constexpr size_t SH_ADDR     = 0x10;
+        constexpr size_t SH_OFFSET   = 0x18;
+        constexpr size_t SH_SIZE     = 0x20;
+        constexpr size_t SH_LINK     = 0x28;
+        constexpr size_t SYM_SIZE    = 24;
+        constexpr size_t ST_NAME     = 0x00;
+        constexpr size_t ST_INFO     = 0x04;
+        constexpr size_t ST_SHNDX    = 0x06;
+        constexpr size_t ST_VALUE    = 0x08;
+        constexpr size_t ST_SIZE     = 0x10;
+
+        constexpr uint32_t SHT_SYMTAB = 2;
+        constexpr uint32_t SHT_DYNSYM = 11;
+
+        template<typename V>
+        V read(std::span<const uint8_t> image, uint64_t at)
+        {
+            V value;
+            std::memcpy(&value, image.data() + at, sizeof(V));
+            return value;
+        }
+
+        bool section_header(std::span<const uint8_t> image, uint64_t index, Section& out, uint32_t& name)
+        {
+            if (!is_elf64(image) || read<uint16_t>(image, E_SHENTSIZE) != SHDR_SIZE || index >= read<uint16_t>(image, E_SHNUM)) return false;
+            const uint64_t table = read<uint64_t>(image, E_SHOFF);
+            if (table > image.size() || index >= (image.size() - table) / SHDR_SIZE) return false;
+            const uint64_t at = table + index * SHDR_SIZE;
+            name        = read<uint32_t>(image, at + SH_NAME);
+            out.type    = read<uint32_t>(image, at + SH_TYPE);
+            out.address = read<uint64_t>(image, at + SH_ADDR);
+            out.offset  = read<uint64_t>(image, at + SH_OFFSET);
+            out.size    = read<uint64_t>(image, at + SH_SIZE);
+            out.link    = read<uint32_t>(image, at + SH_LINK);
+            return out.offset <= image.size() && out.size <= image.size() - out.offset;
+        }
+
+        std::string_view string_at(std::span<const uint8_t> image, const Section& strings, uint32_t offset)
+        {
+            if (offset >= strings.size) return {};
+            const char* text = reinterpret_cast<const char*>(image.data() + strings.offset + offset);
+            return { text, strnlen(text, static_cast<size_t>(strings.size - offset)) };
+        }
+    }
+
+    bool is_elf64(std::span<const uint8_t> image)
+    {
+        return image.size() >= EHDR_SIZE && std::memcmp(image.data(), "\x7F" "ELF", 4) == 0
+            && image[4] == 2   // ELFCLASS64
+            && image[5] == 1;  // ELFDATA2LSB
+    }
+
+    uint16_t type(std::span<const uint8_t> image)
+    {
+        return read<uint16_t>(image, E_TYPE);
+    }
+
+    uint16_t machine(std::span<const uint8_t> image)
+    {
+        return read<uint16_t>(image, E_MACHINE);
+    }
+
+    bool section_at(std::span<const uint8_t> image, uint64_t index, Section& out)
+    {
+        uint32_t unused = 0;
+        return section_header(image, index, out, unused);
+    }
+
+    bool find_section(std::span<const uint8_t> image, std::string_view name, Section& out)
+    {
+        Section strings;
+        if (!section_at(image, read<uint16_t>(image, E_SHSTRNDX), strings)) return false;
+
+        const uint16_t count = read<uint16_t>(image, E_SHNUM);
+        for (uint16_t i = 0; i < count; ++i)
+        {
+            Section  section;
+            uint32_t offset = 0;
+            if (section_header(image, i, section, offset) && string_at(image, strings, offset) == name)
+            {
+                out = section;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool find_symbol_table(std::span<const uint8_t> image, SymbolTable& out)
+    {
+        if (!is_elf64(image)) return false;
+        const uint16_t count = read<uint16_t>(image, E_SHNUM);
+        bool found = false;
+        for (uint16_t i = 0; i < count; ++i)
+        {
+            Section section;
+            if (!section_at(image, i, section) || (section.type != SHT_SYMTAB && section.type != SHT_DYNSYM)) continue;
+            Section strings;
+            if (!section_at(image, section.link, strings)) continue;
+            out   = { section, strings, static_cast<size_t>(section.size / SYM_SIZE) };
+            found = true;
+            if (section.type == SHT_SYMTAB) break; // the full table wins over .dynsym
+        }
+        return found;
+    }
+
+    bool SymbolTable::at(std::span<const uint8_t> image, size_t index, Symbol& out) const
+    {
+        if (index >= count) return false;
+        const uint64_t at = symbols.offset + index * SYM_SIZE;
+        out.name    = string_at(image, strings, read<uint32_t>(image, at + ST_NAME));
+        out.type    = read<uint8_t>(image, at + ST_INFO) & 0xF;
+        out.section = read<uint16_t>(image, at + ST_SHNDX);
+        out.value   = read<uint64_t>(image, at + ST_VALUE);
+        out.size    = read<uint64_t>(image, at + ST_SIZE);
+        return true;
+    }
+
+    bool file_offset(std::span<const uint8_t> image, uint16_t index, uint64_t address, uint64_t size, uint64_t& out)
+    {
+        Section section;
+        if (!section_at(image, index, section) || address < section.address) return false;
+        const uint64_t within = address - section.address;
+        if (within > section.size || size > section.size - within) return false;
+        out = section.offset + within;
+        return true;
+    }
+}
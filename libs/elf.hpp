@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+// Just enough ELF64 (little-endian, as every AMDGPU code object is) to find sections and
+// symbols in a mapped image. Header fields are read with memcpy, so the image needs no
+// alignment, and nothing is parsed ahead of the lookup that needs it.
+namespace vega::elf
+{
+    static constexpr uint16_t EM_AMDGPU = 224;
+    static constexpr uint16_t ET_REL    = 1;
+    static constexpr uint16_t ET_DYN    = 3;
+    static constexpr uint8_t  STT_FUNC  = 2;
+
+    struct Section
+    {
+        uint64_t offset  = 0; // file offset
+        uint64_t size    = 0;
+        uint64_t address = 0; // sh_addr
+        uint32_t type    = 0; // sh_type
+        uint32_t link    = 0; // sh_link: the string table of a symbol table
+    };
+
+    struct Symbol
+    {
+        std::string_view name;
+        uint64_t         value   = 0;
+        uint64_t         size    = 0;
+        uint16_t         section = 0; // st_shndx
+        uint8_t          type    = 0; // STT_*
+    };
+
+    // .symtab (or .dynsym) with its string table, located but not read.
+    struct SymbolTable
+    {
+        Section symbols;
+        Section strings;
+        size_t  count = 0;
+
+        // False for an index past the end or a name outside the string table.
+        bool at(std::span<const uint8_t> image, size_t index, Symbol& out) const;
+    };
+
+    bool is_elf64(std::span<const uint8_t> image);
+
+    uint16_t type(std::span<const uint8_t> image);    // e_type, image must be ELF64
+    uint16_t machine(std::span<const uint8_t> image); // e_machine, image must be ELF64
+
+    // False when the image is not ELF64, is truncated, or has no such section.
+    bool section_at(std::span<const uint8_t> image, uint64_t index, Section& out);
+    bool find_section(std::span<const uint8_t> image, std::string_view name, Section& out);
+    bool find_symbol_table(std::span<const uint8_t> image, SymbolTable& out);
+
+    // File offset of the bytes at virtual `address` inside section `index`.
+    bool file_offset(std::span<const uint8_t> image, uint16_t index, uint64_t address, uint64_t size, uint64_t& out);
+}
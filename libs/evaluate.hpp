@@ -0,0 +1,152 @@
+#pragma once
+
+#include "wavefront.hpp"
+#include <cstdint>
+#include <type_traits>
+
+// Value-returning form of the SOP1/SOP2 semantics. Everything here is constexpr, so
+// results for constant operands can be computed by the compiler.
+namespace vega
+{
+    // Destination (32-bit results zero-extended) and SCC after an instruction.
+    struct Result
+    {
+        uint64_t D   = 0;
+        bool     SCC = false;
+
+        constexpr bool operator==(const Result&) const = default;
+    };
+
+    // `before` holds D and SCC ahead of the instruction: S_CMOV keeps the old D, S_ADDC/S_CSELECT read SCC.
+    template<typename T>
+    constexpr Result evaluate_sop1(uint64_t S0, Result before = {})
+    {
+        using E   = Execute<T>;
+        using D_t = std::remove_reference_t<typename E::template Arg<1>>;
+        bool SCC  = before.SCC;
+        D_t  D    = static_cast<D_t>(before.D);
+        const auto s0 = static_cast<typename E::template Arg<0>>(S0);
+        if constexpr (E::ARITY == 3) T::execute(s0, D, SCC);
+        else                         T::execute(s0, D);
+        return { D, SCC };
+    }
+
+    template<typename T>
+    constexpr Result evaluate_sop2(uint64_t S0, uint64_t S1, Result before = {})
+    {
+        using E   = Execute<T>;
+        using D_t = std::remove_reference_t<typename E::template Arg<2>>;
+        bool SCC  = before.SCC;
+        D_t  D    = 0;
+        const auto s0 = static_cast<typename E::template Arg<0>>(S0);
+        const auto s1 = static_cast<typename E::template Arg<1>>(S1);
+        if constexpr (E::ARITY == 4) T::execute(s0, s1, D, SCC);
+        else                         T::execute(s0, s1, D);
+        return { D, SCC };
+    }
+
+    // SCC is an output exactly when execute() takes it by reference.
+    template<typename T>
+    inline constexpr bool WRITES_SCC = std::is_same_v<typename Execute<T>::template Arg<Execute<T>::ARITY - 1>, bool&>;
+
+    // SCC is an input when flipping it alone changes the result.
+    template<typename T>
+    constexpr bool sop1_reads_scc()
+    {
+        const Result clear = evaluate_sop1<T>(1, { 0, false });
+        const Result set   = evaluate_sop1<T>(1, { 0, true });
+        return clear.D != set.D || (WRITES_SCC<T> && clear.SCC != set.SCC);
+    }
+
+    template<typename T>
+    constexpr bool sop2_reads_scc()
+    {
+        const Result clear = evaluate_sop2<T>(1, 0, { 0, false });
+        const Result set   = evaluate_sop2<T>(1, 0, { 0, true });
+        return clear.D != set.D || (WRITES_SCC<T> && clear.SCC != set.SCC);
+    }
+
+    // ISA conformance vectors, checked by the compiler.
+    namespace conformance
+    {
+        using namespace SOP1;
+        using namespace SOP2;
+
+        static_assert(evaluate_sop2<S_ADD_U32>(0xFFFFFFFF, 1) == Result{ 0, true });
+        static_assert(evaluate_sop2<S_ADD_U32>(1, 2) == Result{ 3, false });
+        static_assert(evaluate_sop2<S_SUB_U32>(0, 1) == Result{ 0xFFFFFFFF, true });
+        static_assert(evaluate_sop2<S_SUB_U32>(5, 3) == Result{ 2, false });
+        static_assert(evaluate_sop2<S_ADD_I32>(0x7FFFFFFF, 1) == Result{ 0x80000000, true });
+        static_assert(evaluate_sop2<S_ADD_I32>(0xFFFFFFFF, 1) == Result{ 0, false });
+        static_assert(evaluate_sop2<S_SUB_I32>(0x80000000, 1) == Result{ 0x7FFFFFFF, true });
+        static_assert(evaluate_sop2<S_SUB_I32>(0, 1) == Result{ 0xFFFFFFFF, false });
+        static_assert(evaluate_sop2<S_ADDC_U32>(0xFFFFFFFF, 0, { 0, true }) == Result{ 0, true });
+        static_assert(evaluate_sop2<S_ADDC_U32>(1, 2, { 0, true }) == Result{ 4, false });
+        static_assert(evaluate_sop2<S_SUBB_U32>(0, 0, { 0, true }) == Result{ 0xFFFFFFFF, true });
+        static_assert(evaluate_sop2<S_SUBB_U32>(5, 2, { 0, true }) == Result{ 2, false });
+        static_assert(evaluate_sop2<S_MIN_I32>(0xFFFFFFFF, 1) == Result{ 0xFFFFFFFF, true });
+        static_assert(evaluate_sop2<S_MIN_U32>(0xFFFFFFFF, 1) == Result{ 1, false });
+        static_assert(evaluate_sop2<S_MAX_I32>(0xFFFFFFFF, 1) == Result{ 1, false });
+        static_assert(evaluate_sop2<S_MAX_U32>(0xFFFFFFFF, 1) == Result{ 0xFFFFFFFF, true });
+        static_assert(evaluate_sop2<S_CSELECT_B32>(5, 7, { 0, true }) == Result{ 5, true });
+        static_assert(evaluate_sop2<S_CSELECT_B32>(5, 7, { 0, false }) == Result{ 7, false });
+        static_assert(evaluate_sop2<S_CSELECT_B64>(0x100000000, 7, { 0, true }) == Result{ 0x100000000, true });
+        static_assert(evaluate_sop2<S_AND_B32>(0xF0, 0x3C) == Result{ 0x30, true });
+        static_assert(evaluate_sop2<S_AND_B32>(0xF0, 0x0F) == Result{ 0, false });
+        static_assert(evaluate_sop2<S_AND_B64>(0xFFFF0000FFFF0000, 0xFF00FF00FF00FF00) == Result{ 0xFF000000FF000000, true });
+        static_assert(evaluate_sop2<S_OR_B32>(0xF0, 0x0F) == Result{ 0xFF, true });
+        static_assert(evaluate_sop2<S_OR_B64>(0, 0) == Result{ 0, false });
+        static_assert(evaluate_sop2<S_XOR_B32>(0xFF, 0xFF) == Result{ 0, false });
+        static_assert(evaluate_sop2<S_XOR_B64>(0xFF00000000, 0xFF) == Result{ 0xFF000000FF, true });
+        static_assert(evaluate_sop2<S_ANDN2_B32>(0xFF, 0x0F) == Result{ 0xF0, true });
+        static_assert(evaluate_sop2<S_ANDN2_B64>(0xFFFFFFFFFFFFFFFF, 0xFFFFFFFF) == Result{ 0xFFFFFFFF00000000, true });
+        static_assert(evaluate_sop2<S_ORN2_B32>(0, 0xFFFFFFFF) == Result{ 0, false });
+        static_assert(evaluate_sop2<S_ORN2_B64>(1, 0xFFFFFFFFFFFFFFFF) == Result{ 1, true });
+        static_assert(evaluate_sop2<S_NAND_B32>(0xFFFFFFFF, 0xFFFFFFFF) == Result{ 0, false });
+        static_assert(evaluate_sop2<S_NAND_B64>(0, 0) == Result{ 0xFFFFFFFFFFFFFFFF, true });
+        static_assert(evaluate_sop2<S_NOR_B32>(0, 0) == Result{ 0xFFFFFFFF, true });
+        static_assert(evaluate_sop2<S_NOR_B64>(1, 0xFFFFFFFFFFFFFFFE) == Result{ 0, false });
+        static_assert(evaluate_sop2<S_XNOR_B32>(0xF0F0F0F0, 0x0F0F0F0F) == Result{ 0, false });
+        static_assert(evaluate_sop2<S_XNOR_B64>(0, 0) == Result{ 0xFFFFFFFFFFFFFFFF, true });
+        static_assert(evaluate_sop2<S_LSHL_B32>(1, 31) == Result{ 0x80000000, true });
+        static_assert(evaluate_sop2<S_LSHL_B32>(1, 32) == Result{ 1, true }); // shift count is S1[4:0]
+        static_assert(evaluate_sop2<S_LSHL_B64>(1, 63) == Result{ 0x8000000000000000, true });
+        static_assert(evaluate_sop2<S_LSHL_B64>(1, 64) == Result{ 1, true }); // shift count is S1[5:0]
+        static_assert(evaluate_sop2<S_LSHR_B32>(0x80000000, 31) == Result{ 1, true });
+        static_assert(evaluate_sop2<S_LSHR_B32>(1, 1) == Result{ 0, false });
+        static_assert(evaluate_sop2<S_LSHR_B64>(0x8000000000000000, 63) == Result{ 1, true });
+
+        static_assert(evaluate_sop1<S_MOV_B32>(0x12345678) == Result{ 0x12345678, false });
+        static_assert(evaluate_sop1<S_MOV_B64>(0x123456789) == Result{ 0x123456789, false });
+        static_assert(evaluate_sop1<S_CMOV_B32>(5, { 7, false }) == Result{ 7, false });
+        static_assert(evaluate_sop1<S_CMOV_B32>(5, { 7, true }) == Result{ 5, true });
+        static_assert(evaluate_sop1<S_CMOV_B64>(0x500000000, { 7, true }) == Result{ 0x500000000, true });
+        static_assert(evaluate_sop1<S_CMOV_B64>(0x500000000, { 7, false }) == Result{ 7, false });
+        static_assert(evaluate_sop1<S_NOT_B32>(0) == Result{ 0xFFFFFFFF, true });
+        static_assert(evaluate_sop1<S_NOT_B64>(0xFFFFFFFFFFFFFFFF) == Result{ 0, false });
+        static_assert(evaluate_sop1<S_WQM_B32>(0x00000101) == Result{ 0x00000F0F, true });
+        static_assert(evaluate_sop1<S_WQM_B32>(0) == Result{ 0, false });
+        static_assert(evaluate_sop1<S_WQM_B64>(0x8000000000000001) == Result{ 0xF00000000000000F, true });
+        static_assert(evaluate_sop1<S_BREV_B32>(1) == Result{ 0x80000000, false });
+        static_assert(evaluate_sop1<S_BREV_B64>(1) == Result{ 0x8000000000000000, false });
+        static_assert(evaluate_sop1<S_BCNT0_I32_B32>(0) == Result{ 32, true });
+        static_assert(evaluate_sop1<S_BCNT0_I32_B32>(0xFFFFFFFF) == Result{ 0, false });
+        static_assert(evaluate_sop1<S_BCNT0_I32_B64>(0xFF) == Result{ 56, true });
+        static_assert(evaluate_sop1<S_BCNT1_I32_B32>(0xF0F0) == Result{ 8, true });
+        static_assert(evaluate_sop1<S_BCNT1_I32_B64>(0) == Result{ 0, false });
+        static_assert(evaluate_sop1<S_FF0_I32_B32>(0xFFFFFFFF) == Result{ 0xFFFFFFFF, false });
+        static_assert(evaluate_sop1<S_FF0_I32_B32>(0x0000FFFF) == Result{ 16, false });
+        static_assert(evaluate_sop1<S_FF0_I32_B64>(0x00000000FFFFFFFF) == Result{ 32, false });
+        static_assert(evaluate_sop1<S_FF1_I32_B32>(0x8) == Result{ 3, false });
+        static_assert(evaluate_sop1<S_FF1_I32_B64>(0x8000000000000000) == Result{ 63, false });
+        static_assert(evaluate_sop1<S_FF1_I32_B64>(0) == Result{ 0xFFFFFFFF, false });
+        static_assert(evaluate_sop1<S_FLBIT_I32_B32>(1) == Result{ 31, false });
+        static_assert(evaluate_sop1<S_FLBIT_I32_B32>(0) == Result{ 0xFFFFFFFF, false });
+        static_assert(evaluate_sop1<S_FLBIT_I32_B64>(0x0000000100000000) == Result{ 31, false });
+
+        // Exactly these read SCC; liveness (liveness.hpp) and timing rely on the probe finding them.
+        static_assert(sop1_reads_scc<S_CMOV_B32>() && sop1_reads_scc<S_CMOV_B64>() && !sop1_reads_scc<S_MOV_B32>() && !sop1_reads_scc<S_NOT_B64>());
+        static_assert(sop2_reads_scc<S_ADDC_U32>() && sop2_reads_scc<S_SUBB_U32>() && sop2_reads_scc<S_CSELECT_B32>() && sop2_reads_scc<S_CSELECT_B64>());
+        static_assert(!sop2_reads_scc<S_ADD_U32>() && !sop2_reads_scc<S_AND_B64>() && !sop2_reads_scc<S_LSHR_B32>());
+    }
+}
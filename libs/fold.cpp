@@ -0,0 +1,215 @@
+#include "fold.hpp"
+#include "evaluate.hpp"
+#include <array>
+
+namespace vega
+{
+    namespace
+    {
+        using Evaluator = Result (*)(uint64_t S0, uint64_t S1, Result before);
+
+        struct FoldInfo
+        {
+            Evaluator fn         = nullptr;
+            uint8_t   S0_bytes   = 0;
+            uint8_t   S1_bytes   = 0; // 0 for SOP1
+            uint8_t   D_bytes    = 0;
+            bool      writes_scc = false;
+        };
+
+        template<typename T>
+        Result evaluate_sop1_fn(uint64_t S0, uint64_t, Result before) { return evaluate_sop1<T>(S0, before); }
+
+        template<typename T>
+        Result evaluate_sop2_fn(uint64_t S0, uint64_t S1, Result before) { return evaluate_sop2<T>(S0, S1, before); }
+
+        template<typename T>
+        constexpr FoldInfo sop1_info()
+        {
+            using E = Execute<T>;
+            FoldInfo info;
+            info.fn         = &evaluate_sop1_fn<T>;
+            info.S0_bytes   = sizeof(typename E::template Arg<0>);
+            info.D_bytes    = sizeof(std::remove_reference_t<typename E::template Arg<1>>);
+            info.writes_scc = WRITES_SCC<T>;
+            return info;
+        }
+
+        template<typename T>
+        constexpr FoldInfo sop2_info()
+        {
+            using E = Execute<T>;
+            FoldInfo info;
+            info.fn         = &evaluate_sop2_fn<T>;
+            info.S0_bytes   = sizeof(typename E::template Arg<0>);
+            info.S1_bytes   = sizeof(typename E::template Arg<1>);
+            info.D_bytes    = sizeof(std::remove_reference_t<typename E::template Arg<2>>);
+            info.writes_scc = WRITES_SCC<T>;
+            return info;
+        }
+
+        template<typename... Ts>
+        constexpr std::array<FoldInfo, SOP1_OPCODES> make_sop1_info(InstructionList<Ts...>)
+        {
+            std::array<FoldInfo, SOP1_OPCODES> table{};
+            ((table[Ts::ID] = sop1_info<Ts>()), ...);
+            return table;
+        }
+
+        template<typename... Ts>
+        constexpr std::array<FoldInfo, SOP2_OPCODES> make_sop2_info(InstructionList<Ts...>)
+        {
+            std::array<FoldInfo, SOP2_OPCODES> table{};
+            ((table[Ts::ID] = sop2_info<Ts>()), ...);
+            return table;
+        }
+
+        constexpr auto SOP1_INFO = make_sop1_info(SOP1::ALL{});
+        constexpr auto SOP2_INFO = make_sop2_info(SOP2::ALL{});
+
+        // Scalar state known at translation time, mirroring Wavefront::read/write.
+        struct Known
+        {
+            uint32_t value[128] = {};
+            bool     known[128] = {};
+            bool     SCC        = false;
+            bool     SCC_known  = false;
+
+            void forget_all()
+            {
+                for (bool& k : known) k = false;
+                SCC_known = false;
+            }
+
+            void forget(uint8_t sdst, uint8_t bytes)
+            {
+                known[sdst & 0x7F] = false;
+                if (bytes == 8) known[(sdst + 1) & 0x7F] = false;
+            }
+
+            void write(uint8_t sdst, uint8_t bytes, uint64_t v)
+            {
+                value[sdst & 0x7F] = static_cast<uint32_t>(v);
+                known[sdst & 0x7F] = true;
+                if (bytes == 8)
+                {
+                    value[(sdst + 1) & 0x7F] = static_cast<uint32_t>(v >> 32);
+                    known[(sdst + 1) & 0x7F] = true;
+                }
+            }
+
+            bool read(uint8_t src, uint8_t bytes, uint32_t literal, uint64_t& out) const
+            {
+                const bool wide = bytes == 8;
+                if (src <= Operand::EXEC_HI)
+                {
+                    const uint8_t hi = (src + 1) & 0x7F;
+                    if (!known[src] || (wide && !known[hi])) return false;
+                    out = wide ? value[src] | (static_cast<uint64_t>(value[hi]) << 32) : value[src];
+                    return true;
+                }
+                if (src == Operand::LITERAL)
+                {
+                    out = wide ? static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(literal))) : literal;
+                    return true;
+                }
+                if (Operand::is_inline(src))
+                {
+                    out = wide ? Operand::inline_b64(src) : Operand::inline_b32(src);
+                    return true;
+                }
+                if (src == Operand::SCC && SCC_known)
+                {
+                    out = SCC;
+                    return true;
+                }
+                return false;
+            }
+        };
+
+        constexpr int SCC_KEEP = -1;
+
+        template<bool WIDE, int SCC_OUT>
+        void store_folded(Wavefront& wave, const Instruction& inst, uint32_t literal)
+        {
+            if constexpr (WIDE) wave.write<uint64_t>(inst.SDST, static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(literal))));
+            else                wave.write<uint32_t>(inst.SDST, literal);
+            if constexpr (SCC_OUT != SCC_KEEP) wave.SCC = SCC_OUT;
+        }
+
+        // [wide][SCC_KEEP, clear, set]
+        constexpr WaveHandler STORE_FOLDED[2][3] = {
+            { &store_folded<false, SCC_KEEP>, &store_folded<false, 0>, &store_folded<false, 1> },
+            { &store_folded<true, SCC_KEEP>,  &store_folded<true, 0>,  &store_folded<true, 1> },
+        };
+    }
+
+    size_t fold_constants(Translation& translation)
+    {
+        Known  known;
+        size_t folded = 0;
+        size_t block  = 0;
+        for (uint32_t i = 0; i < translation.ops.size(); ++i)
+        {
+            // A block can be entered from a branch, so nothing carries over into it.
+            if (block < translation.blocks.size() && translation.blocks[block].first == i)
+            {
+                known.forget_all();
+                ++block;
+            }
+            MicroOp&           op = translation.ops[i];
+            const Instruction& in   = op.inst;
+            const FoldInfo*    info = in.format == Format::SOP1 ? &SOP1_INFO[in.OP]
+                                    : in.format == Format::SOP2 ? &SOP2_INFO[in.OP]
+                                    : nullptr;
+            if (info == nullptr || info->fn == nullptr)
+            {
+                known.forget_all();
+                continue;
+            }
+
+            uint64_t S0 = 0, S1 = 0, D = 0;
+            bool constant = known.read(in.SSRC0, info->S0_bytes, op.literal, S0)
+                         && (info->S1_bytes == 0 || known.read(in.SSRC1, info->S1_bytes, op.literal, S1));
+
+            // An unknown old D or SCC only blocks the fold if the result depends on it
+            // (S_CMOV, S_CSELECT, S_ADDC/S_SUBB), which the signatures cannot tell apart.
+            Result r = {};
+            if (constant)
+            {
+                const bool d_known = known.read(in.SDST, info->D_bytes, 0, D);
+                for (int probe = 0; probe < 4 && constant; ++probe)
+                {
+                    const bool     scc = known.SCC_known ? known.SCC : (probe & 1) != 0;
+                    const uint64_t d   = d_known ? D : (probe & 2) ? ~0ULL : 0;
+                    const Result   p   = info->fn(S0, S1, { d, scc });
+                    if (probe == 0) r = p;
+                    constant = p.D == r.D && (!info->writes_scc || p.SCC == r.SCC);
+                }
+            }
+            if (!constant)
+            {
+                known.forget(in.SDST, info->D_bytes);
+                if (info->writes_scc) known.SCC_known = false;
+                continue;
+            }
+
+            known.write(in.SDST, info->D_bytes, r.D);
+            if (info->writes_scc)
+            {
+                known.SCC       = r.SCC;
+                known.SCC_known = true;
+            }
+
+            const bool wide = info->D_bytes == 8;
+            if (wide && r.D != static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(r.D)))) continue;
+
+            op.fn          = STORE_FOLDED[wide][info->writes_scc ? 1 + r.SCC : 0];
+            op.inst.format = Format::FOLDED;
+            op.literal     = static_cast<uint32_t>(r.D);
+            op.scc_dead    = false;
+            ++folded;
+        }
+        return folded;
+    }
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "uop_cache.hpp"
+#include <cstddef>
+
+namespace vega
+{
+    // Replaces SOP1/SOP2 µops whose operands are all known at translation time (inline
+    // constants, literals, or registers and SCC set earlier in the same basic block)
+    // with a Format::FOLDED store of the precomputed D and SCC. Any other µop ends the run.
+    // 64-bit results are only folded when they fit a sign-extended literal. Returns the
+    // number of µops replaced.
+    size_t fold_constants(Translation& translation);
+}
@@ -0,0 +1,134 @@
+#include "fuse.hpp"
+#include <vector>
+
+namespace vega
+{
+    namespace
+    {
+        using namespace SOP2;
+
+        // [SUBTRACT][HighHalf][SCC_LIVE]
+        constexpr WaveHandler ADD64[2][3][2] = {
+            { { &execute_add64<false, HighHalf::PAIR, false>, &execute_add64<false, HighHalf::PAIR> },
+              { &execute_add64<false, HighHalf::ZERO, false>, &execute_add64<false, HighHalf::ZERO> },
+              { &execute_add64<false, HighHalf::ONES, false>, &execute_add64<false, HighHalf::ONES> } },
+            { { &execute_add64<true, HighHalf::PAIR, false>, &execute_add64<true, HighHalf::PAIR> },
+              { &execute_add64<true, HighHalf::ZERO, false>, &execute_add64<true, HighHalf::ZERO> },
+              { &execute_add64<true, HighHalf::ONES, false>, &execute_add64<true, HighHalf::ONES> } },
+        };
+
+        // [Fused::*][SCC_LIVE]; ADDC and SUBB read SCC anyway.
+        constexpr WaveHandler PAIR[Fused::COUNT][2] = {
+            { &execute_pair<S_ADD_U32, S_ADDC_U32, false>, &execute_pair<S_ADD_U32, S_ADDC_U32> },
+            { &execute_pair<S_SUB_U32, S_SUBB_U32, false>, &execute_pair<S_SUB_U32, S_SUBB_U32> },
+            { &execute_pair<S_LSHL_B32, S_ADD_U32, false>, &execute_pair<S_LSHL_B32, S_ADD_U32> },
+        };
+
+        // [SCC_LIVE] for an S_ADD_U32 that takes the S_LSHL_B32's SCC as an operand.
+        constexpr WaveHandler LSHL_ADD_SCC[2] = {
+            &execute_pair<S_LSHL_B32, S_ADD_U32, false, true>, &execute_pair<S_LSHL_B32, S_ADD_U32, true, true> };
+
+        int pair_kind(const Instruction& first, const Instruction& second)
+        {
+            if (first.format != Format::SOP2 || second.format != Format::SOP2) return -1;
+            if (first.OP == S_ADD_U32::ID && second.OP == S_ADDC_U32::ID)  return Fused::ADD_ADDC;
+            if (first.OP == S_SUB_U32::ID && second.OP == S_SUBB_U32::ID)  return Fused::SUB_SUBB;
+            if (first.OP == S_LSHL_B32::ID && second.OP == S_ADD_U32::ID)  return Fused::LSHL_ADD;
+            return -1;
+        }
+
+        // Registers a 64-bit access can take as one pair without the EXEC_HI wrap.
+        constexpr bool low_of_pair(uint8_t code) { return code < Operand::EXEC_HI; }
+
+        // The 64-bit form, or nullptr when the operands do not line up as pairs or the second
+        // instruction reads what the first one wrote.
+        WaveHandler add64_handler(const MicroOp& first, const MicroOp& second, bool subtract)
+        {
+            const Instruction& a = first.inst;
+            const Instruction& b = second.inst;
+            if (!low_of_pair(a.SDST) || b.SDST != a.SDST + 1) return nullptr;
+            if (!low_of_pair(a.SSRC0) || b.SSRC0 != a.SSRC0 + 1 || a.SDST == b.SSRC0) return nullptr;
+
+            HighHalf high;
+            if (b.SSRC1 == Operand::ZERO)                 high = HighHalf::ZERO;
+            else if (b.SSRC1 == Operand::INT_POS_MAX + 1) high = HighHalf::ONES; // inline -1
+            else if (low_of_pair(a.SSRC1) && b.SSRC1 == a.SSRC1 + 1 && a.SDST != b.SSRC1) high = HighHalf::PAIR;
+            else return nullptr;
+            return ADD64[subtract][static_cast<int>(high)][!second.scc_dead];
+        }
+    }
+
+    WaveHandler pair_handler(uint8_t kind, const Instruction& second, bool scc_live)
+    {
+        const bool scc_operand = second.SSRC0 == Operand::SCC || second.SSRC1 == Operand::SCC;
+        if (kind == Fused::LSHL_ADD && scc_operand) return LSHL_ADD_SCC[scc_live];
+        return PAIR[kind][scc_live];
+    }
+
+    size_t fuse_pairs(Translation& translation)
+    {
+        std::vector<MicroOp>& ops = translation.ops;
+        const uint32_t        n   = static_cast<uint32_t>(ops.size());
+        std::vector<uint32_t> index(n + 1); // old op index -> new one
+        std::vector<MicroOp>  out;
+        out.reserve(n);
+
+        // Both halves of a pair must lie in one block body: nothing branches to the second.
+        std::vector<uint32_t> body_end(n, 0);
+        for (const Block& b : translation.blocks)
+        {
+            for (uint32_t i = b.first; i < b.end; ++i) body_end[i] = b.end;
+        }
+
+        size_t fused = 0;
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            index[i] = static_cast<uint32_t>(out.size());
+            const int kind = i + 1 < body_end[i] ? pair_kind(ops[i].inst, ops[i + 1].inst) : -1;
+            if (kind < 0)
+            {
+                out.push_back(ops[i]);
+                continue;
+            }
+
+            const MicroOp& first   = ops[i];
+            const MicroOp& second  = ops[i + 1];
+            WaveHandler    fn      = kind != Fused::LSHL_ADD ? add64_handler(first, second, kind == Fused::SUB_SUBB) : nullptr;
+            uint32_t       literal = first.literal;
+            if (fn == nullptr)
+            {
+                if (has_literal(first.inst) || has_literal(second.inst))
+                {
+                    out.push_back(ops[i]);
+                    continue;
+                }
+                fn      = pair_handler(static_cast<uint8_t>(kind), second.inst, !second.scc_dead);
+                literal = pack_second(second.inst);
+            }
+
+            MicroOp op     = first;
+            op.fn          = fn;
+            op.inst.format = Format::FUSED;
+            op.inst.OP     = static_cast<uint8_t>(kind);
+            op.literal     = literal;
+            op.scc_dead    = second.scc_dead;
+            out.push_back(op);
+            index[++i] = static_cast<uint32_t>(out.size() - 1);
+            ++fused;
+        }
+        index[n] = static_cast<uint32_t>(out.size());
+        if (fused == 0) return 0;
+
+        for (MicroOp& op : out)
+        {
+            if (is_control(op.inst) && op.target != Translation::LEAVE) op.target = index[op.target];
+        }
+        for (Block& b : translation.blocks)
+        {
+            b.first = index[b.first];
+            b.end   = index[b.end];
+        }
+        ops = std::move(out);
+        return fused;
+    }
+}
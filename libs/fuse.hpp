@@ -0,0 +1,83 @@
+#pragma once
+
+#include "evaluate.hpp"
+#include "uop_cache.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Superinstructions: fuse_pairs() replaces adjacent SOP2 pairs inside a block with one
+// Format::FUSED µop, halving dispatches on 64-bit address arithmetic:
+//
+//     s_add_u32  s0, s2, s4            s_lshl_b32 s6, s1, 2
+//     s_addc_u32 s1, s3, s5            s_add_u32  s6, s6, s8
+//
+// ADD/ADDC and SUB/SUBB over SGPR pairs (the high half of B may also be the inline 0 or -1
+// of a 32-bit constant) become one 64-bit add or subtract: execute_add64<>. Any other
+// pair in FUSED_PAIRS without a literal runs both structs from one handler, with the
+// second instruction's operands packed into the literal: execute_pair<>. Either way the
+// SGPRs and SCC afterwards are exactly those of the two instructions run in turn.
+namespace vega
+{
+    namespace Fused // Instruction::OP of a Format::FUSED µop
+    {
+        enum : uint8_t
+        {
+            ADD_ADDC,  // S_ADD_U32  + S_ADDC_U32
+            SUB_SUBB,  // S_SUB_U32  + S_SUBB_U32
+            LSHL_ADD,  // S_LSHL_B32 + S_ADD_U32
+            COUNT
+        };
+    }
+
+    inline constexpr const char* FUSED_NAMES[Fused::COUNT] = { "S_ADD_U32+S_ADDC_U32", "S_SUB_U32+S_SUBB_U32", "S_LSHL_B32+S_ADD_U32" };
+
+    // What B's high half is in execute_add64<>.
+    enum class HighHalf : uint8_t
+    {
+        PAIR, // SSRC1 + 1
+        ZERO, // inline 0
+        ONES, // inline -1
+    };
+
+    // SDST/SSRC0 name the low registers of the D and A pairs, SSRC1 the low half of B.
+    template<bool SUBTRACT, HighHalf HIGH, bool SCC_LIVE = true>
+    void execute_add64(Wavefront& wave, const Instruction& inst, uint32_t literal)
+    {
+        const uint64_t A = wave.read<uint64_t>(inst.SSRC0, 0);
+        uint64_t       B = 0;
+        if constexpr (HIGH == HighHalf::PAIR) B = wave.read<uint64_t>(inst.SSRC1, 0);
+        else B = wave.read<uint32_t>(inst.SSRC1, literal) | (HIGH == HighHalf::ONES ? 0xFFFFFFFF00000000ULL : 0);
+
+        const uint64_t D = SUBTRACT ? A - B : A + B;
+        if constexpr (SCC_LIVE) wave.SCC = SUBTRACT ? B > A : D < A; // carry/borrow out of bit 63
+        wave.write<uint64_t>(inst.SDST, D);
+    }
+
+    // Second instruction's SDST | SSRC0 << 8 | SSRC1 << 16 in `literal`. First's SCC is only
+    // stored when the second reads it: by definition, or with FIRST_SCC, as an SCC operand.
+    template<typename First, typename Second, bool SCC_LIVE = true, bool FIRST_SCC = sop2_reads_scc<Second>()>
+    void execute_pair(Wavefront& wave, const Instruction& inst, uint32_t literal)
+    {
+        Instruction second;
+        second.format = Format::SOP2;
+        second.OP     = Second::ID;
+        second.SDST   = static_cast<uint8_t>(literal);
+        second.SSRC0  = static_cast<uint8_t>(literal >> 8);
+        second.SSRC1  = static_cast<uint8_t>(literal >> 16);
+        execute_sop2<First, FIRST_SCC>(wave, inst, 0);
+        execute_sop2<Second, SCC_LIVE>(wave, second, 0);
+    }
+
+    constexpr uint32_t pack_second(const Instruction& second)
+    {
+        return second.SDST | (uint32_t{ second.SSRC0 } << 8) | (uint32_t{ second.SSRC1 } << 16);
+    }
+
+    // The execute_pair<> instance fuse_pairs() picks for a Fused::* kind and its second instruction.
+    WaveHandler pair_handler(uint8_t kind, const Instruction& second, bool scc_live);
+
+    // Merges every fusable pair of adjacent µops in a block body; blocks and branch targets are
+    // renumbered. Run after fold_constants() and drop_dead_scc(). Returns the pairs fused.
+    size_t fuse_pairs(Translation& translation);
+}
@@ -0,0 +1,328 @@
+#include "jit_x64.hpp"
+#include <cstddef>
+#include <cstring>
+
+#if VEGA_JIT_X64
+#include <sys/mman.h>
+#endif
+
+namespace vega
+{
+    namespace
+    {
+        // Generated code: System V, RDI = Wavefront*, scratch EAX/ECX/EDX only, no stack use.
+        enum Reg : uint8_t { EAX = 0, ECX = 1, EDX = 2 };
+
+        constexpr uint32_t SCC_OFFSET = offsetof(Wavefront, SCC);
+        static_assert(offsetof(Wavefront, SGPR) == 0);
+
+        // Condition codes (low nibble of Jcc/SETcc/CMOVcc)
+        enum Cond : uint8_t { CC_B = 0x2, CC_AE = 0x3, CC_Z = 0x4, CC_NZ = 0x5, CC_BE = 0x6, CC_A = 0x7,
+                              CC_L = 0xC, CC_GE = 0xD, CC_LE = 0xE, CC_G = 0xF };
+
+        struct Emitter
+        {
+            std::vector<uint8_t> code;
+            bool                 scc_dead = false; // the µop being emitted has MicroOp::scc_dead
+
+            void byte(uint8_t b) { code.push_back(b); }
+            void u32(uint32_t v)
+            {
+                for (int i = 0; i < 4; ++i) byte(static_cast<uint8_t>(v >> (8 * i)));
+            }
+            void rex_w(bool wide) { if (wide) byte(0x48); }
+
+            // mov reg, [rdi + disp32] / mov [rdi + disp32], reg
+            void load_mem(Reg reg, uint32_t disp, bool wide)  { rex_w(wide); byte(0x8B); byte(0x87 | (reg << 3)); u32(disp); }
+            void store_mem(Reg reg, uint32_t disp, bool wide) { rex_w(wide); byte(0x89); byte(0x87 | (reg << 3)); u32(disp); }
+
+            // mov reg, imm32 (sign-extended to 64 bits when wide)
+            void load_imm(Reg reg, uint32_t imm, bool wide)
+            {
+                if (wide) { byte(0x48); byte(0xC7); byte(0xC0 | reg); }
+                else      { byte(0xB8 | reg); }
+                u32(imm);
+            }
+
+            void load_src(Reg reg, uint8_t src, uint32_t literal, bool wide)
+            {
+                if (src <= Operand::EXEC_HI)          load_mem(reg, src * 4, wide);
+                else if (src == Operand::LITERAL)     load_imm(reg, literal, wide);
+                else                                  load_imm(reg, Operand::inline_b32(src), wide);
+            }
+
+            // <op> eax, ecx for the 01/09/11/19/21/29/31/39 ALU group
+            void alu(uint8_t opcode, bool wide) { rex_w(wide); byte(opcode); byte(0xC8); }
+            void not_eax(bool wide)             { rex_w(wide); byte(0xF7); byte(0xD0); }
+            void not_ecx(bool wide)             { rex_w(wide); byte(0xF7); byte(0xD1); }
+            void test_eax(bool wide)            { rex_w(wide); byte(0x85); byte(0xC0); }
+            void shift_cl(uint8_t ext, bool wide) { rex_w(wide); byte(0xD3); byte(0xC0 | (ext << 3)); }
+            void cmov_eax_ecx(Cond cc, bool wide) { rex_w(wide); byte(0x0F); byte(0x40 | cc); byte(0xC1); }
+
+            void set_scc(Cond cc) { if (scc_dead) return; byte(0x0F); byte(0x90 | cc); byte(0x87); u32(SCC_OFFSET); }
+            void cmp_scc_zero()   { byte(0x80); byte(0xBF); u32(SCC_OFFSET); byte(0x00); }
+
+            // CF = SCC: movzx edx, byte [rdi + SCC]; bt edx, 0
+            void scc_to_carry()
+            {
+                byte(0x0F); byte(0xB6); byte(0x97); u32(SCC_OFFSET);
+                byte(0x0F); byte(0xBA); byte(0xE2); byte(0x00);
+            }
+
+            void ret() { byte(0xC3); }
+        };
+
+        enum class Kind : uint8_t
+        {
+            NONE,
+            ADD, SUB, ADDC, SUBB,         // arithmetic, SCC = carry/borrow
+            AND, OR, XOR, ANDN2,          // logic, SCC = D != 0
+            LSHL, LSHR,                   // shifts, SCC = D != 0
+            MIN_U, MAX_U, MIN_I, MAX_I,   // compare + select, SCC = S0 chosen
+            CSELECT,                      // D = SCC ? S0 : S1
+            MOV, CMOV, NOT,               // SOP1
+        };
+
+        struct Lowering
+        {
+            Kind kind = Kind::NONE;
+            bool wide = false;
+        };
+
+        Lowering lowering(const Instruction& inst)
+        {
+            if (inst.format == Format::SOP2)
+            {
+                using namespace SOP2;
+                switch (inst.OP)
+                {
+                    case S_ADD_U32::ID:     return { Kind::ADD, false };
+                    case S_SUB_U32::ID:     return { Kind::SUB, false };
+                    case S_ADDC_U32::ID:    return { Kind::ADDC, false };
+                    case S_SUBB_U32::ID:    return { Kind::SUBB, false };
+                    case S_MIN_I32::ID:     return { Kind::MIN_I, false };
+                    case S_MIN_U32::ID:     return { Kind::MIN_U, false };
+                    case S_MAX_I32::ID:     return { Kind::MAX_I, false };
+                    case S_MAX_U32::ID:     return { Kind::MAX_U, false };
+                    case S_CSELECT_B32::ID: return { Kind::CSELECT, false };
+                    case S_CSELECT_B64::ID: return { Kind::CSELECT, true };
+                    case S_AND_B32::ID:     return { Kind::AND, false };
+                    case S_AND_B64::ID:     return { Kind::AND, true };
+                    case S_OR_B32::ID:      return { Kind::OR, false };
+                    case S_OR_B64::ID:      return { Kind::OR, true };
+                    case S_XOR_B32::ID:     return { Kind::XOR, false };
+                    case S_XOR_B64::ID:     return { Kind::XOR, true };
+                    case S_ANDN2_B32::ID:   return { Kind::ANDN2, false };
+                    case S_ANDN2_B64::ID:   return { Kind::ANDN2, true };
+                    case S_LSHL_B32::ID:    return { Kind::LSHL, false };
+                    case S_LSHL_B64::ID:    return { Kind::LSHL, true };
+                    case S_LSHR_B32::ID:    return { Kind::LSHR, false };
+                    case S_LSHR_B64::ID:    return { Kind::LSHR, true };
+                    default:                return {};
+                }
+            }
+            if (inst.format == Format::SOP1)
+            {
+                using namespace SOP1;
+                switch (inst.OP)
+                {
+                    case S_MOV_B32::ID:  return { Kind::MOV, false };
+                    case S_MOV_B64::ID:  return { Kind::MOV, true };
+                    case S_CMOV_B32::ID: return { Kind::CMOV, false };
+                    case S_CMOV_B64::ID: return { Kind::CMOV, true };
+                    case S_NOT_B32::ID:  return { Kind::NOT, false };
+                    case S_NOT_B64::ID:  return { Kind::NOT, true };
+                    default:             return {};
+                }
+            }
+            return {};
+        }
+
+        // Registers, integer inline constants and literals; a wide pair may not wrap past EXEC_HI.
+        bool src_supported(uint8_t src, bool wide)
+        {
+            if (src < Operand::EXEC_HI) return true;
+            if (src == Operand::EXEC_HI) return !wide;
+            return src == Operand::LITERAL || (src >= Operand::ZERO && src <= Operand::INT_NEG_MAX);
+        }
+
+        void emit(Emitter& e, const MicroOp& op)
+        {
+            const Instruction& in = op.inst;
+            const Lowering     l  = lowering(in);
+            const bool         w  = l.wide;
+            const uint32_t     d  = in.SDST * 4u;
+            e.scc_dead = op.scc_dead;
+
+            e.load_src(EAX, in.SSRC0, op.literal, w);
+
+            switch (l.kind)
+            {
+                case Kind::MOV:
+                    e.store_mem(EAX, d, w);
+                    return;
+                case Kind::CMOV:
+                    e.load_mem(ECX, d, w);
+                    e.cmp_scc_zero();
+                    e.cmov_eax_ecx(CC_Z, w);
+                    e.store_mem(EAX, d, w);
+                    return;
+                case Kind::NOT:
+                    e.not_eax(w);
+                    e.test_eax(w);
+                    e.store_mem(EAX, d, w);
+                    e.set_scc(CC_NZ);
+                    return;
+                default:
+                    break;
+            }
+
+            e.load_src(ECX, in.SSRC1, op.literal, w);
+            switch (l.kind)
+            {
+                case Kind::ADD:  e.alu(0x01, w); e.store_mem(EAX, d, w); e.set_scc(CC_B); return;
+                case Kind::SUB:  e.alu(0x29, w); e.store_mem(EAX, d, w); e.set_scc(CC_B); return;
+                case Kind::ADDC: e.scc_to_carry(); e.alu(0x11, w); e.store_mem(EAX, d, w); e.set_scc(CC_B); return;
+                case Kind::SUBB: e.scc_to_carry(); e.alu(0x19, w); e.store_mem(EAX, d, w); e.set_scc(CC_B); return;
+                case Kind::AND:  e.alu(0x21, w); e.store_mem(EAX, d, w); e.set_scc(CC_NZ); return;
+                case Kind::OR:   e.alu(0x09, w); e.store_mem(EAX, d, w); e.set_scc(CC_NZ); return;
+                case Kind::XOR:  e.alu(0x31, w); e.store_mem(EAX, d, w); e.set_scc(CC_NZ); return;
+                case Kind::ANDN2:
+                    e.not_ecx(w);
+                    e.alu(0x21, w);
+                    e.store_mem(EAX, d, w);
+                    e.set_scc(CC_NZ);
+                    return;
+                // x86 masks the count to 5/6 bits exactly like S1[4:0]/S1[5:0]; a zero count
+                // leaves flags untouched, hence the explicit test.
+                case Kind::LSHL: e.shift_cl(4, w); e.test_eax(w); e.store_mem(EAX, d, w); e.set_scc(CC_NZ); return;
+                case Kind::LSHR: e.shift_cl(5, w); e.test_eax(w); e.store_mem(EAX, d, w); e.set_scc(CC_NZ); return;
+                case Kind::MIN_U: e.alu(0x39, w); e.set_scc(CC_B); e.cmov_eax_ecx(CC_AE, w); e.store_mem(EAX, d, w); return;
+                case Kind::MAX_U: e.alu(0x39, w); e.set_scc(CC_A); e.cmov_eax_ecx(CC_BE, w); e.store_mem(EAX, d, w); return;
+                case Kind::MIN_I: e.alu(0x39, w); e.set_scc(CC_L); e.cmov_eax_ecx(CC_GE, w); e.store_mem(EAX, d, w); return;
+                case Kind::MAX_I: e.alu(0x39, w); e.set_scc(CC_G); e.cmov_eax_ecx(CC_LE, w); e.store_mem(EAX, d, w); return;
+                case Kind::CSELECT:
+                    e.cmp_scc_zero();
+                    e.cmov_eax_ecx(CC_Z, w);
+                    e.store_mem(EAX, d, w);
+                    return;
+                default:
+                    return;
+            }
+        }
+    }
+
+    bool jit_supports(const MicroOp& op)
+    {
+        const Lowering l = lowering(op.inst);
+        if (l.kind == Kind::NONE) return false;
+        if (l.wide && op.inst.SDST >= Operand::EXEC_HI) return false;
+        if (!src_supported(op.inst.SSRC0, l.wide)) return false;
+        if (op.inst.format == Format::SOP2 && !src_supported(op.inst.SSRC1, l.wide)) return false;
+        return true;
+    }
+
+    JitCache::~JitCache()
+    {
+        clear();
+    }
+
+    void JitCache::clear()
+    {
+    #if VEGA_JIT_X64
+        for (const Chunk& chunk : chunks)
+        {
+            munmap(chunk.base, CHUNK_SIZE);
+        }
+    #endif
+        chunks.clear();
+        blocks.clear();
+        serial = 0;
+    }
+
+    JitFn JitCache::install(const std::vector<uint8_t>& code)
+    {
+    #if VEGA_JIT_X64
+        const size_t size = (code.size() + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+        if (size > CHUNK_SIZE) return nullptr;
+        if (chunks.empty() || chunks.back().used + size > CHUNK_SIZE)
+        {
+            void* mem = mmap(nullptr, CHUNK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mem == MAP_FAILED) return nullptr;
+            chunks.push_back({ static_cast<uint8_t*>(mem), 0 });
+        }
+
+        // Only the block's own pages change protection; earlier blocks stay executable.
+        Chunk&   chunk = chunks.back();
+        uint8_t* entry = chunk.base + chunk.used;
+        std::memcpy(entry, code.data(), code.size());
+        chunk.used += size;
+
+        if (mprotect(entry, size, PROT_READ | PROT_EXEC) != 0) return nullptr;
+        return reinterpret_cast<JitFn>(entry);
+    #else
+        (void)code;
+        return nullptr;
+    #endif
+    }
+
+    const JitBlock& JitCache::get(const Translation& translation, size_t index)
+    {
+        if (translation.serial != serial)
+        {
+            clear();
+            serial = translation.serial;
+        }
+        const uint32_t pc = translation.ops[index].PC;
+        if (auto it = blocks.find(pc); it != blocks.end())
+        {
+            return it->second;
+        }
+
+        Emitter  e;
+        uint32_t count = 0;
+        for (size_t i = index; i < translation.ops.size() && jit_supports(translation.ops[i]); ++i, ++count)
+        {
+            emit(e, translation.ops[i]);
+        }
+        e.ret();
+
+        JitBlock block;
+        if (count != 0 && (block.fn = install(e.code)) != nullptr)
+        {
+            block.count = count;
+        }
+        return blocks.emplace(pc, block).first->second;
+    }
+
+    Wavefront::Status run_jit(Wavefront& wave, const Translation& translation, JitCache& cache)
+    {
+        const size_t n = translation.ops.size();
+        for (size_t i = 0; i < n;)
+        {
+            const JitBlock& block = cache.get(translation, i);
+            if (block.count != 0)
+            {
+                block.fn(&wave);
+                i += block.count;
+            }
+            else if (is_control(translation.ops[i].inst))
+            {
+                const MicroOp& op   = translation.ops[i];
+                const uint32_t next = op.PC + 4;
+                wave.PC = next;
+                op.fn(wave, op.inst, op.literal);
+                if (wave.PC == next)                        ++i;
+                else if (op.target != Translation::LEAVE) i = op.target;
+                else                                        return translation.left(wave.PC);
+            }
+            else
+            {
+                const MicroOp& op = translation.ops[i++];
+                op.fn(wave, op.inst, op.literal);
+            }
+        }
+        wave.PC = translation.exit_pc;
+        return translation.exit;
+    }
+}
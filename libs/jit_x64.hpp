@@ -0,0 +1,59 @@
+#pragma once
+
+#include "uop_cache.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__x86_64__) && defined(__unix__)
+#define VEGA_JIT_X64 1
+#else
+#define VEGA_JIT_X64 0
+#endif
+
+namespace vega
+{
+    using JitFn = void (*)(Wavefront* wave);
+
+    struct JitBlock
+    {
+        JitFn    fn    = nullptr;
+        uint32_t count = 0; // micro-ops covered; 0 means the op at this PC is left to the interpreter
+    };
+
+    // Native x86-64 blocks for the Translation it was last used with, keyed by the PC of
+    // their first op; get() with another translation (another Translation::serial) drops
+    // them first. Code lives in mmap'd chunks. Each block starts on a fresh page that is
+    // made executable once it is written and never writable again, so other threads may run
+    // installed blocks while one thread calls get(). clear() must not overlap either.
+    struct JitCache
+    {
+        static constexpr size_t CHUNK_SIZE = 256 * 1024;
+        static constexpr size_t PAGE_SIZE  = 4096;
+
+        struct Chunk
+        {
+            uint8_t* base = nullptr;
+            size_t   used = 0; // page-aligned; pages below it are executable, the rest writable
+        };
+
+        std::unordered_map<uint32_t, JitBlock> blocks;
+        std::vector<Chunk>                     chunks;
+        uint64_t                               serial = 0; // Translation::serial of `blocks`
+
+        JitCache() = default;
+        JitCache(const JitCache&) = delete;
+        JitCache& operator=(const JitCache&) = delete;
+        ~JitCache();
+
+        const JitBlock& get(const Translation& translation, size_t index);
+        JitFn install(const std::vector<uint8_t>& code);
+        void clear();
+    };
+
+    // True when the JIT can emit native code for this op (opcode and operand kinds).
+    bool jit_supports(const MicroOp& op);
+
+    Wavefront::Status run_jit(Wavefront& wave, const Translation& translation, JitCache& cache);
+}
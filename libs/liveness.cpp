@@ -0,0 +1,164 @@
+#include "liveness.hpp"
+#include "evaluate.hpp"
+#include <array>
+#include <vector>
+
+namespace vega
+{
+    namespace
+    {
+        struct SccUse
+        {
+            bool reads         = false; // by its semantics; an SCC source operand is checked per µop
+            bool writes        = false;
+            bool falls_through = true;  // false for S_BRANCH and S_ENDPGM
+        };
+
+        template<typename T>
+        constexpr SccUse sopk_use()
+        {
+            constexpr bool three = Execute<T>::ARITY == 3;
+            return { three && !WRITES_SCC<T>, WRITES_SCC<T>, true };
+        }
+
+        template<typename T>
+        constexpr SccUse sopp_use()
+        {
+            if constexpr (Execute<T>::ARITY == 3) return { T::CONDITION == SOPP::Condition::SCC, false, true };
+            else return { false, false, Execute<T>::ARITY != 2 };
+        }
+
+        template<typename... Ts>
+        constexpr std::array<SccUse, SOP1_OPCODES> make_sop1_use(InstructionList<Ts...>)
+        {
+            std::array<SccUse, SOP1_OPCODES> table{};
+            ((table[Ts::ID] = { sop1_reads_scc<Ts>(), WRITES_SCC<Ts>, true }), ...);
+            return table;
+        }
+
+        template<typename... Ts>
+        constexpr std::array<SccUse, SOP2_OPCODES> make_sop2_use(InstructionList<Ts...>)
+        {
+            std::array<SccUse, SOP2_OPCODES> table{};
+            ((table[Ts::ID] = { sop2_reads_scc<Ts>(), WRITES_SCC<Ts>, true }), ...);
+            return table;
+        }
+
+        template<typename... Ts>
+        constexpr std::array<SccUse, SOPK_OPCODES> make_sopk_use(InstructionList<Ts...>)
+        {
+            std::array<SccUse, SOPK_OPCODES> table{};
+            ((table[Ts::ID] = sopk_use<Ts>()), ...);
+            return table;
+        }
+
+        template<typename... Ts>
+        constexpr std::array<SccUse, SOPP_OPCODES> make_sopp_use(InstructionList<Ts...>)
+        {
+            std::array<SccUse, SOPP_OPCODES> table{};
+            ((table[Ts::ID] = sopp_use<Ts>()), ...);
+            return table;
+        }
+
+        constexpr auto SOP1_USE = make_sop1_use(SOP1::ALL{});
+        constexpr auto SOP2_USE = make_sop2_use(SOP2::ALL{});
+        constexpr auto SOPK_USE = make_sopk_use(SOPK::ALL{});
+        constexpr auto SOPP_USE = make_sopp_use(SOPP::ALL{});
+
+        static_assert(SOPK_USE[SOPK::S_CMOVK_I32::ID].reads && SOPK_USE[SOPK::S_ADDK_I32::ID].writes && !SOPK_USE[SOPK::S_MULK_I32::ID].writes);
+        static_assert(SOPP_USE[SOPP::S_CBRANCH_SCC0::ID].reads && !SOPP_USE[SOPP::S_CBRANCH_VCCZ::ID].reads);
+        static_assert(!SOPP_USE[SOPP::S_BRANCH::ID].falls_through && SOPP_USE[SOPP::S_CBRANCH_EXECZ::ID].falls_through);
+
+        constexpr auto SOPK_DEAD_SCC = make_wave_sopk_table<false>(SOPK::ALL{});
+
+        SccUse use_of(const Instruction& inst)
+        {
+            SccUse use;
+            switch (inst.format)
+            {
+                case Format::SOP1: use = SOP1_USE[inst.OP]; break;
+                case Format::SOP2: use = SOP2_USE[inst.OP]; break;
+                case Format::SOPC: use = { false, true, true }; break;
+                case Format::SOPK: use = SOPK_USE[inst.OP]; break;
+                case Format::SOPP: use = SOPP_USE[inst.OP]; break;
+                case Format::FUSED: use.reads = true; break; // its operands are not all in `inst`
+                default:           break; // VOP and SMEM never touch SCC; FOLDED is left alone
+            }
+            const bool scalar = inst.format == Format::SOP1 || inst.format == Format::SOP2 || inst.format == Format::SOPC
+                             || ((inst.format == Format::VOP1 || inst.format == Format::VOP2) && !inst.VSRC0);
+            const bool two    = inst.format == Format::SOP2 || inst.format == Format::SOPC;
+            if (scalar && (inst.SSRC0 == Operand::SCC || (two && inst.SSRC1 == Operand::SCC))) use.reads = true;
+            return use;
+        }
+
+        WaveHandler dead_scc_handler(const Instruction& inst)
+        {
+            switch (inst.format)
+            {
+                case Format::SOP1:
+                case Format::SOP2:
+                case Format::SOPC: return salu_handler(inst, false);
+                case Format::SOPK: return SOPK_DEAD_SCC[inst.OP];
+                default:           return nullptr;
+            }
+        }
+
+        // SCC live before ops[first, last), given whether it is live after them.
+        bool live_before(const Translation& t, uint32_t first, uint32_t last, bool live)
+        {
+            for (uint32_t i = last; i-- > first;)
+            {
+                const SccUse use = use_of(t.ops[i].inst);
+                live = use.reads || (live && !use.writes);
+            }
+            return live;
+        }
+    }
+
+    size_t drop_dead_scc(Translation& translation)
+    {
+        const std::vector<Block>& blocks = translation.blocks;
+        const uint32_t            count  = static_cast<uint32_t>(blocks.size());
+
+        std::vector<uint8_t> live_in(count, 0);
+        const auto live_at = [&](uint32_t b) { return b >= count || live_in[b] != 0; }; // exits and LEAVE read it
+        const auto live_out = [&](const Block& block)
+        {
+            if (!block.control) return live_at(block.next);
+            const SccUse use = use_of(translation.ops[block.end].inst);
+            const bool   out = live_at(block.taken) || (use.falls_through && live_at(block.next));
+            return use.reads || out;
+        };
+
+        // Blocks mostly branch backwards or fall through, so reverse order settles quickly.
+        for (bool changed = true; changed;)
+        {
+            changed = false;
+            for (uint32_t b = count; b-- > 0;)
+            {
+                const uint8_t in = live_before(translation, blocks[b].first, blocks[b].end, live_out(blocks[b])) ? 1 : 0;
+                changed = changed || in != live_in[b];
+                live_in[b] = in;
+            }
+        }
+
+        size_t dropped = 0;
+        for (const Block& block : blocks)
+        {
+            bool live = live_out(block);
+            for (uint32_t i = block.end; i-- > block.first;)
+            {
+                MicroOp&     op  = translation.ops[i];
+                const SccUse use = use_of(op.inst);
+                if (use.writes && !live && !op.scc_dead)
+                {
+                    op.fn       = dead_scc_handler(op.inst);
+                    op.scc_dead = true;
+                    ++dropped;
+                }
+                live = use.reads || (live && !use.writes);
+            }
+        }
+        return dropped;
+    }
+}
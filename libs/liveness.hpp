@@ -0,0 +1,17 @@
+#pragma once
+
+#include "uop_cache.hpp"
+#include <cstddef>
+
+namespace vega
+{
+    // Backward SCC liveness over the translation's blocks. A µop whose SCC result is
+    // overwritten on every path before anything reads it gets a handler that leaves SCC
+    // alone (and skips computing it) and MicroOp::scc_dead. SCC counts as read at every exit
+    // from the translation. Folded µops are taken to neither read nor write SCC, so they keep
+    // theirs. Returns the number of µops changed.
+    //
+    // Only the final SCC of a path is preserved: an observer sees the stale value after a
+    // dropped write.
+    size_t drop_dead_scc(Translation& translation);
+}
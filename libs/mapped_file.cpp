@@ -0,0 +1,86 @@
+#include "mapped_file.hpp"
+#include <cstdio>
+
+#if VEGA_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vega
+{
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    bool MappedFile::open(const char* path, bool sequential)
+    {
+        close();
+    #if VEGA_MMAP
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+        size = static_cast<size_t>(st.st_size);
+        if (size != 0)
+        {
+            void* mem = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mem == MAP_FAILED)
+            {
+                ::close(fd);
+                size = 0;
+                return false;
+            }
+            data = static_cast<const uint8_t*>(mem);
+            if (sequential) madvise(mem, size, MADV_SEQUENTIAL);
+        }
+        ::close(fd); // the mapping keeps the file alive
+        return true;
+    #else
+        (void)sequential;
+        std::FILE* f = std::fopen(path, "rb");
+        if (f == nullptr) return false;
+        uint8_t chunk[1 << 16];
+        for (size_t n; (n = std::fread(chunk, 1, sizeof(chunk), f)) != 0;)
+        {
+            fallback.insert(fallback.end(), chunk, chunk + n);
+        }
+        std::fclose(f);
+        data = fallback.data();
+        size = fallback.size();
+        return true;
+    #endif
+    }
+
+    void MappedFile::close()
+    {
+    #if VEGA_MMAP
+        if (data != nullptr) munmap(const_cast<uint8_t*>(data), size);
+    #endif
+        fallback.clear();
+        data = nullptr;
+        size = 0;
+    }
+
+    void MappedFile::release(size_t offset, size_t length)
+    {
+    #if VEGA_MMAP
+        const size_t page  = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t first = (offset + page - 1) / page * page; // whole pages only
+        const size_t last  = (offset + length) / page * page;
+        if (data != nullptr && first < last && last <= size)
+        {
+            madvise(const_cast<uint8_t*>(data) + first, last - first, MADV_DONTNEED);
+        }
+    #else
+        (void)offset;
+        (void)length;
+    #endif
+    }
+}
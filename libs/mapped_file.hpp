@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define VEGA_MMAP 1
+#else
+#define VEGA_MMAP 0
+#endif
+
+namespace vega
+{
+    // Read-only view of a whole file. With mmap the kernel pages it in on demand, so a
+    // multi-hundred-MB dump costs nothing until it is read; elsewhere the file is read
+    // into `fallback`.
+    struct MappedFile
+    {
+        const uint8_t*       data = nullptr;
+        size_t               size = 0;
+        std::vector<uint8_t> fallback;
+
+        MappedFile() = default;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        // False if the file cannot be opened; an empty file opens with size 0.
+        bool open(const char* path, bool sequential = false);
+        void close();
+
+        // Drops pages of [offset, offset + length) that a streaming reader is done with.
+        void release(size_t offset, size_t length);
+
+        std::span<const uint8_t> bytes() const { return { data, size }; }
+    };
+}
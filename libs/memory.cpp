@@ -0,0 +1,135 @@
+#include "memory.hpp"
+#include <algorithm>
+
+namespace vega
+{
+    namespace
+    {
+        alignas(64) const uint8_t ZERO_PAGE[Memory::PAGE_SIZE] = {};
+    }
+
+    const uint8_t* Memory::find(uint64_t page) const
+    {
+        const auto it = pages.find(page);
+        return it != pages.end() ? it->second.data : ZERO_PAGE;
+    }
+
+    uint8_t* Memory::touch(uint64_t page)
+    {
+        Page& p = pages[page];
+        if (p.owned == nullptr)
+        {
+            p.owned = std::make_unique<uint8_t[]>(PAGE_SIZE); // zeroed
+            if (p.data != nullptr) std::memcpy(p.owned.get(), p.data, PAGE_SIZE);
+            p.data = p.owned.get();
+            ++resident;
+            ++generation;
+        }
+        return p.owned.get();
+    }
+
+    void Memory::read(uint64_t address, void* out, size_t bytes) const
+    {
+        uint8_t* to = static_cast<uint8_t*>(out);
+        while (bytes != 0)
+        {
+            const uint64_t offset = address & (PAGE_SIZE - 1);
+            const size_t   n      = static_cast<size_t>(std::min<uint64_t>(bytes, PAGE_SIZE - offset));
+            std::memcpy(to, find(address >> PAGE_BITS) + offset, n);
+            address += n;
+            to      += n;
+            bytes   -= n;
+        }
+    }
+
+    void Memory::write(uint64_t address, const void* in, size_t bytes)
+    {
+        const uint8_t* from = static_cast<const uint8_t*>(in);
+        while (bytes != 0)
+        {
+            const uint64_t offset = address & (PAGE_SIZE - 1);
+            const size_t   n      = static_cast<size_t>(std::min<uint64_t>(bytes, PAGE_SIZE - offset));
+            std::memcpy(touch(address >> PAGE_BITS) + offset, from, n);
+            address += n;
+            from    += n;
+            bytes   -= n;
+        }
+    }
+
+    bool Memory::map_file(uint64_t address, const char* path)
+    {
+        if ((address & (PAGE_SIZE - 1)) != 0) return false;
+        auto file = std::make_unique<MappedFile>();
+        if (!file->open(path)) return false;
+
+        // Whole pages point into the mapping; the tail is copied, since a read-into-memory
+        // fallback has nothing after the last byte.
+        const uint64_t first = address >> PAGE_BITS;
+        const size_t   whole = file->size / PAGE_SIZE;
+        for (size_t i = 0; i < whole; ++i)
+        {
+            Page& p = pages[first + i];
+            if (p.owned != nullptr) --resident;
+            p.owned.reset();
+            p.data = file->data + i * PAGE_SIZE;
+        }
+        if (const size_t tail = file->size % PAGE_SIZE; tail != 0)
+        {
+            uint8_t* data = touch(first + whole);
+            std::memset(data, 0, PAGE_SIZE);
+            std::memcpy(data, file->data + whole * PAGE_SIZE, tail);
+        }
+        files.push_back(std::move(file));
+        ++generation;
+        return true;
+    }
+
+    void Memory::clear()
+    {
+        pages.clear();
+        files.clear();
+        resident = 0;
+        ++generation;
+    }
+
+    void Tlb::load_slow(uint64_t address, void* out, size_t bytes)
+    {
+        if (memory == nullptr)
+        {
+            std::memset(out, 0, bytes);
+            return;
+        }
+        if (memory->generation != generation) flush();
+
+        uint8_t* to = static_cast<uint8_t*>(out);
+        while (bytes != 0)
+        {
+            const uint64_t page   = address >> Memory::PAGE_BITS;
+            const uint64_t offset = address & (Memory::PAGE_SIZE - 1);
+            const size_t   n      = static_cast<size_t>(std::min<uint64_t>(bytes, Memory::PAGE_SIZE - offset));
+            Entry&         e      = entries[page % ENTRIES];
+            if (e.page != page)
+            {
+                e.page = page;
+                e.data = memory->find(page);
+                ++misses;
+            }
+            std::memcpy(to, e.data + offset, n);
+            address += n;
+            to      += n;
+            bytes   -= n;
+        }
+    }
+
+    void Tlb::attach(const Memory* m)
+    {
+        memory = m;
+        flush();
+    }
+
+    void Tlb::flush()
+    {
+        for (Entry& e : entries) e = {};
+        generation = memory != nullptr ? memory->generation : 0;
+    }
+}
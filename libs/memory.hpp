@@ -0,0 +1,98 @@
+#pragma once
+
+#include "mapped_file.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Sparse 64-bit guest address space for the scalar memory loads:
+//
+//     Memory memory;
+//     memory.write(0x7F0000000000, &kernarg, sizeof(kernarg));
+//     memory.map_file(0x100000000, "constants.bin");
+//     wave.tlb.attach(&memory);           // SMEM loads read through it
+//
+// Pages are PAGE_SIZE bytes, found by page number in a hash map. A page gets host memory the
+// first time it is written; a page never written reads as zeros and costs nothing, so memory
+// use follows the pages touched rather than the addresses used. map_file() points pages
+// straight into an mmap'd file, and a write to one copies it first.
+//
+// Each Wavefront looks pages up through its own Tlb, a small direct-mapped cache of page
+// pointers, so a load within one page is a tag compare and one memcpy. Workers may share a
+// Memory while they only read it; write() and map_file() must not run during a dispatch.
+namespace vega
+{
+    struct Memory
+    {
+        static constexpr int      PAGE_BITS = 12;
+        static constexpr uint64_t PAGE_SIZE = uint64_t{ 1 } << PAGE_BITS;
+
+        struct Page
+        {
+            std::unique_ptr<uint8_t[]> owned;          // written pages
+            const uint8_t*             data = nullptr; // owned.get(), or into a mapped file
+        };
+
+        std::unordered_map<uint64_t, Page>       pages; // by address >> PAGE_BITS
+        std::vector<std::unique_ptr<MappedFile>> files;
+        size_t                                   resident   = 0; // pages with host memory of their own
+        uint64_t                                 generation = 0; // changes whenever a page's data pointer does
+
+        Memory() = default;
+        Memory(const Memory&) = delete;
+        Memory& operator=(const Memory&) = delete;
+
+        // The page's bytes; a shared page of zeros if it was never written or mapped.
+        const uint8_t* find(uint64_t page) const;
+
+        // The page's bytes for writing, allocated or copied out of its file first.
+        uint8_t* touch(uint64_t page);
+
+        void read(uint64_t address, void* out, size_t bytes) const;
+        void write(uint64_t address, const void* in, size_t bytes);
+
+        // Maps the whole file read-only at `address`, which must be page-aligned. False if it
+        // is not or the file cannot be opened.
+        bool map_file(uint64_t address, const char* path);
+
+        void clear();
+    };
+
+    struct Tlb
+    {
+        static constexpr size_t ENTRIES = 32;
+
+        struct Entry
+        {
+            uint64_t       page = UINT64_MAX;
+            const uint8_t* data = nullptr;
+        };
+
+        const Memory* memory     = nullptr; // set by attach(); nullptr: every load reads zeros
+        uint64_t      generation = 0;       // memory->generation the entries were filled at
+        uint64_t      misses     = 0;
+        Entry         entries[ENTRIES];
+
+        // `bytes` at `address` into `out`: one memcpy when they lie in one cached page.
+        void load(uint64_t address, void* out, size_t bytes)
+        {
+            const uint64_t page   = address >> Memory::PAGE_BITS;
+            const uint64_t offset = address & (Memory::PAGE_SIZE - 1);
+            const Entry&   e      = entries[page % ENTRIES];
+            // Entries are only filled with a memory attached.
+            if (e.page == page && offset + bytes <= Memory::PAGE_SIZE && memory->generation == generation)
+            {
+                std::memcpy(out, e.data + offset, bytes);
+                return;
+            }
+            load_slow(address, out, bytes);
+        }
+
+        void load_slow(uint64_t address, void* out, size_t bytes);
+        void attach(const Memory* m);
+        void flush();
+    };
+}
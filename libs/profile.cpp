@@ -0,0 +1,141 @@
+#include "profile.hpp"
+#include "disassembler.hpp"
+#include <algorithm>
+
+namespace vega
+{
+    namespace
+    {
+        const char* name_of(Format format, uint8_t OP)
+        {
+            if (format == Format::FOLDED) return "(folded)";
+            Instruction inst;
+            inst.format = format;
+            inst.OP     = OP;
+            const char* name = instruction_name(inst);
+            return name != nullptr ? name : "(unknown)";
+        }
+
+        double percent(uint64_t part, uint64_t total)
+        {
+            return total != 0 ? 100.0 * static_cast<double>(part) / static_cast<double>(total) : 0.0;
+        }
+    }
+
+    void Profiler::merge(const Profiler& other)
+    {
+        const auto counters = [](Counter* to, const Counter* from, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                to[i].count += from[i].count;
+                to[i].ticks += from[i].ticks;
+            }
+        };
+        counters(SOP1, other.SOP1, SOP1_OPCODES);
+        counters(SOP2, other.SOP2, SOP2_OPCODES);
+        counters(SOPC, other.SOPC, SOPC_OPCODES);
+        counters(SOPK, other.SOPK, SOPK_OPCODES);
+        counters(SOPP, other.SOPP, SOPP_OPCODES);
+        counters(SMEM, other.SMEM, SMEM_OPCODES);
+        counters(VOP1, other.VOP1, VOP1_OPCODES);
+        counters(VOP2, other.VOP2, VOP2_OPCODES);
+        counters(&folded, &other.folded, 1);
+        counters(fused, other.fused, Fused::COUNT);
+        instructions += other.instructions;
+
+        if (sites.size() < other.sites.size())
+        {
+            sites.resize(other.sites.size());
+            blocks.resize(other.blocks.size());
+        }
+        for (size_t i = 0; i < other.sites.size(); ++i)
+        {
+            if (other.sites[i].count != 0)
+            {
+                sites[i].count  += other.sites[i].count;
+                sites[i].format  = other.sites[i].format;
+                sites[i].OP      = other.sites[i].OP;
+            }
+            blocks[i].entries      += other.blocks[i].entries;
+            blocks[i].instructions += other.blocks[i].instructions;
+        }
+    }
+
+    void Profiler::report(std::FILE* out, size_t top) const
+    {
+        struct Line
+        {
+            const char*    name;
+            const Counter* counter;
+        };
+        std::vector<Line> lines;
+        uint64_t          ticks = 0;
+        const auto collect = [&](Format format, const Counter* counters, size_t n)
+        {
+            for (size_t op = 0; op < n; ++op)
+            {
+                if (counters[op].count == 0) continue;
+                lines.push_back({ name_of(format, static_cast<uint8_t>(op)), &counters[op] });
+                ticks += counters[op].ticks;
+            }
+        };
+        collect(Format::SOP1, SOP1, SOP1_OPCODES);
+        collect(Format::SOP2, SOP2, SOP2_OPCODES);
+        collect(Format::SOPC, SOPC, SOPC_OPCODES);
+        collect(Format::SOPK, SOPK, SOPK_OPCODES);
+        collect(Format::SOPP, SOPP, SOPP_OPCODES);
+        collect(Format::SMEM, SMEM, SMEM_OPCODES);
+        collect(Format::VOP1, VOP1, VOP1_OPCODES);
+        collect(Format::VOP2, VOP2, VOP2_OPCODES);
+        collect(Format::FOLDED, &folded, 1);
+        collect(Format::FUSED, fused, Fused::COUNT);
+        std::sort(lines.begin(), lines.end(), [](const Line& a, const Line& b) { return a.counter->count > b.counter->count; });
+
+        std::fprintf(out, "%llu instructions\n", static_cast<unsigned long long>(instructions));
+        for (const Line& line : lines)
+        {
+            const Counter& c = *line.counter;
+            std::fprintf(out, "  %-22s %14llu %6.1f%%", line.name, static_cast<unsigned long long>(c.count), percent(c.count, instructions));
+            if (ticks != 0)
+            {
+                std::fprintf(out, " %16llu ticks %6.1f%% %9.1f per exec", static_cast<unsigned long long>(c.ticks), percent(c.ticks, ticks),
+                             static_cast<double>(c.ticks) / static_cast<double>(c.count));
+            }
+            std::fputc('\n', out);
+        }
+
+        std::vector<uint32_t> order;
+        for (uint32_t i = 0; i < blocks.size(); ++i)
+        {
+            if (blocks[i].entries != 0) order.push_back(i);
+        }
+        const size_t shown_blocks = std::min(top, order.size());
+        std::partial_sort(order.begin(), order.begin() + shown_blocks, order.end(),
+                          [&](uint32_t a, uint32_t b) { return blocks[a].instructions > blocks[b].instructions; });
+        std::fprintf(out, "hottest of %zu blocks (PC, entries, instructions)\n", order.size());
+        for (size_t i = 0; i < shown_blocks; ++i)
+        {
+            const Block& b = blocks[order[i]];
+            std::fprintf(out, "  %06x   %14llu %16llu %6.1f%%\n", order[i] * 4,
+                         static_cast<unsigned long long>(b.entries), static_cast<unsigned long long>(b.instructions),
+                         percent(b.instructions, instructions));
+        }
+
+        order.clear();
+        for (uint32_t i = 0; i < sites.size(); ++i)
+        {
+            if (sites[i].count != 0) order.push_back(i);
+        }
+        const size_t shown_sites = std::min(top, order.size());
+        std::partial_sort(order.begin(), order.begin() + shown_sites, order.end(),
+                          [&](uint32_t a, uint32_t b) { return sites[a].count > sites[b].count; });
+        std::fprintf(out, "hottest of %zu PCs\n", order.size());
+        for (size_t i = 0; i < shown_sites; ++i)
+        {
+            const Site& s = sites[order[i]];
+            std::fprintf(out, "  %06x   %-22s %14llu %6.1f%%\n", order[i] * 4, name_of(static_cast<Format>(s.format), s.OP),
+                         static_cast<unsigned long long>(s.count), percent(s.count, instructions));
+        }
+    }
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "fuse.hpp"
+#include "wavefront.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>
+#define VEGA_PROFILE_RDTSC 1
+#else
+#define VEGA_PROFILE_RDTSC 0
+#endif
+
+// Execution counts per opcode, per PC and per basic block, optionally with host time per
+// handler:
+//
+//     Profiler profile;
+//     profile.host_time = true;           // sample the TSC around every handler
+//     wave.run(program, profile);         // or wave.run(translation, profile)
+//     profile.report(stdout);
+//
+// One Profiler per host thread; merge() the per-thread ones when they are done (Dispatcher
+// does this for its workers). A basic block here is a straight-line run entered from
+// anything other than the instruction before it, and is counted under its first PC.
+namespace vega
+{
+    struct Profiler
+    {
+        struct Counter
+        {
+            uint64_t count = 0;
+            uint64_t ticks = 0; // host TSC ticks (nanoseconds without a TSC) inside handlers
+        };
+
+        struct Site
+        {
+            uint64_t count  = 0;
+            uint8_t  format = 0; // Format of the last instruction seen at this PC
+            uint8_t  OP     = 0;
+        };
+
+        struct Block
+        {
+            uint64_t entries      = 0;
+            uint64_t instructions = 0;
+        };
+
+        bool host_time = false;
+
+        uint64_t instructions = 0;
+
+        Counter SOP1[SOP1_OPCODES];
+        Counter SOP2[SOP2_OPCODES];
+        Counter SOPC[SOPC_OPCODES];
+        Counter SOPK[SOPK_OPCODES];
+        Counter SOPP[SOPP_OPCODES];
+        Counter SMEM[SMEM_OPCODES];
+        Counter VOP1[VOP1_OPCODES];
+        Counter VOP2[VOP2_OPCODES];
+        Counter folded; // µops replaced by fold_constants()
+        Counter fused[Fused::COUNT]; // pairs merged by fuse_pairs(), counted once
+
+        std::vector<Site>  sites;  // by PC / 4
+        std::vector<Block> blocks; // by the block's first PC / 4
+
+        // Run-loop state
+        uint32_t next_pc  = UINT32_MAX; // fall-through PC of the previous instruction
+        uint32_t next_alt = UINT32_MAX; // the other candidate after a folded µop
+        uint32_t block    = 0;          // current block's first PC / 4
+        uint64_t started  = 0;
+        Counter* current  = nullptr;
+
+        static uint64_t now()
+        {
+        #if VEGA_PROFILE_RDTSC
+            return __rdtsc();
+        #else
+            return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        #endif
+        }
+
+        Counter& counter(const Instruction& inst)
+        {
+            switch (inst.format)
+            {
+                case Format::SOP1: return SOP1[inst.OP];
+                case Format::SOP2: return SOP2[inst.OP];
+                case Format::SOPC: return SOPC[inst.OP];
+                case Format::SOPK: return SOPK[inst.OP];
+                case Format::SOPP: return SOPP[inst.OP];
+                case Format::SMEM: return SMEM[inst.OP];
+                case Format::FUSED: return fused[inst.OP];
+                case Format::VOP1: return VOP1[inst.OP];
+                case Format::VOP2: return VOP2[inst.OP];
+                default:           return folded;
+            }
+        }
+
+        void issue(const Wavefront&, uint32_t PC, const Instruction& inst, uint32_t)
+        {
+            const uint32_t index = PC / sizeof(uint32_t);
+            if (index >= sites.size())
+            {
+                sites.resize(index + 1);
+                blocks.resize(index + 1);
+            }
+
+            if (PC != next_pc && PC != next_alt)
+            {
+                block = index;
+                ++blocks[index].entries;
+            }
+            ++blocks[block].instructions;
+            // A folded or fused µop no longer says whether it had a literal, so either size falls through.
+            if (inst.format == Format::FUSED)
+            {
+                next_pc  = PC + 8;
+                next_alt = PC + 12;
+            }
+            else
+            {
+                next_pc  = PC + (has_literal(inst) ? 8 : 4);
+                next_alt = inst.format == Format::FOLDED ? PC + 8 : next_pc;
+            }
+
+            Site& site  = sites[index];
+            site.format = static_cast<uint8_t>(inst.format);
+            site.OP     = inst.OP;
+            ++site.count;
+
+            current = &counter(inst);
+            ++current->count;
+            ++instructions;
+            if (host_time) started = now();
+        }
+
+        void retire(const Wavefront&, const Instruction&)
+        {
+            if (host_time) current->ticks += now() - started;
+        }
+
+        // Adds `other`'s counts; run-loop state is left as it was.
+        void merge(const Profiler& other);
+
+        // Opcode mix, then the `top` hottest blocks and PCs, most executed first.
+        void report(std::FILE* out, size_t top = 16) const;
+
+        void reset()
+        {
+            const bool timed = host_time;
+            *this     = Profiler{};
+            host_time = timed;
+        }
+    };
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "decoder.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Name -> instruction tables, built by the compiler from SOP1::ALL / SOP2::ALL. They are
+// constant-initialised: no constructors run at startup and nothing is allocated. Names are
+// found through a perfect hash picked at compile time (one hash, one probe, one compare);
+// opcode lookup is SOP1_TABLE / SOP2_TABLE in decoder.hpp.
+namespace vega
+{
+    template<typename Handler>
+    struct RegistryEntry
+    {
+        std::string_view name;
+        uint8_t          opcode = 0;
+        Handler          run    = nullptr;
+    };
+
+    using SOP1_Entry = RegistryEntry<SOP1_Handler>;
+    using SOP2_Entry = RegistryEntry<SOP2_Handler>;
+
+    constexpr uint32_t name_hash(std::string_view name, uint32_t seed)
+    {
+        uint32_t h = 0x811C9DC5u ^ seed; // FNV-1a
+        for (char c : name)
+        {
+            h = (h ^ static_cast<uint8_t>(c)) * 0x01000193u;
+        }
+        return h ^ (h >> 16);
+    }
+
+    template<typename Entry, size_t N>
+    struct Registry
+    {
+        static constexpr size_t SLOTS = std::bit_ceil(N * 4);
+
+        std::array<Entry, N>       entries{};
+        std::array<uint8_t, SLOTS> slots{}; // entry index + 1, 0 = empty
+        uint32_t                   seed = 0;
+
+        // nullptr for an unknown name.
+        constexpr const Entry* find(std::string_view name) const
+        {
+            const uint8_t slot = slots[name_hash(name, seed) & (SLOTS - 1)];
+            if (slot == 0) return nullptr;
+            const Entry& e = entries[slot - 1];
+            return e.name == name ? &e : nullptr;
+        }
+
+        // First seed under which every name lands in its own slot.
+        constexpr void build()
+        {
+            for (seed = 0;; ++seed)
+            {
+                slots = {};
+                bool collision = false;
+                for (size_t i = 0; i < N && !collision; ++i)
+                {
+                    uint8_t& slot = slots[name_hash(entries[i].name, seed) & (SLOTS - 1)];
+                    collision = slot != 0;
+                    slot = static_cast<uint8_t>(i + 1);
+                }
+                if (!collision) return;
+            }
+        }
+    };
+
+    // Any entry type with a `name` member.
+    template<typename Entry, size_t N>
+    constexpr Registry<Entry, N> make_registry(const std::array<Entry, N>& entries)
+    {
+        static_assert(N < 255, "slots hold an entry index + 1 in a uint8_t");
+        Registry<Entry, N> registry{ entries };
+        registry.build();
+        return registry;
+    }
+
+    template<typename... Ts>
+    constexpr auto make_sop1_registry(InstructionList<Ts...>)
+    {
+        return make_registry(std::array<SOP1_Entry, sizeof...(Ts)>{ SOP1_Entry{ Ts::NAME, Ts::ID, &call_execute_sop1<Ts> }... });
+    }
+
+    template<typename... Ts>
+    constexpr auto make_sop2_registry(InstructionList<Ts...>)
+    {
+        return make_registry(std::array<SOP2_Entry, sizeof...(Ts)>{ SOP2_Entry{ Ts::NAME, Ts::ID, &call_execute_sop2<Ts> }... });
+    }
+
+    inline constexpr auto SOP1_REGISTRY = make_sop1_registry(SOP1::ALL{});
+    inline constexpr auto SOP2_REGISTRY = make_sop2_registry(SOP2::ALL{});
+
+    constexpr const SOP1_Entry* find_sop1(std::string_view name) { return SOP1_REGISTRY.find(name); }
+    constexpr const SOP2_Entry* find_sop2(std::string_view name) { return SOP2_REGISTRY.find(name); }
+
+    // Every struct is reachable by its NAME (so names are also unique).
+    template<auto Find, typename... Ts>
+    constexpr bool registry_complete(InstructionList<Ts...>)
+    {
+        return ((Find(Ts::NAME) != nullptr && Find(Ts::NAME)->opcode == Ts::ID) && ...);
+    }
+    static_assert(registry_complete<find_sop1>(SOP1::ALL{}));
+    static_assert(registry_complete<find_sop2>(SOP2::ALL{}));
+    static_assert(find_sop1("S_MOV_B33") == nullptr && find_sop2("") == nullptr);
+}
@@ -0,0 +1,106 @@
+#include "wavefront.hpp"
+#include <array>
+#include <utility>
+
+namespace vega
+{
+    namespace
+    {
+        constexpr size_t PAIRS = SOURCE_KINDS * SOURCE_KINDS;
+
+        // One opcode's handlers, [SCC_LIVE][kind of SSRC0] or [SCC_LIVE][SSRC0 kind * 4 + SSRC1 kind].
+        template<size_t N>
+        struct Specialised
+        {
+            bool                                      wide0 = false; // 64-bit sources, for source_kind()
+            bool                                      wide1 = false;
+            std::array<std::array<WaveHandler, N>, 2> fn    = {};
+        };
+
+        template<typename T, bool SCC_LIVE, size_t... I>
+        constexpr std::array<WaveHandler, SOURCE_KINDS> sop1_row(std::index_sequence<I...>)
+        {
+            return { &execute_sop1<T, SCC_LIVE, static_cast<Source>(I)>... };
+        }
+
+        template<typename T, bool SCC_LIVE, size_t... I>
+        constexpr std::array<WaveHandler, PAIRS> sop2_row(std::index_sequence<I...>)
+        {
+            return { &execute_sop2<T, SCC_LIVE, static_cast<Source>(I / SOURCE_KINDS), static_cast<Source>(I % SOURCE_KINDS)>... };
+        }
+
+        template<typename T, bool SCC_LIVE, size_t... I>
+        constexpr std::array<WaveHandler, PAIRS> sopc_row(std::index_sequence<I...>)
+        {
+            return { &execute_sopc<T, SCC_LIVE, static_cast<Source>(I / SOURCE_KINDS), static_cast<Source>(I % SOURCE_KINDS)>... };
+        }
+
+        template<typename T, size_t N>
+        constexpr bool WIDE = sizeof(typename Execute<T>::template Arg<N>) == 8;
+
+        template<typename... Ts>
+        constexpr std::array<Specialised<SOURCE_KINDS>, SOP1_OPCODES> make_sop1(InstructionList<Ts...>)
+        {
+            std::array<Specialised<SOURCE_KINDS>, SOP1_OPCODES> table{};
+            constexpr auto I = std::make_index_sequence<SOURCE_KINDS>{};
+            ((table[Ts::ID] = { WIDE<Ts, 0>, false, { sop1_row<Ts, false>(I), sop1_row<Ts, true>(I) } }), ...);
+            return table;
+        }
+
+        template<typename... Ts>
+        constexpr std::array<Specialised<PAIRS>, SOP2_OPCODES> make_sop2(InstructionList<Ts...>)
+        {
+            std::array<Specialised<PAIRS>, SOP2_OPCODES> table{};
+            constexpr auto I = std::make_index_sequence<PAIRS>{};
+            ((table[Ts::ID] = { WIDE<Ts, 0>, WIDE<Ts, 1>, { sop2_row<Ts, false>(I), sop2_row<Ts, true>(I) } }), ...);
+            return table;
+        }
+
+        template<typename... Ts>
+        constexpr std::array<Specialised<PAIRS>, SOPC_OPCODES> make_sopc(InstructionList<Ts...>)
+        {
+            std::array<Specialised<PAIRS>, SOPC_OPCODES> table{};
+            constexpr auto I = std::make_index_sequence<PAIRS>{};
+            ((table[Ts::ID] = { WIDE<Ts, 0>, WIDE<Ts, 1>, { sopc_row<Ts, false>(I), sopc_row<Ts, true>(I) } }), ...);
+            return table;
+        }
+
+        constexpr auto SOP1_SPECIALISED = make_sop1(SOP1::ALL{});
+        constexpr auto SOP2_SPECIALISED = make_sop2(SOP2::ALL{});
+        constexpr auto SOPC_SPECIALISED = make_sopc(SOPC::ALL{});
+
+        template<size_t N>
+        SourceKinds kinds(const Specialised<N>& s, const Instruction& inst)
+        {
+            return { source_kind(inst.SSRC0, s.wide0), source_kind(inst.SSRC1, s.wide1) };
+        }
+
+        WaveHandler pick(const Specialised<PAIRS>& s, const Instruction& inst, bool scc_live)
+        {
+            const SourceKinds k = kinds(s, inst);
+            return s.fn[scc_live][static_cast<size_t>(k.S0) * SOURCE_KINDS + static_cast<size_t>(k.S1)];
+        }
+    }
+
+    WaveHandler salu_handler(const Instruction& inst, bool scc_live)
+    {
+        switch (inst.format)
+        {
+            case Format::SOP1: return SOP1_SPECIALISED[inst.OP].fn[scc_live][static_cast<size_t>(source_kinds(inst).S0)];
+            case Format::SOP2: return pick(SOP2_SPECIALISED[inst.OP], inst, scc_live);
+            case Format::SOPC: return pick(SOPC_SPECIALISED[inst.OP], inst, scc_live);
+            default:           return wave_handler(inst);
+        }
+    }
+
+    SourceKinds source_kinds(const Instruction& inst)
+    {
+        switch (inst.format)
+        {
+            case Format::SOP1: return { source_kind(inst.SSRC0, SOP1_SPECIALISED[inst.OP].wide0), Source::SPECIAL };
+            case Format::SOP2: return kinds(SOP2_SPECIALISED[inst.OP], inst);
+            case Format::SOPC: return kinds(SOPC_SPECIALISED[inst.OP], inst);
+            default:           return {};
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "wavefront.hpp"
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+// Assembly syntax shared by the assembler and the disassembler: operand widths come from
+// each struct's execute() signature, register names from the SSRC/SDST encodings.
+namespace vega::syntax
+{
+    struct Mnemonic
+    {
+        std::string_view name;
+        uint32_t         hex      = 0;
+        Format           format   = Format::UNKNOWN;
+        uint8_t          D_bytes  = 0;
+        uint8_t          S0_bytes = 0;
+        uint8_t          S1_bytes = 0; // 0 for SOP1
+    };
+
+    // SOPK and SOPP take a 16-bit immediate where the others take S0.
+    inline constexpr uint8_t SIMM16_BYTES = 2;
+
+    template<typename T>
+    constexpr Mnemonic sop1()
+    {
+        using E = Execute<T>;
+        return { T::NAME, T::hex(), Format::SOP1,
+                 sizeof(std::remove_reference_t<typename E::template Arg<1>>),
+                 sizeof(typename E::template Arg<0>), 0 };
+    }
+
+    template<typename T>
+    constexpr Mnemonic sop2()
+    {
+        using E = Execute<T>;
+        return { T::NAME, T::hex(), Format::SOP2,
+                 sizeof(std::remove_reference_t<typename E::template Arg<2>>),
+                 sizeof(typename E::template Arg<0>),
+                 sizeof(typename E::template Arg<1>) };
+    }
+
+    // SOPC writes only SCC, so D_bytes is 0.
+    template<typename T>
+    constexpr Mnemonic sopc()
+    {
+        using E = Execute<T>;
+        return { T::NAME, T::hex(), Format::SOPC, 0,
+                 sizeof(typename E::template Arg<0>),
+                 sizeof(typename E::template Arg<1>) };
+    }
+
+    template<typename T>
+    constexpr Mnemonic sopk()
+    {
+        return { T::NAME, T::hex(), Format::SOPK, 4, SIMM16_BYTES, 0 };
+    }
+
+    // S_ENDPGM is written without its (always zero) immediate.
+    template<typename T>
+    constexpr Mnemonic sopp()
+    {
+        return { T::NAME, T::hex(), Format::SOPP, 0, static_cast<uint8_t>(T::ID == SOPP::S_ENDPGM::ID ? 0 : SIMM16_BYTES), 0 };
+    }
+
+    // SMEM: D_bytes covers all of SDATA, S0_bytes the base pair or the buffer descriptor's four
+    // SGPRs, S1_bytes the offset.
+    template<typename T>
+    constexpr Mnemonic smem()
+    {
+        return { T::NAME, T::hex(), Format::SMEM, static_cast<uint8_t>(T::DWORDS * 4), static_cast<uint8_t>(T::BUFFER ? 16 : 8), 4 };
+    }
+
+    struct Named
+    {
+        std::string_view name;
+        uint8_t          code;
+        uint8_t          bytes; // 0: any width, source only
+    };
+
+    // The 64-bit spelling comes first, so a search by code and width finds it for pairs.
+    inline constexpr Named NAMED[] = {
+        { "vcc", Operand::VCC_LO, 8 },   { "vcc_lo", Operand::VCC_LO, 4 },   { "vcc_hi", Operand::VCC_HI, 4 },
+        { "exec", Operand::EXEC_LO, 8 }, { "exec_lo", Operand::EXEC_LO, 4 }, { "exec_hi", Operand::EXEC_HI, 4 },
+        { "m0", Operand::M0, 4 },        { "vccz", Operand::VCCZ, 0 },       { "execz", Operand::EXECZ, 0 },
+        { "scc", Operand::SCC, 0 },
+    };
+
+    // Same order as the FLOAT_FIRST.. encodings; the last one is 1/(2*pi).
+    inline constexpr double           INLINE_FLOATS[]     = { 0.5, -0.5, 1.0, -1.0, 2.0, -2.0, 4.0, -4.0, 0.15915494309189535 };
+    inline constexpr std::string_view INLINE_FLOAT_TEXT[] = { "0.5", "-0.5", "1.0", "-1.0", "2.0", "-2.0", "4.0", "-4.0", "0.15915494309189535" };
+}
@@ -0,0 +1,224 @@
+#include "threaded.hpp"
+
+#define VEGA_THREADED_SOP1(X) \
+    X(SOP1, S_MOV_B32) X(SOP1, S_MOV_B64) X(SOP1, S_CMOV_B32) X(SOP1, S_CMOV_B64) \
+    X(SOP1, S_NOT_B32) X(SOP1, S_NOT_B64) X(SOP1, S_WQM_B32) X(SOP1, S_WQM_B64) \
+    X(SOP1, S_BREV_B32) X(SOP1, S_BREV_B64) \
+    X(SOP1, S_BCNT0_I32_B32) X(SOP1, S_BCNT0_I32_B64) X(SOP1, S_BCNT1_I32_B32) X(SOP1, S_BCNT1_I32_B64) \
+    X(SOP1, S_FF0_I32_B32) X(SOP1, S_FF0_I32_B64) X(SOP1, S_FF1_I32_B32) X(SOP1, S_FF1_I32_B64) \
+    X(SOP1, S_FLBIT_I32_B32) X(SOP1, S_FLBIT_I32_B64)
+
+#define VEGA_THREADED_SOP2(X) \
+    X(SOP2, S_ADD_U32) X(SOP2, S_SUB_U32) X(SOP2, S_ADD_I32) X(SOP2, S_SUB_I32) \
+    X(SOP2, S_ADDC_U32) X(SOP2, S_SUBB_U32) X(SOP2, S_MIN_I32) X(SOP2, S_MIN_U32) \
+    X(SOP2, S_MAX_I32) X(SOP2, S_MAX_U32) X(SOP2, S_CSELECT_B32) X(SOP2, S_CSELECT_B64) \
+    X(SOP2, S_AND_B32) X(SOP2, S_AND_B64) X(SOP2, S_OR_B32) X(SOP2, S_OR_B64) \
+    X(SOP2, S_XOR_B32) X(SOP2, S_XOR_B64) X(SOP2, S_ANDN2_B32) X(SOP2, S_ANDN2_B64) \
+    X(SOP2, S_ORN2_B32) X(SOP2, S_ORN2_B64) X(SOP2, S_NAND_B32) X(SOP2, S_NAND_B64) \
+    X(SOP2, S_NOR_B32) X(SOP2, S_NOR_B64) X(SOP2, S_XNOR_B32) X(SOP2, S_XNOR_B64) \
+    X(SOP2, S_LSHL_B32) X(SOP2, S_LSHL_B64) X(SOP2, S_LSHR_B32) X(SOP2, S_LSHR_B64)
+
+#define VEGA_THREADED_ALL(X) VEGA_THREADED_SOP1(X) VEGA_THREADED_SOP2(X)
+
+// One opcode's labels in ThreadedIndex order, Y(FMT, NAME, S0 kind, S1 kind, SCC_LIVE): the
+// S0 kind, then the S1 kind, then SCC live before MicroOp::scc_dead. SOP1 has no S1 and
+// passes SGPR there.
+#define VEGA_SCC_VARIANTS(Y, FMT, NAME, K0, K1) Y(FMT, NAME, K0, K1, true) Y(FMT, NAME, K0, K1, false)
+#define VEGA_S1_VARIANTS(Y, FMT, NAME, K0) \
+    VEGA_SCC_VARIANTS(Y, FMT, NAME, K0, SGPR) VEGA_SCC_VARIANTS(Y, FMT, NAME, K0, INLINE) \
+    VEGA_SCC_VARIANTS(Y, FMT, NAME, K0, LITERAL) VEGA_SCC_VARIANTS(Y, FMT, NAME, K0, SPECIAL)
+#define VEGA_VARIANTS_SOP1(Y, NAME) \
+    VEGA_SCC_VARIANTS(Y, SOP1, NAME, SGPR, SGPR) VEGA_SCC_VARIANTS(Y, SOP1, NAME, INLINE, SGPR) \
+    VEGA_SCC_VARIANTS(Y, SOP1, NAME, LITERAL, SGPR) VEGA_SCC_VARIANTS(Y, SOP1, NAME, SPECIAL, SGPR)
+#define VEGA_VARIANTS_SOP2(Y, NAME) \
+    VEGA_S1_VARIANTS(Y, SOP2, NAME, SGPR) VEGA_S1_VARIANTS(Y, SOP2, NAME, INLINE) \
+    VEGA_S1_VARIANTS(Y, SOP2, NAME, LITERAL) VEGA_S1_VARIANTS(Y, SOP2, NAME, SPECIAL)
+
+#define EXECUTE_SOP1(NAME, LIVE, K0, K1) execute_sop1<SOP1::NAME, LIVE, Source::K0>
+#define EXECUTE_SOP2(NAME, LIVE, K0, K1) execute_sop2<SOP2::NAME, LIVE, Source::K0, Source::K1>
+#define VARIANT_LABEL(FMT, NAME, K0, K1, LIVE) L_##FMT##_##NAME##_##K0##_##K1##_##LIVE
+
+namespace vega
+{
+    namespace
+    {
+        // Offset of a handler variant from its opcode's first ThreadedIndex.
+        constexpr uint16_t SOP1_variant(Source S0, Source, bool scc_live)
+        {
+            return static_cast<uint16_t>(static_cast<int>(S0) * 2 + !scc_live);
+        }
+
+        constexpr uint16_t SOP2_variant(Source S0, Source S1, bool scc_live)
+        {
+            return static_cast<uint16_t>((static_cast<int>(S0) * SOURCE_KINDS + static_cast<int>(S1)) * 2 + !scc_live);
+        }
+
+        constexpr uint16_t SOP1_VARIANTS = SOURCE_KINDS * 2;
+        constexpr uint16_t SOP2_VARIANTS = SOURCE_KINDS * SOURCE_KINDS * 2;
+        static_assert(static_cast<int>(Source::SGPR) == 0 && static_cast<int>(Source::INLINE) == 1
+                      && static_cast<int>(Source::LITERAL) == 2 && static_cast<int>(Source::SPECIAL) == 3,
+                      "VEGA_S1_VARIANTS and VEGA_VARIANTS_* list the kinds in Source order");
+
+        enum ThreadedIndex : uint16_t
+        {
+            T_EXIT,
+            T_CALL,   // any other format: through MicroOp::fn
+            T_BRANCH, // is_control() ops: through MicroOp::fn, then on to ThreadedOp::jump
+            // Each opcode takes FMT_VARIANTS indices, one per source kinds and scc_dead.
+        #define X(FMT, NAME) T_##FMT##_##NAME, T_##FMT##_##NAME##_LAST = T_##FMT##_##NAME + FMT##_VARIANTS - 1,
+            VEGA_THREADED_ALL(X)
+        #undef X
+            T_COUNT
+        };
+
+        #define X(FMT, NAME) + 1
+        static_assert(0 VEGA_THREADED_SOP1(X) == SOP1::ALL::SIZE, "VEGA_THREADED_SOP1 is out of sync with SOP1::ALL");
+        static_assert(0 VEGA_THREADED_SOP2(X) == SOP2::ALL::SIZE, "VEGA_THREADED_SOP2 is out of sync with SOP2::ALL");
+        #undef X
+
+        struct IndexTables
+        {
+            uint16_t SOP1[SOP1_OPCODES] = {};
+            uint16_t SOP2[SOP2_OPCODES] = {};
+        };
+
+        constexpr IndexTables make_index_tables()
+        {
+            IndexTables t;
+        #define X(FMT, NAME) t.FMT[FMT::NAME::ID] = T_##FMT##_##NAME;
+            VEGA_THREADED_ALL(X)
+        #undef X
+            return t;
+        }
+
+        constexpr IndexTables INDEX = make_index_tables();
+
+        // With labels_out set, only publishes the label table (indexed by ThreadedIndex).
+        // Otherwise returns true at the exit op, false after a branch that left the code.
+        [[gnu::flatten]] bool interpret(Wavefront* wave, const ThreadedOp* op, const void* const** labels_out)
+        {
+        #if VEGA_COMPUTED_GOTO
+            static const void* const LABELS[T_COUNT] = {
+                &&L_T_EXIT,
+                &&L_T_CALL,
+                &&L_T_BRANCH,
+            #define Y(FMT, NAME, K0, K1, LIVE) &&VARIANT_LABEL(FMT, NAME, K0, K1, LIVE),
+            #define X(FMT, NAME) VEGA_VARIANTS_##FMT(Y, NAME)
+                VEGA_THREADED_ALL(X)
+            #undef X
+            #undef Y
+            };
+            if (labels_out != nullptr)
+            {
+                *labels_out = LABELS;
+                return true;
+            }
+
+            #define DISPATCH() goto *(++op)->target
+            goto *op->target;
+
+        #define Y(FMT, NAME, K0, K1, LIVE) \
+            VARIANT_LABEL(FMT, NAME, K0, K1, LIVE): \
+                EXECUTE_##FMT(NAME, LIVE, K0, K1)(*wave, op->inst, op->literal); \
+                DISPATCH();
+        #define X(FMT, NAME) VEGA_VARIANTS_##FMT(Y, NAME)
+            VEGA_THREADED_ALL(X)
+        #undef X
+        #undef Y
+
+            L_T_CALL:
+                op->fn(*wave, op->inst, op->literal);
+                DISPATCH();
+
+            L_T_BRANCH:
+                wave->PC = op->PC + 4;
+                op->fn(*wave, op->inst, op->literal);
+                if (wave->PC == op->PC + 4) DISPATCH();
+                if (op->jump == nullptr) return false;
+                op = op->jump;
+                goto *op->target;
+
+            L_T_EXIT:
+                return true;
+            #undef DISPATCH
+        #else
+            if (labels_out != nullptr)
+            {
+                *labels_out = nullptr;
+                return true;
+            }
+            for (;;)
+            {
+                switch (op->index)
+                {
+                #define Y(FMT, NAME, K0, K1, LIVE) \
+                    case T_##FMT##_##NAME + FMT##_variant(Source::K0, Source::K1, LIVE): \
+                        EXECUTE_##FMT(NAME, LIVE, K0, K1)(*wave, op->inst, op->literal); ++op; break;
+                #define X(FMT, NAME) VEGA_VARIANTS_##FMT(Y, NAME)
+                    VEGA_THREADED_ALL(X)
+                #undef X
+                #undef Y
+                    case T_CALL: op->fn(*wave, op->inst, op->literal); ++op; break;
+                    case T_BRANCH:
+                        wave->PC = op->PC + 4;
+                        op->fn(*wave, op->inst, op->literal);
+                        if (wave->PC == op->PC + 4) ++op;
+                        else if (op->jump == nullptr) return false;
+                        else op = op->jump;
+                        break;
+                    default:
+                        return true;
+                }
+            }
+        #endif
+        }
+    }
+
+    ThreadedCode thread_code(const Translation& translation)
+    {
+        const void* const* labels = nullptr;
+        interpret(nullptr, nullptr, &labels);
+
+        ThreadedCode out;
+        out.ops.reserve(translation.ops.size() + 1);
+        for (const MicroOp& uop : translation.ops)
+        {
+            ThreadedOp        op;
+            const SourceKinds k = source_kinds(uop.inst);
+            switch (uop.inst.format)
+            {
+                case Format::SOP1: op.index = INDEX.SOP1[uop.inst.OP] + SOP1_variant(k.S0, k.S1, !uop.scc_dead); break;
+                case Format::SOP2: op.index = INDEX.SOP2[uop.inst.OP] + SOP2_variant(k.S0, k.S1, !uop.scc_dead); break;
+                default:           op.index = is_control(uop.inst) ? T_BRANCH : T_CALL; break;
+            }
+            op.fn      = uop.fn;
+            op.target  = labels != nullptr ? labels[op.index] : nullptr;
+            op.inst    = uop.inst;
+            op.literal = uop.literal;
+            op.PC      = uop.PC;
+            out.ops.push_back(op);
+        }
+        for (size_t i = 0; i < translation.ops.size(); ++i)
+        {
+            const uint32_t target = translation.ops[i].target;
+            if (out.ops[i].index == T_BRANCH && target != Translation::LEAVE) out.ops[i].jump = &out.ops[target];
+        }
+        ThreadedOp exit;
+        exit.target = labels != nullptr ? labels[T_EXIT] : nullptr;
+        out.ops.push_back(exit);
+        out.exit    = translation.exit;
+        out.exit_pc = translation.exit_pc;
+        out.end     = translation.end;
+        return out;
+    }
+
+    Wavefront::Status run_threaded(Wavefront& wave, const ThreadedCode& code)
+    {
+        if (!interpret(&wave, code.ops.data(), nullptr))
+        {
+            return wave.PC < code.end ? Wavefront::Status::ILLEGAL : Wavefront::Status::ENDED;
+        }
+        wave.PC = code.exit_pc;
+        return code.exit;
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "uop_cache.hpp"
+#include <cstdint>
+#include <vector>
+
+// VEGA_THREADED_DISPATCH=1 selects labels-as-values (GCC/Clang) in run_threaded();
+// otherwise, or on other compilers, the same loop is a switch over a dense index. SOP1 and
+// SOP2 ops have a label per opcode, kind of each source (source_kinds()) and scc_dead, so
+// the inlined handler fetches its operands without branching, as salu_handler() does.
+#if !defined(VEGA_THREADED_DISPATCH)
+#define VEGA_THREADED_DISPATCH 0
+#endif
+
+#if VEGA_THREADED_DISPATCH && (defined(__GNUC__) || defined(__clang__))
+#define VEGA_COMPUTED_GOTO 1
+#else
+#define VEGA_COMPUTED_GOTO 0
+#endif
+
+namespace vega
+{
+    struct ThreadedOp
+    {
+        const void*       target  = nullptr; // label address, only used with VEGA_COMPUTED_GOTO
+        uint16_t          index   = 0;       // dense handler index, 0 is the exit op; folds in the source kinds
+        WaveHandler       fn      = nullptr; // formats without an inlined label
+        Instruction       inst    = {};
+        uint32_t          literal = 0;
+        uint32_t          PC      = 0;       // control ops only
+        const ThreadedOp* jump    = nullptr; // control ops: taken branch, nullptr leaves the code
+    };
+
+    struct ThreadedCode
+    {
+        std::vector<ThreadedOp> ops; // always terminated by an exit op
+        Wavefront::Status       exit    = Wavefront::Status::ENDED;
+        uint32_t                exit_pc = 0;
+        uint32_t                end     = 0; // program size in bytes, as Translation::end
+    };
+
+    ThreadedCode thread_code(const Translation& translation);
+
+    Wavefront::Status run_threaded(Wavefront& wave, const ThreadedCode& code);
+}
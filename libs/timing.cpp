@@ -0,0 +1,251 @@
+#include "timing.hpp"
+#include "evaluate.hpp"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace vega
+{
+    namespace
+    {
+        struct OpTiming
+        {
+            const char* name       = nullptr; // nullptr: no instruction with this opcode
+            uint8_t     latency    = 0;
+            uint8_t     S0_bytes   = 0;
+            uint8_t     S1_bytes   = 0;       // 0 for SOP1/VOP1
+            uint8_t     D_bytes    = 0;       // 0: no register result (SOPC, SOPP, S_CMPK)
+            bool        reads_scc  = false;   // also reads the old D (S_CMOV)
+            bool        writes_scc = false;
+            bool        reads_vcc  = false;   // V_CNDMASK_B32, S_CBRANCH_VCCZ/VCCNZ
+            bool        reads_exec = false;   // S_CBRANCH_EXECZ/EXECNZ; VALU ops always do
+        };
+
+        template<typename T>
+        constexpr OpTiming sop1_timing()
+        {
+            using E = Execute<T>;
+            return { T::NAME, static_cast<uint8_t>(T::LATENCY),
+                     sizeof(typename E::template Arg<0>), 0,
+                     sizeof(std::remove_reference_t<typename E::template Arg<1>>),
+                     sop1_reads_scc<T>(), WRITES_SCC<T>, false };
+        }
+
+        template<typename T>
+        constexpr OpTiming sop2_timing()
+        {
+            using E = Execute<T>;
+            return { T::NAME, static_cast<uint8_t>(T::LATENCY),
+                     sizeof(typename E::template Arg<0>), sizeof(typename E::template Arg<1>),
+                     sizeof(std::remove_reference_t<typename E::template Arg<2>>),
+                     sop2_reads_scc<T>(), WRITES_SCC<T>, false };
+        }
+
+        template<typename T>
+        constexpr OpTiming sopc_timing()
+        {
+            using E = Execute<T>;
+            return { T::NAME, static_cast<uint8_t>(T::LATENCY),
+                     sizeof(typename E::template Arg<0>), sizeof(typename E::template Arg<1>), 0,
+                     false, true, false };
+        }
+
+        // S0_bytes stands for the old SDST, which every SOPK but S_MOVK reads.
+        template<typename T>
+        constexpr OpTiming sopk_timing()
+        {
+            using E = Execute<T>;
+            constexpr bool writes_d = std::is_reference_v<typename E::template Arg<1>>;
+            return { T::NAME, static_cast<uint8_t>(T::LATENCY),
+                     static_cast<uint8_t>(T::ID != SOPK::S_MOVK_I32::ID ? 4 : 0), 0, static_cast<uint8_t>(writes_d ? 4 : 0),
+                     E::ARITY == 3 && !WRITES_SCC<T>, WRITES_SCC<T>, false };
+        }
+
+        template<typename T>
+        constexpr OpTiming sopp_timing()
+        {
+            OpTiming t = { T::NAME, static_cast<uint8_t>(T::LATENCY), 0, 0, 0, false, false, false };
+            if constexpr (Execute<T>::ARITY == 3)
+            {
+                t.reads_scc  = T::CONDITION == SOPP::Condition::SCC;
+                t.reads_vcc  = T::CONDITION == SOPP::Condition::VCCZ;
+                t.reads_exec = T::CONDITION == SOPP::Condition::EXECZ;
+            }
+            return t;
+        }
+
+        // A scalar-cache hit; the base pair or descriptor is S0, an offset SGPR is S1.
+        template<typename T>
+        constexpr OpTiming smem_timing()
+        {
+            return { T::NAME, static_cast<uint8_t>(T::LATENCY), static_cast<uint8_t>(T::BUFFER ? 16 : 8), 4,
+                     static_cast<uint8_t>(T::DWORDS * 4), false, false, false };
+        }
+
+        template<typename T>
+        constexpr OpTiming vop_timing()
+        {
+            return { T::NAME, static_cast<uint8_t>(T::LATENCY), 4, 4, 4, false, false, Execute<T>::ARITY == 4 };
+        }
+
+        // One OpTiming per opcode, from the *_timing() function `timing` calls for each type.
+        template<size_t N, typename... Ts, typename F>
+        constexpr std::array<OpTiming, N> make_timing(InstructionList<Ts...>, F timing)
+        {
+            std::array<OpTiming, N> table{};
+            ((table[Ts::ID] = timing.template operator()<Ts>()), ...);
+            return table;
+        }
+
+        constexpr auto SOP1_TIMING = make_timing<SOP1_OPCODES>(SOP1::ALL{}, []<typename T>() { return sop1_timing<T>(); });
+        constexpr auto SOP2_TIMING = make_timing<SOP2_OPCODES>(SOP2::ALL{}, []<typename T>() { return sop2_timing<T>(); });
+        constexpr auto SOPC_TIMING = make_timing<SOPC_OPCODES>(SOPC::ALL{}, []<typename T>() { return sopc_timing<T>(); });
+        constexpr auto SOPK_TIMING = make_timing<SOPK_OPCODES>(SOPK::ALL{}, []<typename T>() { return sopk_timing<T>(); });
+        constexpr auto SOPP_TIMING = make_timing<SOPP_OPCODES>(SOPP::ALL{}, []<typename T>() { return sopp_timing<T>(); });
+        constexpr auto SMEM_TIMING = make_timing<SMEM_OPCODES>(SMEM::ALL{}, []<typename T>() { return smem_timing<T>(); });
+        constexpr auto VOP1_TIMING = make_timing<VOP1_OPCODES>(VOP1::ALL{}, []<typename T>() { return vop_timing<T>(); });
+        constexpr auto VOP2_TIMING = make_timing<VOP2_OPCODES>(VOP2::ALL{}, []<typename T>() { return vop_timing<T>(); });
+
+        static_assert(SOP2_TIMING[SOP2::S_ADDC_U32::ID].reads_scc && SOP2_TIMING[SOP2::S_CSELECT_B64::ID].reads_scc);
+        static_assert(SOP1_TIMING[SOP1::S_CMOV_B32::ID].reads_scc && !SOP2_TIMING[SOP2::S_ADD_U32::ID].reads_scc);
+        static_assert(VOP2_TIMING[VOP2::V_CNDMASK_B32::ID].reads_vcc);
+        static_assert(SOPK_TIMING[SOPK::S_CMOVK_I32::ID].reads_scc && SOPK_TIMING[SOPK::S_CMPK_EQ_I32::ID].writes_scc);
+        static_assert(SOPK_TIMING[SOPK::S_CMPK_EQ_I32::ID].D_bytes == 0 && SOPK_TIMING[SOPK::S_MOVK_I32::ID].S0_bytes == 0);
+        static_assert(SOPP_TIMING[SOPP::S_CBRANCH_SCC1::ID].reads_scc && SOPP_TIMING[SOPP::S_CBRANCH_EXECNZ::ID].reads_exec);
+
+        constexpr OpTiming FOLDED_TIMING = { "(folded)", 1, 0, 0, 4, false, true, false };
+        // Approximate: two dependent SALU issues reading SSRC0/SSRC1 and writing the SDST pair.
+        // The second instruction's own operands (fuse.hpp) are not tracked.
+        constexpr OpTiming FUSED_TIMING  = { "(fused)", 2, 8, 8, 8, false, true, false };
+    }
+
+    void CycleModel::issue(const Instruction& inst, uint32_t literal)
+    {
+        const OpTiming* t = nullptr;
+        Bucket*         b = nullptr;
+        switch (inst.format)
+        {
+            case Format::SOP1:   t = &SOP1_TIMING[inst.OP]; b = &SOP1[inst.OP]; break;
+            case Format::SOP2:   t = &SOP2_TIMING[inst.OP]; b = &SOP2[inst.OP]; break;
+            case Format::SOPC:   t = &SOPC_TIMING[inst.OP]; b = &SOPC[inst.OP]; break;
+            case Format::SOPK:   t = &SOPK_TIMING[inst.OP]; b = &SOPK[inst.OP]; break;
+            case Format::SOPP:   t = &SOPP_TIMING[inst.OP]; b = &SOPP[inst.OP]; break;
+            case Format::SMEM:   t = &SMEM_TIMING[inst.OP]; b = &SMEM[inst.OP]; break;
+            case Format::VOP1:   t = &VOP1_TIMING[inst.OP]; b = &VOP1[inst.OP]; break;
+            case Format::VOP2:   t = &VOP2_TIMING[inst.OP]; b = &VOP2[inst.OP]; break;
+            case Format::FOLDED: t = &FOLDED_TIMING;        b = &folded;        break;
+            case Format::FUSED:  t = &FUSED_TIMING;         b = &fused;         break;
+            default:             return;
+        }
+
+        uint64_t at = next_issue;
+        const auto scalar = [&](uint8_t src, uint8_t bytes)
+        {
+            if (src <= Operand::EXEC_HI)
+            {
+                at = std::max(at, SGPR_ready[src]);
+                if (bytes == 8) at = std::max(at, SGPR_ready[(src + 1) & 0x7F]);
+            }
+            else if (src == Operand::SCC)   at = std::max(at, SCC_ready);
+            else if (src == Operand::VCCZ)  at = std::max({ at, SGPR_ready[Operand::VCC_LO], SGPR_ready[Operand::VCC_HI] });
+            else if (src == Operand::EXECZ) at = std::max({ at, SGPR_ready[Operand::EXEC_LO], SGPR_ready[Operand::EXEC_HI] });
+        };
+
+        const bool vector = inst.format == Format::VOP1 || inst.format == Format::VOP2;
+        if (vector)
+        {
+            if (inst.VSRC0) at = std::max(at, VGPR_ready[inst.SSRC0]);
+            else            scalar(inst.SSRC0, 4);
+            if (inst.format == Format::VOP2) at = std::max(at, VGPR_ready[inst.SSRC1]);
+            if (t->reads_vcc) scalar(Operand::VCC_LO, 8);
+            scalar(Operand::EXEC_LO, 8);
+        }
+        else if (inst.format == Format::SOPK)
+        {
+            if (t->S0_bytes != 0) scalar(inst.SDST, t->S0_bytes);
+            if (t->reads_scc) at = std::max(at, SCC_ready);
+        }
+        else if (inst.format == Format::SOPP)
+        {
+            if (t->reads_scc)  at = std::max(at, SCC_ready);
+            if (t->reads_vcc)  scalar(Operand::VCC_LO, 8);
+            if (t->reads_exec) scalar(Operand::EXEC_LO, 8);
+        }
+        else if (inst.format == Format::SMEM)
+        {
+            for (uint8_t i = 0; i < t->S0_bytes; i += 8) scalar(static_cast<uint8_t>(inst.SSRC0 + i / 4), 8);
+            if ((inst.SSRC1 & SmemBits::IMM) == 0) scalar(static_cast<uint8_t>(literal), 4);
+            if ((inst.SSRC1 & SmemBits::SOE) != 0) scalar(static_cast<uint8_t>(literal >> 25), 4);
+        }
+        else if (inst.format != Format::FOLDED)
+        {
+            scalar(inst.SSRC0, t->S0_bytes);
+            if (inst.format != Format::SOP1) scalar(inst.SSRC1, t->S1_bytes);
+            if (t->reads_scc)
+            {
+                at = std::max(at, SCC_ready);
+                scalar(inst.SDST, t->D_bytes);
+            }
+        }
+
+        const uint64_t done = at + uint64_t{ t->latency } * ISSUE_CYCLES;
+        if (vector)
+        {
+            VGPR_ready[inst.SDST] = done;
+        }
+        else
+        {
+            for (uint8_t i = 0; i < t->D_bytes; i += 4) SGPR_ready[(inst.SDST + i / 4) & 0x7F] = done;
+            if (t->writes_scc) SCC_ready = done;
+        }
+
+        const uint32_t slots = inst.format == Format::FUSED ? 2 : 1;
+        stalls       += at - next_issue;
+        b->count     += 1;
+        b->cycles    += at - next_issue + slots * ISSUE_CYCLES;
+        next_issue    = at + slots * ISSUE_CYCLES;
+        finish        = std::max(finish, done);
+        instructions += slots;
+    }
+
+    void CycleModel::report(std::FILE* out) const
+    {
+        struct Line
+        {
+            const char*   name;
+            const Bucket* bucket;
+        };
+        std::vector<Line> lines;
+        // Each table is walked by its own size, so no instantiation indexes past a shorter one.
+        const auto collect = [&]<size_t N>(const std::array<OpTiming, N>& table, const Bucket (&buckets)[N])
+        {
+            for (size_t op = 0; op < table.size(); ++op)
+            {
+                if (buckets[op].count != 0) lines.push_back({ table[op].name ? table[op].name : "(unknown)", &buckets[op] });
+            }
+        };
+        collect(SOP1_TIMING, SOP1);
+        collect(SOP2_TIMING, SOP2);
+        collect(SOPC_TIMING, SOPC);
+        collect(SOPK_TIMING, SOPK);
+        collect(SOPP_TIMING, SOPP);
+        collect(SMEM_TIMING, SMEM);
+        collect(VOP1_TIMING, VOP1);
+        collect(VOP2_TIMING, VOP2);
+        if (folded.count != 0) lines.push_back({ FOLDED_TIMING.name, &folded });
+        if (fused.count != 0) lines.push_back({ FUSED_TIMING.name, &fused });
+        std::sort(lines.begin(), lines.end(), [](const Line& a, const Line& b) { return a.bucket->cycles > b.bucket->cycles; });
+
+        const uint64_t total = cycles();
+        std::fprintf(out, "%llu instructions, %llu cycles (%llu stalled)\n",
+                     static_cast<unsigned long long>(instructions), static_cast<unsigned long long>(total),
+                     static_cast<unsigned long long>(stalls));
+        for (const Line& line : lines)
+        {
+            std::fprintf(out, "  %-22s %12llu %14llu  %5.1f%%\n", line.name,
+                         static_cast<unsigned long long>(line.bucket->count),
+                         static_cast<unsigned long long>(line.bucket->cycles),
+                         total != 0 ? 100.0 * static_cast<double>(line.bucket->cycles) / static_cast<double>(total) : 0.0);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "wavefront.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// Estimated issue timing of one wavefront, built from each instruction's LATENCY:
+//
+//     CycleModel timing;
+//     wave.run(program, timing);   // or wave.run(translation, timing)
+//     timing.report(stdout);
+//
+// The model is GCN5's in-order issue. A SIMD serves each of its wavefronts once every
+// ISSUE_CYCLES clocks, and a wave64 VALU op occupies the SIMD16 for those same four clocks.
+// An instruction issues at its wavefront's next slot, unless a source written by an earlier
+// instruction is not ready yet. A result is ready LATENCY issue slots after its instruction
+// issued. SALU and VALU results are forwarded, so with LATENCY = 1 dependent instructions
+// issue back to back. SMEM loads are taken to hit the scalar cache, so their SDATA is ready
+// LATENCY slots later like any other result. Waitcnt and hazard wait states are not modelled.
+namespace vega
+{
+    struct CycleModel
+    {
+        static constexpr uint32_t ISSUE_CYCLES = 4;
+
+        struct Bucket
+        {
+            uint64_t count  = 0;
+            uint64_t cycles = 0; // issue interval plus the stall before it
+        };
+
+        uint64_t next_issue   = 0; // cycle of the next free issue slot
+        uint64_t finish       = 0; // cycle the last result became ready
+        uint64_t instructions = 0;
+        uint64_t stalls       = 0; // cycles spent waiting on operands
+
+        uint64_t SGPR_ready[128]                   = {};
+        uint64_t SCC_ready                         = 0;
+        uint64_t VGPR_ready[Wavefront::VGPR_COUNT] = {};
+
+        Bucket SOP1[SOP1_OPCODES];
+        Bucket SOP2[SOP2_OPCODES];
+        Bucket SOPC[SOPC_OPCODES];
+        Bucket SOPK[SOPK_OPCODES];
+        Bucket SOPP[SOPP_OPCODES];
+        Bucket SMEM[SMEM_OPCODES];
+        Bucket VOP1[VOP1_OPCODES];
+        Bucket VOP2[VOP2_OPCODES];
+        Bucket folded; // µops replaced by fold_constants()
+        Bucket fused;  // pairs merged by fuse_pairs()
+
+        // `literal` names an SMEM load's offset SGPRs.
+        void issue(const Instruction& inst, uint32_t literal = 0);
+
+        // Run-loop observer hooks (see NoObserver).
+        void issue(const Wavefront&, uint32_t, const Instruction& inst, uint32_t literal) { issue(inst, literal); }
+        void retire(const Wavefront&, const Instruction&) {}
+
+        // Estimated cycles from the first issue until every result is ready.
+        uint64_t cycles() const { return finish > next_issue ? finish : next_issue; }
+
+        // Totals, then one line per opcode that ran, most cycles first.
+        void report(std::FILE* out) const;
+
+        void reset() { *this = CycleModel{}; }
+    };
+}
@@ -0,0 +1,90 @@
+#include "trace.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace vega
+{
+    TraceFile::TraceFile(const char* path)
+    {
+        out = std::fopen(path, "wb");
+        if (out == nullptr) return;
+        TraceHeader header;
+        header.record_size = sizeof(TraceRecord);
+        failed  = std::fwrite(&header, sizeof(header), 1, out) != 1;
+        flusher = std::thread([this] { flusher_loop(); });
+    }
+
+    TraceFile::~TraceFile()
+    {
+        if (out == nullptr) return;
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        flusher.join();
+        std::fclose(out);
+    }
+
+    void TraceFile::attach(TraceRing& ring)
+    {
+        if (out == nullptr) return; // no flusher to drain it
+        std::lock_guard lock(mutex);
+        ring.flusher = &wake;
+        rings.push_back(&ring);
+    }
+
+    void TraceFile::detach(TraceRing& ring)
+    {
+        std::lock_guard lock(mutex);
+        drain(ring);
+        rings.erase(std::remove(rings.begin(), rings.end(), &ring), rings.end());
+    }
+
+    size_t TraceFile::drain(TraceRing& ring)
+    {
+        const uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+        const uint64_t head = ring.head.load(std::memory_order_acquire);
+        if (head == tail) return 0;
+
+        if (out != nullptr && !failed)
+        {
+            const uint32_t chunk[2] = { ring.thread, static_cast<uint32_t>(head - tail) };
+            const size_t   first    = tail & (TraceRing::CAPACITY - 1);
+            const size_t   count    = static_cast<size_t>(head - tail);
+            const size_t   before   = std::min(count, TraceRing::CAPACITY - first); // up to the wrap
+            failed = std::fwrite(chunk, sizeof(chunk), 1, out) != 1
+                  || std::fwrite(&ring.records[first], sizeof(TraceRecord), before, out) != before
+                  || std::fwrite(&ring.records[0], sizeof(TraceRecord), count - before, out) != count - before;
+        }
+        ring.tail.store(head, std::memory_order_release);
+        return static_cast<size_t>(head - tail);
+    }
+
+    void TraceFile::flusher_loop()
+    {
+        std::unique_lock lock(mutex);
+        for (;;)
+        {
+            for (TraceRing* ring : rings)
+            {
+                drain(*ring);
+            }
+            if (stopping) break;
+            // Batches writes; a producer with a full ring cuts the wait short.
+            wake.wait_for(lock, std::chrono::milliseconds(1));
+        }
+        std::fflush(out);
+    }
+
+    Tracer::Tracer(TraceFile& file, uint32_t thread) : file(file)
+    {
+        ring.thread = thread;
+        file.attach(ring);
+    }
+
+    Tracer::~Tracer()
+    {
+        file.detach(ring);
+    }
+}
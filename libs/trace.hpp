@@ -0,0 +1,228 @@
+#pragma once
+
+#include "syntax.hpp"
+#include "wavefront.hpp"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Execution tracing into a binary file, rendered offline by tools/trace:
+//
+//     TraceFile file("run.vtrace");
+//     Tracer    tracer(file, thread_id);
+//     wave.run(program, tracer);      // or wave.run(translation, tracer)
+//
+// Each Tracer owns a single-producer ring. The interpreting thread appends one fixed-size
+// record per instruction with plain stores and a release of the head index. TraceFile's
+// flusher thread wakes every millisecond and drains every ring into the file in chunks. A
+// full ring wakes the flusher early and makes the producer wait for it, so no record is ever
+// dropped. A TraceFile that could not be opened has no flusher; its Tracers keep nothing.
+//
+// File layout: TraceHeader, then chunks of { uint32_t thread, uint32_t count } followed by
+// `count` TraceRecords. All fields are little-endian.
+namespace vega
+{
+    struct TraceHeader
+    {
+        static constexpr uint32_t MAGIC   = 0x43525456; // "VTRC"
+        static constexpr uint32_t VERSION = 1;
+
+        uint32_t magic       = MAGIC;
+        uint32_t version     = VERSION;
+        uint32_t record_size = 0;
+        uint32_t reserved    = 0;
+    };
+
+    struct TraceRecord
+    {
+        enum Flags : uint8_t
+        {
+            SCC_BEFORE = 1 << 0,
+            SCC_AFTER  = 1 << 1,
+            VSRC0      = 1 << 2, // SSRC0 is a VGPR index
+        };
+
+        uint64_t seq    = 0; // position in the thread's stream
+        uint32_t PC     = 0;
+        uint32_t wave   = 0; // Tracer::wave when the record was taken
+        uint8_t  format = 0; // Format
+        uint8_t  OP     = 0;
+        uint8_t  SDST   = 0;
+        uint8_t  SSRC0  = 0;
+        uint8_t  SSRC1  = 0;
+        uint8_t  flags  = 0;
+        uint16_t pad    = 0;
+        uint64_t S0     = 0; // source values as the instruction read them; VOP: lane 0
+        uint64_t S1     = 0;
+        uint64_t D      = 0; // destination after the instruction
+    };
+    static_assert(sizeof(TraceRecord) == 48);
+
+    struct TraceRing
+    {
+        static constexpr size_t CAPACITY = 1 << 16; // records, a power of two
+
+        std::unique_ptr<TraceRecord[]> records = std::make_unique<TraceRecord[]>(CAPACITY);
+        uint32_t                       thread  = 0;
+        std::condition_variable*       flusher = nullptr; // TraceFile::wake, set by attach(); nullptr drops records
+
+        alignas(64) std::atomic<uint64_t> head{ 0 }; // written by the producer
+        uint64_t                          cached_tail = 0;
+        alignas(64) std::atomic<uint64_t> tail{ 0 }; // written by the flusher
+
+        void push(const TraceRecord& record)
+        {
+            const uint64_t h = head.load(std::memory_order_relaxed);
+            if (h - cached_tail == CAPACITY)
+            {
+                if (flusher == nullptr)
+                {
+                    tail.store(h, std::memory_order_relaxed);
+                    cached_tail = h;
+                }
+                while (h - (cached_tail = tail.load(std::memory_order_acquire)) == CAPACITY)
+                {
+                    flusher->notify_one();
+                    std::this_thread::yield();
+                }
+            }
+            records[h & (CAPACITY - 1)] = record;
+            head.store(h + 1, std::memory_order_release);
+        }
+    };
+
+    struct TraceFile
+    {
+        std::FILE*              out = nullptr;
+        std::thread             flusher;
+        std::mutex              mutex; // guards `rings` and every write to `out`
+        std::condition_variable wake;
+        std::vector<TraceRing*> rings;
+        bool                    stopping = false;
+        bool                    failed   = false; // a write failed; later records are lost
+
+        explicit TraceFile(const char* path);
+        TraceFile(const TraceFile&) = delete;
+        TraceFile& operator=(const TraceFile&) = delete;
+        ~TraceFile();
+
+        bool ok() const { return out != nullptr && !failed; }
+
+        void attach(TraceRing& ring);
+        void detach(TraceRing& ring); // drains it first
+
+        void flusher_loop();
+        size_t drain(TraceRing& ring); // with `mutex` held
+    };
+
+    struct OperandWidths
+    {
+        uint8_t S0 = 4, S1 = 4, D = 4;
+    };
+
+    constexpr OperandWidths operand_widths(const syntax::Mnemonic& m) { return { m.S0_bytes, m.S1_bytes, m.D_bytes }; }
+
+    // One OperandWidths per opcode, from the syntax:: function `mnemonic` calls for each type.
+    template<size_t N, typename... Ts, typename F>
+    constexpr std::array<OperandWidths, N> make_widths(InstructionList<Ts...>, F mnemonic)
+    {
+        std::array<OperandWidths, N> table{};
+        ((table[Ts::ID] = operand_widths(mnemonic.template operator()<Ts>())), ...);
+        return table;
+    }
+
+    inline constexpr auto SOP1_WIDTHS = make_widths<SOP1_OPCODES>(SOP1::ALL{}, []<typename T>() { return syntax::sop1<T>(); });
+    inline constexpr auto SOP2_WIDTHS = make_widths<SOP2_OPCODES>(SOP2::ALL{}, []<typename T>() { return syntax::sop2<T>(); });
+    inline constexpr auto SOPC_WIDTHS = make_widths<SOPC_OPCODES>(SOPC::ALL{}, []<typename T>() { return syntax::sopc<T>(); });
+    inline constexpr auto SMEM_WIDTHS = make_widths<SMEM_OPCODES>(SMEM::ALL{}, []<typename T>() { return syntax::smem<T>(); });
+
+    // Run-loop observer (see NoObserver) recording every instruction.
+    struct Tracer
+    {
+        TraceFile&  file;
+        TraceRing   ring;
+        TraceRecord pending;
+        uint32_t    wave = 0; // stamped on each record; set it between wavefronts
+
+        Tracer(TraceFile& file, uint32_t thread);
+        Tracer(const Tracer&) = delete;
+        Tracer& operator=(const Tracer&) = delete;
+        ~Tracer();
+
+        static uint64_t scalar(const Wavefront& w, uint8_t src, uint8_t bytes, uint32_t literal)
+        {
+            return bytes == 8 ? w.read<uint64_t>(src, literal) : w.read<uint32_t>(src, literal);
+        }
+
+        void issue(const Wavefront& w, uint32_t PC, const Instruction& inst, uint32_t literal)
+        {
+            pending.PC     = PC;
+            pending.wave   = wave;
+            pending.format = static_cast<uint8_t>(inst.format);
+            pending.OP     = inst.OP;
+            pending.SDST   = inst.SDST;
+            pending.SSRC0  = inst.SSRC0;
+            pending.SSRC1  = inst.SSRC1;
+            pending.flags  = (w.SCC ? TraceRecord::SCC_BEFORE : 0) | (inst.VSRC0 ? TraceRecord::VSRC0 : 0);
+            pending.S1     = 0;
+            switch (inst.format)
+            {
+                case Format::SOP1:
+                    pending.S0 = scalar(w, inst.SSRC0, SOP1_WIDTHS[inst.OP].S0, literal);
+                    break;
+                case Format::SOP2:
+                    pending.S0 = scalar(w, inst.SSRC0, SOP2_WIDTHS[inst.OP].S0, literal);
+                    pending.S1 = scalar(w, inst.SSRC1, SOP2_WIDTHS[inst.OP].S1, literal);
+                    break;
+                case Format::SOPC:
+                    pending.S0 = scalar(w, inst.SSRC0, SOPC_WIDTHS[inst.OP].S0, literal);
+                    pending.S1 = scalar(w, inst.SSRC1, SOPC_WIDTHS[inst.OP].S1, literal);
+                    break;
+                case Format::SOPK: // S1 is SDST before the instruction
+                    pending.S0 = simm16(inst);
+                    pending.S1 = w.read<uint32_t>(inst.SDST, 0);
+                    break;
+                case Format::SOPP:
+                    pending.S0 = simm16(inst);
+                    break;
+                case Format::SMEM: // S0 is the base address, S1 the offset dword
+                    pending.S0 = w.read<uint64_t>(inst.SSRC0, 0);
+                    pending.S1 = literal;
+                    break;
+                case Format::VOP1:
+                case Format::VOP2:
+                    pending.S0 = inst.VSRC0 ? w.VGPR[inst.SSRC0][0] : w.read<uint32_t>(inst.SSRC0, literal);
+                    if (inst.format == Format::VOP2) pending.S1 = w.VGPR[inst.SSRC1][0];
+                    break;
+                default: // FOLDED: the stored value is the literal
+                    pending.S0 = literal;
+                    break;
+            }
+        }
+
+        void retire(const Wavefront& w, const Instruction& inst)
+        {
+            switch (inst.format)
+            {
+                case Format::SOP1: pending.D = scalar(w, inst.SDST, SOP1_WIDTHS[inst.OP].D, 0); break;
+                case Format::SOP2: pending.D = scalar(w, inst.SDST, SOP2_WIDTHS[inst.OP].D, 0); break;
+                case Format::SOPC: pending.D = 0;                                              break;
+                case Format::SOPP: pending.D = w.PC;                                           break; // where it went
+                case Format::SMEM: pending.D = scalar(w, inst.SDST, SMEM_WIDTHS[inst.OP].D >= 8 ? 8 : 4, 0); break; // the first dwords loaded
+                case Format::VOP1:
+                case Format::VOP2: pending.D = w.VGPR[inst.SDST][0];                           break;
+                default:           pending.D = w.read<uint32_t>(inst.SDST, 0);                   break;
+            }
+            if (w.SCC) pending.flags |= TraceRecord::SCC_AFTER;
+            ring.push(pending);
+            ++pending.seq;
+        }
+    };
+}
@@ -0,0 +1,141 @@
+#include "uop_cache.hpp"
+#include "fold.hpp"
+#include "fuse.hpp"
+#include "liveness.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace vega
+{
+    namespace
+    {
+        // Resolves every control op's target to an op index and cuts the ops into blocks
+        // at branch targets and after control ops.
+        void link_blocks(Translation& t)
+        {
+            const uint32_t n = static_cast<uint32_t>(t.ops.size());
+            std::vector<bool> leader(n + 1, false);
+            leader[0] = true;
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                MicroOp& op = t.ops[i];
+                if (!is_control(op.inst)) continue;
+                leader[i + 1] = true;
+
+                // Every control op but S_ENDPGM is a relative branch; END_PC finds no op.
+                const uint32_t to = op.inst.OP == SOPP::S_ENDPGM::ID ? SOPP::END_PC : op.PC + 4 + SOPP::branch_offset(simm16(op.inst));
+                const auto at = std::lower_bound(t.ops.begin(), t.ops.end(), to,
+                                                 [](const MicroOp& o, uint32_t pc) { return o.PC < pc; });
+                op.target = at != t.ops.end() && at->PC == to ? static_cast<uint32_t>(at - t.ops.begin()) : Translation::LEAVE;
+                if (op.target != Translation::LEAVE) leader[op.target] = true;
+            }
+
+            std::vector<uint32_t> block_of(n + 1, 0);
+            t.blocks.clear();
+            for (uint32_t i = 0; i < n;)
+            {
+                Block block;
+                block.first = i;
+                while (i < n && !is_control(t.ops[i].inst) && (i == block.first || !leader[i])) ++i;
+                block.end     = i;
+                block.control = i < n && is_control(t.ops[i].inst) && (i == block.first || !leader[i]);
+                if (block.control) ++i;
+                block_of[block.first] = static_cast<uint32_t>(t.blocks.size());
+                t.blocks.push_back(block);
+            }
+            const uint32_t count = static_cast<uint32_t>(t.blocks.size());
+            for (uint32_t b = 0; b < count; ++b)
+            {
+                Block& block = t.blocks[b];
+                block.next   = b + 1; // `count` for the last block: the exit
+                block.taken  = Translation::LEAVE;
+                if (block.control)
+                {
+                    const uint32_t target = t.ops[block.end].target;
+                    if (target != Translation::LEAVE) block.taken = block_of[target];
+                }
+            }
+        }
+    }
+
+    Translation translate(std::span<const uint32_t> code)
+    {
+        Translation out;
+        out.ops.reserve(code.size());
+
+        uint32_t pc = 0;
+        const size_t end = code.size() * sizeof(uint32_t);
+        while (pc < end)
+        {
+            const uint32_t*   word = code.data() + pc / sizeof(uint32_t);
+            const Instruction inst = decode(*word);
+            const bool        lit  = has_literal(inst);
+            const WaveHandler fn   = salu_handler(inst);
+
+            if (fn == nullptr || (lit && pc + 8 > end))
+            {
+                out.exit = Wavefront::Status::ILLEGAL;
+                break;
+            }
+            out.ops.push_back({ fn, inst, lit ? word[1] : 0, pc });
+            pc += lit ? 8 : 4;
+        }
+        out.exit_pc = pc;
+        out.end     = static_cast<uint32_t>(end);
+        static std::atomic<uint64_t> serials{ 0 };
+        out.serial  = serials.fetch_add(1, std::memory_order_relaxed) + 1;
+        link_blocks(out);
+        return out;
+    }
+
+    uint64_t code_hash(std::span<const uint32_t> code)
+    {
+        uint64_t hash = 0xCBF29CE484222325ULL; // FNV-1a over whole dwords
+        for (uint32_t word : code)
+        {
+            hash = (hash ^ word) * 0x100000001B3ULL;
+        }
+        return hash;
+    }
+
+    const Translation& UopCache::get(std::span<const uint32_t> code)
+    {
+        auto [it, inserted] = entries.try_emplace(code.data());
+        Entry& entry = it->second;
+
+        if (!inserted && entry.words == code.size())
+        {
+            if (entry.generation == generation)
+            {
+                ++hits;
+                return entry.translation;
+            }
+            const uint64_t hash = code_hash(code);
+            entry.generation    = generation;
+            if (entry.hash == hash)
+            {
+                ++hits;
+                return entry.translation;
+            }
+            entry.hash = hash;
+        }
+        else
+        {
+            entry.hash       = code_hash(code);
+            entry.generation = generation;
+        }
+        ++misses;
+        entry.words       = code.size();
+        entry.translation = translate(code);
+        if (fold) fold_constants(entry.translation);
+        if (lazy_scc) drop_dead_scc(entry.translation);
+        if (fuse) fuse_pairs(entry.translation);
+        return entry.translation;
+    }
+
+    Wavefront::Status Wavefront::run(const Translation& translation)
+    {
+        NoObserver none;
+        return run(translation, none);
+    }
+}
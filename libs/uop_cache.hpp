@@ -0,0 +1,115 @@
+#pragma once
+
+#include "wavefront.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace vega
+{
+    // One pre-decoded instruction: handler, operand encodings and literal are resolved once.
+    struct MicroOp
+    {
+        WaveHandler fn       = nullptr;
+        Instruction inst     = {};
+        uint32_t    literal  = 0;
+        uint32_t    PC       = 0;
+        uint32_t    target   = 0;     // is_control() ops: index of the op a taken branch goes to
+        bool        scc_dead = false; // fn leaves SCC alone, nothing reads what it would write (liveness.hpp)
+    };
+
+    // A straight run of ops, optionally ended by one control op. Successors are block
+    // indices resolved by translate(), so a taken branch goes straight to its target block.
+    struct Block
+    {
+        uint32_t first   = 0; // ops [first, end) have no control flow
+        uint32_t end     = 0;
+        bool     control = false; // ops[end] is a control op ending the block
+        uint32_t next    = 0;     // falling through; blocks.size() leaves through `exit`
+        uint32_t taken   = 0;     // the control op's branch
+    };
+
+    // Ops are in program order. A branch into the middle of an instruction, past the first
+    // undecodable word or outside the program has target LEAVE: the run stops there with PC
+    // set to the target, ILLEGAL inside the program and ENDED past its end (as after
+    // S_ENDPGM). run(program) would decode from such a target instead.
+    struct Translation
+    {
+        static constexpr uint32_t LEAVE = UINT32_MAX;
+
+        std::vector<MicroOp> ops;
+        std::vector<Block>   blocks;
+        Wavefront::Status    exit    = Wavefront::Status::ENDED;
+        uint32_t             exit_pc = 0; // where the wavefront stops after the last op
+        uint32_t             end     = 0; // program size in bytes
+        uint64_t             serial  = 0; // unique to each translate() call, so caches of generated code can tell translations apart
+
+        // Status after a taken branch to LEAVE, which left the target in `PC`.
+        Wavefront::Status left(uint32_t PC) const { return PC < end ? Wavefront::Status::ILLEGAL : Wavefront::Status::ENDED; }
+    };
+
+    Translation translate(std::span<const uint32_t> code);
+
+    uint64_t code_hash(std::span<const uint32_t> code);
+
+    // Keyed by code address and size, so a hit costs one map lookup. A binary rewritten in
+    // place needs invalidate(): each entry is then hashed again on its next get(), and only
+    // translated again if the hash changed.
+    struct UopCache
+    {
+        struct Entry
+        {
+            uint64_t    hash       = 0;
+            uint64_t    generation = 0; // the cache's generation `hash` was taken in
+            size_t      words      = 0;
+            Translation translation;
+        };
+
+        std::unordered_map<const uint32_t*, Entry> entries;
+        uint64_t generation = 0;     // bumped by invalidate()
+        uint64_t hits       = 0;
+        uint64_t misses     = 0;
+        bool     fold       = false; // run fold_constants() on each new translation
+        bool     lazy_scc   = false; // then drop_dead_scc()
+        bool     fuse       = false; // then fuse_pairs(); for the interpreters, run_jit() compiles pairs as they are
+
+        const Translation& get(std::span<const uint32_t> code);
+        void invalidate() { ++generation; }
+        void clear() { entries.clear(); hits = misses = 0; }
+    };
+
+    template<typename Observer>
+    Wavefront::Status Wavefront::run(const Translation& translation, Observer& observer)
+    {
+        const MicroOp* ops = translation.ops.data();
+        const size_t   n   = translation.blocks.size();
+        for (size_t b = 0; b < n;)
+        {
+            const Block& block = translation.blocks[b];
+            for (uint32_t i = block.first; i < block.end; ++i)
+            {
+                observer.issue(*this, ops[i].PC, ops[i].inst, ops[i].literal);
+                ops[i].fn(*this, ops[i].inst, ops[i].literal);
+                observer.retire(*this, ops[i].inst);
+            }
+            if (!block.control)
+            {
+                b = block.next;
+                continue;
+            }
+
+            const MicroOp& op   = ops[block.end];
+            const uint32_t next = op.PC + 4;
+            observer.issue(*this, op.PC, op.inst, op.literal);
+            PC = next;
+            op.fn(*this, op.inst, op.literal);
+            observer.retire(*this, op.inst);
+            if (PC == next)                                      b = block.next;
+            else if ((b = block.taken) == Translation::LEAVE) return translation.left(PC);
+        }
+        PC = translation.exit_pc;
+        return translation.exit;
+    }
+}
@@ -0,0 +1,113 @@
+#include "batch.hpp"
+#include "wavefront.hpp"
+#include <array>
+
+namespace vega
+{
+    namespace
+    {
+        using Lanes = uint32_t[Wavefront::LANES];
+
+        // All 64 lanes are computed, then merged under EXEC, so the loops have a fixed trip
+        // count and no per-lane branch: four 512-bit (or eight 256-bit) ops per step. VDST
+        // may be a source (v_add_u32 v1, v1, v2), so nothing is __restrict; the results go
+        // to `r` first and only the merge writes d.
+        template<typename T, Format F>
+        [[gnu::always_inline]] inline void vop_lanes(const uint32_t* s0, const uint32_t* s1, uint32_t* d, uint64_t exec, uint64_t vcc)
+        {
+            alignas(64) Lanes r;
+            for (int half = 0; half < 2; ++half)
+            {
+                const uint32_t vcc_half = static_cast<uint32_t>(vcc >> (32 * half));
+                for (int l = 0; l < 32; ++l)
+                {
+                    const int lane = 32 * half + l;
+                    uint32_t  v    = d[lane];
+                    if constexpr (F == Format::VOP1)              T::execute(s0[lane], v);
+                    else if constexpr (Execute<T>::ARITY == 4)    T::execute(s0[lane], s1[lane], v, ((vcc_half >> l) & 1) != 0);
+                    else                                          T::execute(s0[lane], s1[lane], v);
+                    r[lane] = v;
+                }
+            }
+            for (int half = 0; half < 2; ++half)
+            {
+                const uint32_t exec_half = static_cast<uint32_t>(exec >> (32 * half));
+                for (int l = 0; l < 32; ++l)
+                {
+                    const int      lane = 32 * half + l;
+                    const uint32_t m    = 0u - ((exec_half >> l) & 1);
+                    d[lane] = (r[lane] & m) | (d[lane] & ~m);
+                }
+            }
+        }
+
+    #if VEGA_BATCH_X86
+        template<typename T, Format F>
+        [[gnu::target("avx2")]] void vop_avx2(const uint32_t* s0, const uint32_t* s1, uint32_t* d, uint64_t exec, uint64_t vcc)
+        {
+            vop_lanes<T, F>(s0, s1, d, exec, vcc);
+        }
+
+        template<typename T, Format F>
+        [[gnu::target("avx512f,avx512bw,avx512vl,avx2")]] void vop_avx512(const uint32_t* s0, const uint32_t* s1, uint32_t* d, uint64_t exec, uint64_t vcc)
+        {
+            vop_lanes<T, F>(s0, s1, d, exec, vcc);
+        }
+    #endif
+
+        template<typename T, Format F, BatchIsa ISA>
+        void execute_vop(Wavefront& wave, const Instruction& inst, uint32_t literal)
+        {
+            alignas(64) Lanes broadcast;
+            const uint32_t* s0 = wave.VGPR[inst.SSRC0];
+            if (!inst.VSRC0)
+            {
+                const uint32_t value = wave.read<uint32_t>(inst.SSRC0, literal);
+                for (uint32_t& lane : broadcast) lane = value;
+                s0 = broadcast;
+            }
+            const uint32_t* s1   = wave.VGPR[inst.SSRC1];
+            uint32_t*       d    = wave.VGPR[inst.SDST];
+            const uint64_t  exec = wave.exec();
+            const uint64_t  vcc  = wave.vcc();
+
+        #if VEGA_BATCH_X86
+            if constexpr (ISA == BatchIsa::AVX512)    vop_avx512<T, F>(s0, s1, d, exec, vcc);
+            else if constexpr (ISA == BatchIsa::AVX2) vop_avx2<T, F>(s0, s1, d, exec, vcc);
+            else
+        #endif
+                vop_lanes<T, F>(s0, s1, d, exec, vcc);
+        }
+
+        template<BatchIsa ISA, Format F, size_t N, typename... Ts>
+        constexpr std::array<WaveHandler, N> make_vop_table(InstructionList<Ts...>)
+        {
+            std::array<WaveHandler, N> table{};
+            ((table[Ts::ID] = &execute_vop<Ts, F, ISA>), ...);
+            return table;
+        }
+
+        template<BatchIsa ISA>
+        struct ValuTables
+        {
+            static constexpr auto VOP1 = make_vop_table<ISA, Format::VOP1, VOP1_OPCODES>(vega::VOP1::ALL{});
+            static constexpr auto VOP2 = make_vop_table<ISA, Format::VOP2, VOP2_OPCODES>(vega::VOP2::ALL{});
+        };
+
+        template<BatchIsa ISA>
+        WaveHandler lookup(const Instruction& inst)
+        {
+            return inst.format == Format::VOP1 ? ValuTables<ISA>::VOP1[inst.OP] : ValuTables<ISA>::VOP2[inst.OP];
+        }
+    }
+
+    WaveHandler valu_handler(const Instruction& inst)
+    {
+        switch (batch_isa())
+        {
+            case BatchIsa::AVX512: return lookup<BatchIsa::AVX512>(inst);
+            case BatchIsa::AVX2:   return lookup<BatchIsa::AVX2>(inst);
+            default:               return lookup<BatchIsa::SCALAR>(inst);
+        }
+    }
+}
@@ -1,77 +1,64 @@
 #pragma once
 
+#include "bitops.hpp"
+#include <bit>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
-#include <string>
 #include <sys/types.h>
-#include <unordered_map>
 #include <type_traits>
 
-struct SOP1_Base {
-    virtual void run(uint32_t S0, uint32_t& D, bool& SCC) = 0;
-    virtual ~SOP1_Base() = default;
-};
-
-struct SOP2_Base {
-    virtual void run(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC) = 0;
-    virtual ~SOP2_Base() = default;
-};
-
-extern std::unordered_map<std::string, SOP1_Base*> instruction_registry_sop1;
-extern std::unordered_map<std::string, SOP2_Base*> instruction_registry_sop2;
-
+// Registry operands are 64 bits wide so the B64 forms dispatch too. D behaves like an SGPR
+// pair: a 32-bit result replaces the low half and leaves the high half alone.
 template<typename T>
-void call_execute_sop1(uint32_t S0, uint32_t& D, bool& SCC) {
-    if constexpr (requires { T::execute(uint32_t{}, D, SCC); }) {
+void call_execute_sop1(uint64_t S0, uint64_t& D, bool& SCC) {
+    if constexpr (requires { T::execute(S0, D, SCC); }) {
         T::execute(S0, D, SCC);
     }
-    else if constexpr (requires { T::execute(uint32_t{}, D); }) {
+    else if constexpr (requires { T::execute(S0, D); }) {
         T::execute(S0, D);
     }
-    else if constexpr (requires { T::execute(uint64_t{}, (uint32_t*)nullptr, uint8_t{}, SCC); }) {
-        T::execute((uint64_t)S0, &D, 0, SCC); 
-    }
-    else if constexpr (requires { T::execute(uint64_t{}, (uint32_t*)nullptr, uint8_t{}); }) {
-        T::execute((uint64_t)S0, &D, 0);
+    else {
+        uint32_t low = static_cast<uint32_t>(D); // S0 converts to the execute() parameter width
+        if constexpr (requires { T::execute(S0, low, SCC); }) {
+            T::execute(S0, low, SCC);
+        }
+        else {
+            T::execute(S0, low);
+        }
+        D = (D & 0xFFFFFFFF00000000ULL) | low;
     }
 }
 
 template<typename T>
-void call_execute_sop2(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC) {
-    if constexpr (requires { T::execute(uint32_t{}, uint32_t{}, D); }) {
+void call_execute_sop2(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC) {
+    if constexpr (requires { T::execute(S0, S1, D); }) {
         T::execute(S0, S1, D);
     }
-    else if constexpr (requires { T::execute(uint32_t{}, uint32_t{}, D, SCC); }) {
+    else if constexpr (requires { T::execute(S0, S1, D, SCC); }) {
         T::execute(S0, S1, D, SCC);
     }
+    else {
+        uint32_t low = static_cast<uint32_t>(D);
+        if constexpr (requires { T::execute(S0, S1, low); }) {
+            T::execute(S0, S1, low);
+        }
+        else {
+            T::execute(S0, S1, low, SCC);
+        }
+        D = (D & 0xFFFFFFFF00000000ULL) | low;
+    }
 }
 
 
-#define REGISTER_SOP1(CLASS_NAME) \
-class CLASS_NAME##_Runner : public SOP1_Base { \
-public: \
-    void run(uint32_t S0, uint32_t& D, bool& SCC) override { \
-        call_execute_sop1<CLASS_NAME>(S0, D, SCC); \
-    } \
-}; \
-inline static bool CLASS_NAME##_registered = []() { \
-    instruction_registry_sop1[#CLASS_NAME] = new CLASS_NAME##_Runner(); \
-    return true; \
-}();
-
-#define REGISTER_SOP2(CLASS_NAME) \
-class CLASS_NAME##_RunnerSOP2 : public SOP2_Base { \
-public: \
-    void run(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC) override { \
-        call_execute_sop2<CLASS_NAME>(S0, S1, D, SCC); \
-    } \
-}; \
-inline static bool CLASS_NAME##_registered = []() { \
-    instruction_registry_sop2[#CLASS_NAME] = new CLASS_NAME##_RunnerSOP2(); \
-    return true; \
-}();
-
 namespace vega
 {
+    template<typename... Ts>
+    struct InstructionList
+    {
+        static constexpr size_t SIZE = sizeof...(Ts);
+    };
+
     namespace SOP2 // Base: 0x80000000
     {
         static constexpr uint32_t BASE = 0x80000000;
@@ -83,7 +70,7 @@ namespace vega
             static constexpr const char* NAME = "S_ADD_U32";
             static constexpr const char* DESK = "Add unsigned 32-bit integers.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 uint64_t temp = static_cast<uint64_t>(S0) + static_cast<uint64_t>(S1);
                 D = static_cast<uint32_t>(temp);
@@ -99,7 +86,7 @@ namespace vega
             static constexpr const char* NAME = "S_SUB_U32";
             static constexpr const char* DESK = "Sub unsigned 32-bit integers.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 D = S0 - S1;
                 SCC = (S1 > S0); 
@@ -115,7 +102,7 @@ namespace vega
             static constexpr const char* NAME = "S_ADD_I32";
             static constexpr const char* DESK = "";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 D = S0 + S1;
 
@@ -125,6 +112,7 @@ namespace vega
 
                 SCC = (s0_sign == s1_sign) && (s0_sign != d_sign);
             }
+            static constexpr uint32_t hex() { return BASE | (ID << 23); }
         };
 
         struct S_SUB_I32 // Opcode: 3
@@ -134,7 +122,7 @@ namespace vega
             static constexpr const char* NAME = "S_SUB_I32";
             static constexpr const char* DESK = "Sub signed 32-bit integers with overflow check.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 D = S0 - S1;
 
@@ -154,7 +142,7 @@ namespace vega
             static constexpr const char* NAME = "S_ADDC_U32";
             static constexpr const char* DESK = "Add unsigned 32-bit integers with Carry.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 uint64_t carry = SCC ? 1 : 0;
                 uint64_t temp = static_cast<uint64_t>(S0) + static_cast<uint64_t>(S1) + carry;
@@ -171,7 +159,7 @@ namespace vega
             static constexpr const char* NAME = "S_SUBB_U32";
             static constexpr const char* DESK = "Sub unsigned 32-bit integers with Borrow.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 uint64_t borrow = SCC ? 1 : 0;
                 uint64_t temp = static_cast<uint64_t>(S0) - static_cast<uint64_t>(S1) - borrow;
@@ -188,7 +176,7 @@ namespace vega
             static constexpr const char* NAME = "S_MIN_I32";
             static constexpr const char* DESK = "Minimum of two signed 32-bit integers.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 int32_t s0_i = static_cast<int32_t>(S0);
                 int32_t s1_i = static_cast<int32_t>(S1);
@@ -206,7 +194,7 @@ namespace vega
             static constexpr const char* NAME = "S_MIN_U32";
             static constexpr const char* DESK = "Minimum of two unsigned 32-bit integers.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 D = (S0 < S1) ? S0 : S1;
                 SCC = (S0 < S1);
@@ -221,7 +209,7 @@ namespace vega
             static constexpr const char* NAME = "S_MAX_I32";
             static constexpr const char* DESK = "Maximum of two signed 32-bit integers.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 int32_t s0_i = static_cast<int32_t>(S0);
                 int32_t s1_i = static_cast<int32_t>(S1);
@@ -239,7 +227,7 @@ namespace vega
             static constexpr const char* NAME = "S_MAX_U32";
             static constexpr const char* DESK = "Maximum of two unsigned 32-bit integers.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 D = (S0 > S1) ? S0 : S1;
                 SCC = (S0 > S1);
@@ -254,7 +242,7 @@ namespace vega
             static constexpr const char* NAME = "S_CSELECT_B32";
             static constexpr const char* DESK = "Conditional select 32-bit based on SCC.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool SCC)
             {
                 D = SCC ? S0 : S1;
             }
@@ -268,7 +256,7 @@ namespace vega
             static constexpr const char* NAME = "S_CSELECT_B64";
             static constexpr const char* DESK = "Conditional select 64-bit based on SCC.";
 
-            static void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool SCC)
+            static constexpr void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool SCC)
             {
                 D = SCC ? S0 : S1;
             }
@@ -282,7 +270,7 @@ namespace vega
             static constexpr const char* NAME = "S_AND_B32";
             static constexpr const char* DESK = "Bitwise AND 32-bit.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 D = S0 & S1;
                 SCC = (D != 0);
@@ -297,7 +285,7 @@ namespace vega
             static constexpr const char* NAME = "S_AND_B64";
             static constexpr const char* DESK = "Bitwise AND 64-bit.";
 
-            static void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
+            static constexpr void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
             {
                 D = S0 & S1;
                 SCC = (D != 0);
@@ -312,7 +300,7 @@ namespace vega
             static constexpr const char* NAME = "S_OR_B32";
             static constexpr const char* DESK = "Bitwise OR 32-bit.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 D = S0 | S1;
                 SCC = (D != 0);
@@ -327,7 +315,7 @@ namespace vega
             static constexpr const char* NAME = "S_OR_B64";
             static constexpr const char* DESK = "Bitwise OR 64-bit.";
 
-            static void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
+            static constexpr void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
             {
                 D = S0 | S1;
                 SCC = (D != 0);
@@ -342,7 +330,7 @@ namespace vega
             static constexpr const char* NAME = "S_XOR_B32";
             static constexpr const char* DESK = "Bitwise XOR 32-bit.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 D = S0 ^ S1;
                 SCC = (D != 0);
@@ -357,7 +345,7 @@ namespace vega
             static constexpr const char* NAME = "S_XOR_B64";
             static constexpr const char* DESK = "Bitwise XOR 64-bit.";
 
-            static void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
+            static constexpr void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
             {
                 D = S0 ^ S1;
                 SCC = (D != 0);
@@ -372,7 +360,7 @@ namespace vega
             static constexpr const char* NAME = "S_ANDN2_B32";
             static constexpr const char* DESK = "Bitwise AND with inverted S1 32-bit.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 D = S0 & ~S1;
                 SCC = (D != 0);
@@ -387,7 +375,7 @@ namespace vega
             static constexpr const char* NAME = "S_ANDN2_B64";
             static constexpr const char* DESK = "Bitwise AND with inverted S1 64-bit.";
 
-            static void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
+            static constexpr void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
             {
                 D = S0 & ~S1;
                 SCC = (D != 0);
@@ -402,7 +390,7 @@ namespace vega
             static constexpr const char* NAME = "S_ORN2_B32";
             static constexpr const char* DESK = "Bitwise OR with inverted S1 32-bit.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 D = S0 | ~S1;
                 SCC = (D != 0);
@@ -417,7 +405,7 @@ namespace vega
             static constexpr const char* NAME = "S_ORN2_B64";
             static constexpr const char* DESK = "Bitwise OR with inverted S1 64-bit.";
 
-            static void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
+            static constexpr void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
             {
                 D = S0 | ~S1;
                 SCC = (D != 0);
@@ -432,7 +420,7 @@ namespace vega
             static constexpr const char* NAME = "S_NAND_B32";
             static constexpr const char* DESK = "Bitwise NAND 32-bit.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 D = ~(S0 & S1);
                 SCC = (D != 0);
@@ -447,7 +435,7 @@ namespace vega
             static constexpr const char* NAME = "S_NAND_B64";
             static constexpr const char* DESK = "Bitwise NAND 64-bit.";
 
-            static void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
+            static constexpr void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
             {
                 D = ~(S0 & S1);
                 SCC = (D != 0);
@@ -462,7 +450,7 @@ namespace vega
             static constexpr const char* NAME = "S_NOR_B32";
             static constexpr const char* DESK = "Bitwise NOR 32-bit.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 D = ~(S0 | S1);
                 SCC = (D != 0);
@@ -477,7 +465,7 @@ namespace vega
             static constexpr const char* NAME = "S_NOR_B64";
             static constexpr const char* DESK = "Bitwise NOR 64-bit.";
 
-            static void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
+            static constexpr void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
             {
                 D = ~(S0 | S1);
                 SCC = (D != 0);
@@ -492,7 +480,7 @@ namespace vega
             static constexpr const char* NAME = "S_XNOR_B32";
             static constexpr const char* DESK = "Bitwise XNOR 32-bit.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 D = ~(S0 ^ S1);
                 SCC = (D != 0);
@@ -507,7 +495,7 @@ namespace vega
             static constexpr const char* NAME = "S_XNOR_B64";
             static constexpr const char* DESK = "Bitwise XNOR 64-bit.";
 
-            static void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
+            static constexpr void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
             {
                 D = ~(S0 ^ S1);
                 SCC = (D != 0);
@@ -522,7 +510,7 @@ namespace vega
             static constexpr const char* NAME = "S_LSHL_B32";
             static constexpr const char* DESK = "Logical shift left 32-bit.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 uint32_t shift_amount = S1 & 0x1F; // Маска 4:0 (от 0 до 31 бита)
                 D = S0 << shift_amount;
@@ -538,7 +526,7 @@ namespace vega
             static constexpr const char* NAME = "S_LSHL_B64";
             static constexpr const char* DESK = "Logical shift left 64-bit.";
 
-            static void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
+            static constexpr void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
             {
                 uint32_t shift_amount = S1 & 0x3F; // Маска 5:0 (от 0 до 63 бит)
                 D = S0 << shift_amount;
@@ -554,7 +542,7 @@ namespace vega
             static constexpr const char* NAME = "S_LSHR_B32";
             static constexpr const char* DESK = "Logical shift right 32-bit.";
 
-            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
+            static constexpr void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool& SCC)
             {
                 uint32_t shift_amount = S1 & 0x1F;
                 D = S0 >> shift_amount;
@@ -570,7 +558,7 @@ namespace vega
             static constexpr const char* NAME = "S_LSHR_B64";
             static constexpr const char* DESK = "Logical shift right 64-bit.";
 
-            static void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
+            static constexpr void execute(uint64_t S0, uint64_t S1, uint64_t& D, bool& SCC)
             {
                 uint32_t shift_amount = S1 & 0x3F;
                 D = S0 >> shift_amount;
@@ -578,6 +566,14 @@ namespace vega
             }
             static constexpr uint32_t hex() { return BASE | (ID << 23); }
         };
+
+        using ALL = InstructionList<
+            S_ADD_U32, S_SUB_U32, S_ADD_I32, S_SUB_I32, S_ADDC_U32, S_SUBB_U32,
+            S_MIN_I32, S_MIN_U32, S_MAX_I32, S_MAX_U32, S_CSELECT_B32, S_CSELECT_B64,
+            S_AND_B32, S_AND_B64, S_OR_B32, S_OR_B64, S_XOR_B32, S_XOR_B64,
+            S_ANDN2_B32, S_ANDN2_B64, S_ORN2_B32, S_ORN2_B64, S_NAND_B32, S_NAND_B64,
+            S_NOR_B32, S_NOR_B64, S_XNOR_B32, S_XNOR_B64,
+            S_LSHL_B32, S_LSHL_B64, S_LSHR_B32, S_LSHR_B64>;
     };
 
 	namespace SOP1 // Base: 0xBE800000
@@ -589,7 +585,7 @@ namespace vega
 			static constexpr uint8_t  ID = 0;
 			static constexpr int LATENCY = 1;
 			static constexpr const char* NAME = "S_MOV_B32";
-			static void execute(uint32_t S0, uint32_t& D) 
+			static constexpr void execute(uint32_t S0, uint32_t& D) 
 			{
 				D = S0;
 			}
@@ -601,11 +597,9 @@ namespace vega
 			static constexpr uint8_t  ID = 1;
 			static constexpr int LATENCY = 1;
 			static constexpr const char* NAME = "S_MOV_B64";
-			static void execute(uint64_t S0, uint32_t* SGPR, uint8_t SDST) 
+			static constexpr void execute(uint64_t S0, uint64_t& D) 
 			{
-				SGPR[SDST]     = static_cast<uint32_t>(S0 & 0xFFFFFFFF);
-			
-				SGPR[SDST + 1] = static_cast<uint32_t>(S0 >> 32);
+				D = S0;
 			}
 			static constexpr uint32_t hex() { return BASE | (ID << 8); }
 		};
@@ -615,7 +609,7 @@ namespace vega
 			static constexpr uint8_t  ID = 2;
 			static constexpr int LATENCY = 1;
 			static constexpr const char* NAME = "S_CMOV_B32";
-			static void execute(uint32_t S0, uint32_t& D, bool SCC)
+			static constexpr void execute(uint32_t S0, uint32_t& D, bool SCC)
 			{
 				if (SCC)
 				{
@@ -630,12 +624,11 @@ namespace vega
 			static constexpr uint8_t  ID = 3;
 			static constexpr int LATENCY = 1;
 			static constexpr const char* NAME = "S_CMOV_B64";
-			static void execute(uint64_t S0, uint32_t* SGPR, uint8_t SDST, bool SCC)
+			static constexpr void execute(uint64_t S0, uint64_t& D, bool SCC)
 			{
 				if (SCC)
 				{
-					SGPR[SDST]     = static_cast<uint32_t>(S0 & 0xFFFFFFFF);
-					SGPR[SDST + 1] = static_cast<uint32_t>(S0 >> 32);
+					D = S0;
 				}
 			}
 			static constexpr uint32_t hex() { return BASE | (ID << 8); }
@@ -646,7 +639,7 @@ namespace vega
 			static constexpr uint8_t  ID = 4;
 			static constexpr int LATENCY = 1;
 			static constexpr const char* NAME = "S_NOT_B32";
-			static void execute(uint32_t S0, uint32_t& D, bool& SCC)
+			static constexpr void execute(uint32_t S0, uint32_t& D, bool& SCC)
 			{
 				D = ~S0;
 				SCC = (D != 0);
@@ -659,12 +652,10 @@ namespace vega
 			static constexpr uint8_t  ID = 5;
 			static constexpr int LATENCY = 1;
 			static constexpr const char* NAME = "S_NOT_B64";
-			static void execute(uint64_t S0, uint32_t* SGPR, uint8_t SDST, bool& SCC)
+			static constexpr void execute(uint64_t S0, uint64_t& D, bool& SCC)
 			{
-				uint64_t result = ~S0;
-				SGPR[SDST]     = static_cast<uint32_t>(result & 0xFFFFFFFF);
-			   SGPR[SDST + 1] = static_cast<uint32_t>(result >> 32);
-				SCC = (result != 0);
+				D = ~S0;
+				SCC = (D != 0);
 			}
 			static constexpr uint32_t hex() { return BASE | (ID << 8); }
 		};
@@ -675,18 +666,9 @@ namespace vega
 			static constexpr int LATENCY = 1;
 			static constexpr const char* NAME = "S_WQM_B32";
 
-			static void execute(uint32_t S0, uint32_t& D, bool& SCC) 
+			static constexpr void execute(uint32_t S0, uint32_t& D, bool& SCC) 
 			{
-				uint32_t result = 0;
-				for (int q = 0; q < 8; ++q) 
-				{
-					uint32_t quad_mask = (0xF << (q * 4)); 
-					if (S0 & quad_mask) 
-					{
-						result |= quad_mask;
-					}
-				}
-				D = result;
+				D = bits::whole_quad(S0);
 				SCC = (D != 0);
 			}
 			static constexpr uint32_t hex() { return BASE | (ID << 8); }
@@ -698,20 +680,10 @@ namespace vega
 			static constexpr int LATENCY = 1;
 			static constexpr const char* NAME = "S_WQM_B64";
 
-			static void execute(uint64_t S0, uint32_t* SGPR, uint8_t SDST, bool& SCC) 
+			static constexpr void execute(uint64_t S0, uint64_t& D, bool& SCC) 
 			{
-				uint64_t result = 0;
-				for (int q = 0; q < 16; ++q) 
-				{
-					uint64_t quad_mask = (0xFULL << (q * 4));
-					if (S0 & quad_mask) 
-					{
-						result |= quad_mask;
-					}
-				}
-				SGPR[SDST]     = static_cast<uint32_t>(result & 0xFFFFFFFF);
-				SGPR[SDST + 1] = static_cast<uint32_t>(result >> 32);
-				SCC = (result != 0);
+				D = bits::whole_quad(S0);
+				SCC = (D != 0);
 			}
 			static constexpr uint32_t hex() { return BASE | (ID << 8); }
 		};
@@ -723,14 +695,9 @@ namespace vega
 			static constexpr const char* NAME = "S_BREV_B32";
 			static constexpr const char* DESC = "Reverse bits.";
 
-			static void execute(uint32_t S0, uint32_t& D) 
+			static constexpr void execute(uint32_t S0, uint32_t& D) 
 			{
-				uint32_t result = 0;
-				for (int i = 0; i < 32; ++i) 
-				{
-					if ((S0 >> i) & 1) result |= (1U << (31 - i));
-				}
-				D = result;
+				D = bits::reverse(S0);
 			}
 			static constexpr uint32_t hex() { return BASE | (ID << 8); }
 		};
@@ -742,18 +709,9 @@ namespace vega
 			static constexpr const char* NAME = "S_BREV_B64";
 			static constexpr const char* DESC = "Reverse bits.";
 
-			static void execute(uint64_t S0, uint32_t* SGPR, uint8_t SDST)
+			static constexpr void execute(uint64_t S0, uint64_t& D)
 			{
-				uint64_t result = 0;
-				for (int i = 0; i < 64; ++i)
-				{
-					if ((S0 >> i) & 1ULL)
-					{	
-						result |= (1ULL << (63 - i));
-					}
-				}
-				SGPR[SDST]	   = static_cast<uint32_t>(result & 0xFFFFFFFF);
-				SGPR[SDST + 1] = static_cast<uint32_t>(result >> 32);
+				D = bits::reverse(S0);
 			}
 			static constexpr uint32_t hex() { return BASE | (ID << 8); }
 		};
@@ -765,17 +723,9 @@ namespace vega
 			static constexpr const char* NAME = "S_BCNT0_I32_B32";
 			static constexpr const char* DESC = "Bit Count 0 (zero).";
 
-			static void execute(uint32_t S0, uint32_t& D, bool& SCC)
+			static constexpr void execute(uint32_t S0, uint32_t& D, bool& SCC)
 			{
-				uint32_t result = 0;
-				for (int i = 0; i < 32; ++i)
-				{
-					if (((S0 >> i) & 1) ==0)
-					{
-						result++;
-					}
-				}
-				D	= result;
+				D   = bits::count_zeros(S0);
 				SCC = (D != 0);
 			}
 			static constexpr uint32_t hex() { return BASE | (ID << 8); }
@@ -788,19 +738,11 @@ namespace vega
 			static constexpr const char* NAME = "S_BCNT0_I32_B64";
 			static constexpr const char* DESC = "Bit Count 0 (zero).";
 
-			static void execute(uint64_t S0, uint32_t& D, bool& SCC)
-            {
-                uint32_t result = 0;
-                for (int i = 0; i < 64; ++i)
-                {
-                    if (((S0 >> i) & 1ULL) == 0)
-                    {
-                        result++;
-                    }
-                }
-                D = result;
-                SCC = (D != 0);
-            }
+			static constexpr void execute(uint64_t S0, uint32_t& D, bool& SCC)
+			{
+				D   = bits::count_zeros(S0);
+				SCC = (D != 0);
+			}
 			static constexpr uint32_t hex() { return BASE | (ID << 8); }
 		};
 
@@ -811,17 +753,9 @@ namespace vega
 			static constexpr const char* NAME = "S_BCNT1_I32_B32";
 			static constexpr const char* DESC = "Bit Count 1 (ones).";
 
-			static void execute(uint32_t S0, uint32_t& D, bool& SCC)
+			static constexpr void execute(uint32_t S0, uint32_t& D, bool& SCC)
 			{
-				uint32_t result = 0;
-				for (int i = 0; i < 32; ++i)
-				{
-					if (((S0 >> i) & 1) ==1)
-					{
-						result++;
-					}
-				}
-				D  = result;
+				D   = bits::count_ones(S0);
 				SCC = (D != 0);
 			}
 			static constexpr uint32_t hex() { return BASE | (ID << 8); }
@@ -834,19 +768,11 @@ namespace vega
 			static constexpr const char* NAME = "S_BCNT1_I32_B64";
 			static constexpr const char* DESC = "Bit Count 1 (ones).";
 
-			static void execute(uint64_t S0, uint32_t& D, bool& SCC)
-            {
-                uint32_t result = 0;
-                for (int i = 0; i < 64; ++i)
-                {
-                    if (((S0 >> i) & 1ULL) == 1)
-                    {
-                        result++;
-                    }
-                }
-                D = result;
-                SCC = (D != 0);
-            }
+			static constexpr void execute(uint64_t S0, uint32_t& D, bool& SCC)
+			{
+				D   = bits::count_ones(S0);
+				SCC = (D != 0);
+			}
 			static constexpr uint32_t hex() { return BASE | (ID << 8); }
 		};
 
@@ -857,30 +783,11 @@ namespace vega
 			static constexpr const char* NAME = "S_FF0_I32_B32";
 			static constexpr const char* DESK = "Find First 0 (zero).";
 
-			static void execute(uint32_t S0, uint32_t& D) 
-            {
-                if (S0 == 0xFFFFFFFF) 
-                {
-                    D = 0xFFFFFFFF;
-                }
-                else 
-                {
-                  #if defined (__GNUC__) || defined (__clang__)
-                    D = static_cast<uint32_t>(__builtin_ctz(~S0));
-                  #else
-                    uint32_t result = 0;
-                    for (int i = 0; i < 32; ++i) 
-                    {
-                        if (((S0 >> i) & 1) == 0) 
-                        {
-                            result = i;
-                            break;
-                        }
-                    }
-                    D = result;
-				  #endif
-                }
-            }
+			static constexpr void execute(uint32_t S0, uint32_t& D) 
+			{
+				D = bits::find_first_one(~S0);
+			}
+			static constexpr uint32_t hex() { return BASE | (ID << 8); }
 		};
 
         struct S_FF0_I32_B64 // Opcode: 15
@@ -890,23 +797,9 @@ namespace vega
 			static constexpr const char* NAME = "S_FF0_I32_B64";
 			static constexpr const char* DESK = "Find First 0 (zero).";
 
-            static void execute(uint64_t S0, uint32_t& D)
+            static constexpr void execute(uint64_t S0, uint32_t& D)
             {
-                if (S0 == 0xFFFFFFFFFFFFFFFFULL) 
-                {
-                    D = 0xFFFFFFFF;
-                }
-                else 
-                {
-                    for (int i = 0; i < 64; ++i) 
-                    {
-                        if (((S0 >> i) & 1) == 0) 
-                        {
-                            D = static_cast<uint32_t>(i);
-                            return;
-                        }
-                    }
-                }
+                D = bits::find_first_one(~S0);
             }
             static constexpr uint32_t hex() { return BASE | (ID << 8); }
         };
@@ -915,26 +808,12 @@ namespace vega
         {
             static constexpr uint8_t  ID = 16;
 			static constexpr int LATENCY = 1;
-			static constexpr const char* NAME = "S_FF0_I32_B32";
+			static constexpr const char* NAME = "S_FF1_I32_B32";
 			static constexpr const char* DESK = "Find First 1 (one).";
 
-            static void execute(uint32_t S0, uint32_t& D)
+            static constexpr void execute(uint32_t S0, uint32_t& D)
             {
-                if (S0 == 0) 
-                {
-                    D = 0xFFFFFFFF;
-                }
-                else 
-                {
-                    for (int i = 0; i < 32; ++i) 
-                    {
-                        if (((S0 >> i) & 1) == 1) 
-                        {
-                            D = static_cast<uint32_t>(i);
-                            return;
-                        }
-                    }
-                }
+                D = bits::find_first_one(S0);
             }
             static constexpr uint32_t hex() { return BASE | (ID << 8); }
         };
@@ -946,23 +825,9 @@ namespace vega
             static constexpr const char* NAME = "S_FF1_I32_B64";
             static constexpr const char* DESK = "Find first 1 (one).";
 
-            static void execute(uint64_t S0, uint32_t& D)
+            static constexpr void execute(uint64_t S0, uint32_t& D)
             {
-                if (S0 == 0) 
-                {
-                  D = 0xFFFFFFFF;
-                }
-                else 
-                {
-                    for (int i = 0; i < 64; ++i) 
-                    {
-                        if (((S0 >> i) & 1) == 1) 
-                        {
-                            D = static_cast<uint32_t>(i);
-                            return;
-                        }
-                    }
-                }
+                D = bits::find_first_one(S0);
             }
             static constexpr uint32_t hex() { return BASE | (ID << 8); }
         };
@@ -974,23 +839,9 @@ namespace vega
             static constexpr const char* NAME = "S_FLBIT_I32_B32";
             static constexpr const char* DESK = "Find last bit (count leading zeros) in 32-bit value.";
 
-            static void execute(uint32_t S0, uint32_t& D)
+            static constexpr void execute(uint32_t S0, uint32_t& D)
             {
-                if (S0 == 0) 
-                {
-                    D = 0xFFFFFFFF;
-                }
-                else 
-                {
-                    for (int i = 31; i >= 0; --i) 
-                    {
-                        if (((S0 >> i) & 1) == 1) 
-                        {
-                            D = static_cast<uint32_t>(31 - i);
-                            return;
-                        }
-                    }
-                }
+                D = bits::find_last_one(S0);
             }
             static constexpr uint32_t hex() { return BASE | (ID << 8); }
         };
@@ -1002,25 +853,1215 @@ namespace vega
             static constexpr const char* NAME = "S_FLBIT_I32_B64";
             static constexpr const char* DESK = "Find last bit (count leading zeros) in 64-bit value.";
 
-            static void execute(uint64_t S0, uint32_t& D)
+            static constexpr void execute(uint64_t S0, uint32_t& D)
             {
-                if (S0 == 0) 
-                {
-                    D = 0xFFFFFFFF;
-                }
-                else 
-                {
-                    for (int i = 63; i >= 0; --i) 
-                    {
-                        if (((S0 >> i) & 1ULL) == 1) 
-                        {
-                            D = static_cast<uint32_t>(63 - i);
-                            return;
-                        }
-                    }
-                }
+                D = bits::find_last_one(S0);
             }
             static constexpr uint32_t hex() { return BASE | (ID << 8); }
         };
+
+        using ALL = InstructionList<
+            S_MOV_B32, S_MOV_B64, S_CMOV_B32, S_CMOV_B64, S_NOT_B32, S_NOT_B64,
+            S_WQM_B32, S_WQM_B64, S_BREV_B32, S_BREV_B64,
+            S_BCNT0_I32_B32, S_BCNT0_I32_B64, S_BCNT1_I32_B32, S_BCNT1_I32_B64,
+            S_FF0_I32_B32, S_FF0_I32_B64, S_FF1_I32_B32, S_FF1_I32_B64,
+            S_FLBIT_I32_B32, S_FLBIT_I32_B64>;
     };	    
+
+    namespace VOP2 // Base: 0x00000000, one execute() per lane
+    {
+        static constexpr uint32_t BASE = 0x00000000;
+
+        struct V_CNDMASK_B32 // Opcode: 0
+        {
+            static constexpr uint8_t  ID = 0;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_CNDMASK_B32";
+            static constexpr const char* DESK = "Select S1 where the lane's VCC bit is set, else S0.";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D, bool VCC)
+            {
+                D = VCC ? S1 : S0;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_ADD_F32 // Opcode: 1
+        {
+            static constexpr uint8_t  ID = 1;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_ADD_F32";
+            static constexpr const char* DESK = "Add two single-precision floats.";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = std::bit_cast<uint32_t>(std::bit_cast<float>(S0) + std::bit_cast<float>(S1));
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_SUB_F32 // Opcode: 2
+        {
+            static constexpr uint8_t  ID = 2;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_SUB_F32";
+            static constexpr const char* DESK = "Sub single-precision floats, S0 - S1.";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = std::bit_cast<uint32_t>(std::bit_cast<float>(S0) - std::bit_cast<float>(S1));
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_SUBREV_F32 // Opcode: 3
+        {
+            static constexpr uint8_t  ID = 3;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_SUBREV_F32";
+            static constexpr const char* DESK = "Reverse sub single-precision floats, S1 - S0.";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = std::bit_cast<uint32_t>(std::bit_cast<float>(S1) - std::bit_cast<float>(S0));
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_MUL_F32 // Opcode: 5
+        {
+            static constexpr uint8_t  ID = 5;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_MUL_F32";
+            static constexpr const char* DESK = "Multiply single-precision floats.";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = std::bit_cast<uint32_t>(std::bit_cast<float>(S0) * std::bit_cast<float>(S1));
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_MIN_F32 // Opcode: 10
+        {
+            static constexpr uint8_t  ID = 10;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_MIN_F32";
+            static constexpr const char* DESK = "Minimum of single-precision floats.";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = std::bit_cast<uint32_t>(std::fmin(std::bit_cast<float>(S0), std::bit_cast<float>(S1)));
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_MAX_F32 // Opcode: 11
+        {
+            static constexpr uint8_t  ID = 11;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_MAX_F32";
+            static constexpr const char* DESK = "Maximum of single-precision floats.";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = std::bit_cast<uint32_t>(std::fmax(std::bit_cast<float>(S0), std::bit_cast<float>(S1)));
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_MIN_I32 // Opcode: 12
+        {
+            static constexpr uint8_t  ID = 12;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_MIN_I32";
+            static constexpr const char* DESK = "Minimum of signed 32-bit integers.";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = (static_cast<int32_t>(S0) < static_cast<int32_t>(S1)) ? S0 : S1;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_MAX_I32 // Opcode: 13
+        {
+            static constexpr uint8_t  ID = 13;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_MAX_I32";
+            static constexpr const char* DESK = "Maximum of signed 32-bit integers.";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = (static_cast<int32_t>(S0) > static_cast<int32_t>(S1)) ? S0 : S1;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_MIN_U32 // Opcode: 14
+        {
+            static constexpr uint8_t  ID = 14;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_MIN_U32";
+            static constexpr const char* DESK = "Minimum of unsigned 32-bit integers.";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = (S0 < S1) ? S0 : S1;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_MAX_U32 // Opcode: 15
+        {
+            static constexpr uint8_t  ID = 15;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_MAX_U32";
+            static constexpr const char* DESK = "Maximum of unsigned 32-bit integers.";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = (S0 > S1) ? S0 : S1;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_LSHRREV_B32 // Opcode: 16
+        {
+            static constexpr uint8_t  ID = 16;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_LSHRREV_B32";
+            static constexpr const char* DESK = "Logical shift right of S1 by S0[4:0].";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = S1 >> (S0 & 0x1F);
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_ASHRREV_I32 // Opcode: 17
+        {
+            static constexpr uint8_t  ID = 17;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_ASHRREV_I32";
+            static constexpr const char* DESK = "Arithmetic shift right of S1 by S0[4:0].";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = static_cast<uint32_t>(static_cast<int32_t>(S1) >> (S0 & 0x1F));
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_LSHLREV_B32 // Opcode: 18
+        {
+            static constexpr uint8_t  ID = 18;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_LSHLREV_B32";
+            static constexpr const char* DESK = "Logical shift left of S1 by S0[4:0].";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = S1 << (S0 & 0x1F);
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_AND_B32 // Opcode: 19
+        {
+            static constexpr uint8_t  ID = 19;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_AND_B32";
+            static constexpr const char* DESK = "Bitwise AND 32-bit.";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = S0 & S1;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_OR_B32 // Opcode: 20
+        {
+            static constexpr uint8_t  ID = 20;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_OR_B32";
+            static constexpr const char* DESK = "Bitwise OR 32-bit.";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = S0 | S1;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_XOR_B32 // Opcode: 21
+        {
+            static constexpr uint8_t  ID = 21;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_XOR_B32";
+            static constexpr const char* DESK = "Bitwise XOR 32-bit.";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = S0 ^ S1;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_ADD_U32 // Opcode: 52
+        {
+            static constexpr uint8_t  ID = 52;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_ADD_U32";
+            static constexpr const char* DESK = "Add unsigned 32-bit integers, no carry-out.";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = S0 + S1;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_SUB_U32 // Opcode: 53
+        {
+            static constexpr uint8_t  ID = 53;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_SUB_U32";
+            static constexpr const char* DESK = "Sub unsigned 32-bit integers, S0 - S1, no borrow-out.";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = S0 - S1;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        struct V_SUBREV_U32 // Opcode: 54
+        {
+            static constexpr uint8_t  ID = 54;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_SUBREV_U32";
+            static constexpr const char* DESK = "Reverse sub unsigned 32-bit integers, S1 - S0.";
+
+            static void execute(uint32_t S0, uint32_t S1, uint32_t& D)
+            {
+                D = S1 - S0;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 25); }
+        };
+
+        using ALL = InstructionList<
+            V_CNDMASK_B32, V_ADD_F32, V_SUB_F32, V_SUBREV_F32, V_MUL_F32, V_MIN_F32,
+            V_MAX_F32, V_MIN_I32, V_MAX_I32, V_MIN_U32, V_MAX_U32, V_LSHRREV_B32, V_ASHRREV_I32,
+            V_LSHLREV_B32, V_AND_B32, V_OR_B32, V_XOR_B32, V_ADD_U32, V_SUB_U32, V_SUBREV_U32>;
+    };
+
+    namespace VOP1 // Base: 0x7E000000, one execute() per lane
+    {
+        static constexpr uint32_t BASE = 0x7E000000;
+
+        struct V_NOP // Opcode: 0
+        {
+            static constexpr uint8_t  ID = 0;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_NOP";
+            static constexpr const char* DESK = "Do nothing.";
+
+            static void execute(uint32_t, uint32_t&) {}
+            static constexpr uint32_t hex() { return BASE | (ID << 9); }
+        };
+
+        struct V_MOV_B32 // Opcode: 1
+        {
+            static constexpr uint8_t  ID = 1;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_MOV_B32";
+            static constexpr const char* DESK = "Move 32-bit.";
+
+            static void execute(uint32_t S0, uint32_t& D)
+            {
+                D = S0;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 9); }
+        };
+
+        struct V_CVT_F32_I32 // Opcode: 5
+        {
+            static constexpr uint8_t  ID = 5;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_CVT_F32_I32";
+            static constexpr const char* DESK = "Convert signed 32-bit integer to float.";
+
+            static void execute(uint32_t S0, uint32_t& D)
+            {
+                D = std::bit_cast<uint32_t>(static_cast<float>(static_cast<int32_t>(S0)));
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 9); }
+        };
+
+        struct V_CVT_F32_U32 // Opcode: 6
+        {
+            static constexpr uint8_t  ID = 6;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_CVT_F32_U32";
+            static constexpr const char* DESK = "Convert unsigned 32-bit integer to float.";
+
+            static void execute(uint32_t S0, uint32_t& D)
+            {
+                D = std::bit_cast<uint32_t>(static_cast<float>(S0));
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 9); }
+        };
+
+        struct V_NOT_B32 // Opcode: 43
+        {
+            static constexpr uint8_t  ID = 43;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_NOT_B32";
+            static constexpr const char* DESK = "Bitwise negation 32-bit.";
+
+            static void execute(uint32_t S0, uint32_t& D)
+            {
+                D = ~S0;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 9); }
+        };
+
+        struct V_BFREV_B32 // Opcode: 44
+        {
+            static constexpr uint8_t  ID = 44;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "V_BFREV_B32";
+            static constexpr const char* DESK = "Reverse bits 32-bit.";
+
+            static void execute(uint32_t S0, uint32_t& D)
+            {
+                D = bits::reverse(S0);
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 9); }
+        };
+
+        using ALL = InstructionList<
+            V_NOP, V_MOV_B32, V_CVT_F32_I32, V_CVT_F32_U32, V_NOT_B32, V_BFREV_B32>;
+    };
+
+    namespace SOPC // Base: 0xBF000000, compares that only write SCC
+    {
+        static constexpr uint32_t BASE = 0xBF000000;
+
+        struct S_CMP_EQ_I32 // Opcode: 0
+        {
+            static constexpr uint8_t  ID = 0;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMP_EQ_I32";
+            static constexpr const char* DESK = "SCC = S0 == S1, signed 32-bit.";
+
+            static constexpr void execute(uint32_t S0, uint32_t S1, bool& SCC)
+            {
+                SCC = static_cast<int32_t>(S0) == static_cast<int32_t>(S1);
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CMP_LG_I32 // Opcode: 1
+        {
+            static constexpr uint8_t  ID = 1;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMP_LG_I32";
+            static constexpr const char* DESK = "SCC = S0 != S1, signed 32-bit.";
+
+            static constexpr void execute(uint32_t S0, uint32_t S1, bool& SCC)
+            {
+                SCC = static_cast<int32_t>(S0) != static_cast<int32_t>(S1);
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CMP_GT_I32 // Opcode: 2
+        {
+            static constexpr uint8_t  ID = 2;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMP_GT_I32";
+            static constexpr const char* DESK = "SCC = S0 > S1, signed 32-bit.";
+
+            static constexpr void execute(uint32_t S0, uint32_t S1, bool& SCC)
+            {
+                SCC = static_cast<int32_t>(S0) > static_cast<int32_t>(S1);
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CMP_GE_I32 // Opcode: 3
+        {
+            static constexpr uint8_t  ID = 3;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMP_GE_I32";
+            static constexpr const char* DESK = "SCC = S0 >= S1, signed 32-bit.";
+
+            static constexpr void execute(uint32_t S0, uint32_t S1, bool& SCC)
+            {
+                SCC = static_cast<int32_t>(S0) >= static_cast<int32_t>(S1);
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CMP_LT_I32 // Opcode: 4
+        {
+            static constexpr uint8_t  ID = 4;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMP_LT_I32";
+            static constexpr const char* DESK = "SCC = S0 < S1, signed 32-bit.";
+
+            static constexpr void execute(uint32_t S0, uint32_t S1, bool& SCC)
+            {
+                SCC = static_cast<int32_t>(S0) < static_cast<int32_t>(S1);
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CMP_LE_I32 // Opcode: 5
+        {
+            static constexpr uint8_t  ID = 5;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMP_LE_I32";
+            static constexpr const char* DESK = "SCC = S0 <= S1, signed 32-bit.";
+
+            static constexpr void execute(uint32_t S0, uint32_t S1, bool& SCC)
+            {
+                SCC = static_cast<int32_t>(S0) <= static_cast<int32_t>(S1);
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CMP_EQ_U32 // Opcode: 6
+        {
+            static constexpr uint8_t  ID = 6;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMP_EQ_U32";
+            static constexpr const char* DESK = "SCC = S0 == S1, unsigned 32-bit.";
+
+            static constexpr void execute(uint32_t S0, uint32_t S1, bool& SCC)
+            {
+                SCC = S0 == S1;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CMP_LG_U32 // Opcode: 7
+        {
+            static constexpr uint8_t  ID = 7;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMP_LG_U32";
+            static constexpr const char* DESK = "SCC = S0 != S1, unsigned 32-bit.";
+
+            static constexpr void execute(uint32_t S0, uint32_t S1, bool& SCC)
+            {
+                SCC = S0 != S1;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CMP_GT_U32 // Opcode: 8
+        {
+            static constexpr uint8_t  ID = 8;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMP_GT_U32";
+            static constexpr const char* DESK = "SCC = S0 > S1, unsigned 32-bit.";
+
+            static constexpr void execute(uint32_t S0, uint32_t S1, bool& SCC)
+            {
+                SCC = S0 > S1;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CMP_GE_U32 // Opcode: 9
+        {
+            static constexpr uint8_t  ID = 9;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMP_GE_U32";
+            static constexpr const char* DESK = "SCC = S0 >= S1, unsigned 32-bit.";
+
+            static constexpr void execute(uint32_t S0, uint32_t S1, bool& SCC)
+            {
+                SCC = S0 >= S1;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CMP_LT_U32 // Opcode: 10
+        {
+            static constexpr uint8_t  ID = 10;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMP_LT_U32";
+            static constexpr const char* DESK = "SCC = S0 < S1, unsigned 32-bit.";
+
+            static constexpr void execute(uint32_t S0, uint32_t S1, bool& SCC)
+            {
+                SCC = S0 < S1;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CMP_LE_U32 // Opcode: 11
+        {
+            static constexpr uint8_t  ID = 11;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMP_LE_U32";
+            static constexpr const char* DESK = "SCC = S0 <= S1, unsigned 32-bit.";
+
+            static constexpr void execute(uint32_t S0, uint32_t S1, bool& SCC)
+            {
+                SCC = S0 <= S1;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_BITCMP0_B32 // Opcode: 12
+        {
+            static constexpr uint8_t  ID = 12;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_BITCMP0_B32";
+            static constexpr const char* DESK = "SCC = bit S1[4:0] of S0 is 0.";
+
+            static constexpr void execute(uint32_t S0, uint32_t S1, bool& SCC)
+            {
+                SCC = ((S0 >> (S1 & 0x1F)) & 1) == 0;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_BITCMP1_B32 // Opcode: 13
+        {
+            static constexpr uint8_t  ID = 13;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_BITCMP1_B32";
+            static constexpr const char* DESK = "SCC = bit S1[4:0] of S0 is 1.";
+
+            static constexpr void execute(uint32_t S0, uint32_t S1, bool& SCC)
+            {
+                SCC = ((S0 >> (S1 & 0x1F)) & 1) != 0;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_BITCMP0_B64 // Opcode: 14
+        {
+            static constexpr uint8_t  ID = 14;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_BITCMP0_B64";
+            static constexpr const char* DESK = "SCC = bit S1[5:0] of S0 is 0.";
+
+            static constexpr void execute(uint64_t S0, uint32_t S1, bool& SCC)
+            {
+                SCC = ((S0 >> (S1 & 0x3F)) & 1) == 0;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_BITCMP1_B64 // Opcode: 15
+        {
+            static constexpr uint8_t  ID = 15;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_BITCMP1_B64";
+            static constexpr const char* DESK = "SCC = bit S1[5:0] of S0 is 1.";
+
+            static constexpr void execute(uint64_t S0, uint32_t S1, bool& SCC)
+            {
+                SCC = ((S0 >> (S1 & 0x3F)) & 1) != 0;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CMP_EQ_U64 // Opcode: 18
+        {
+            static constexpr uint8_t  ID = 18;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMP_EQ_U64";
+            static constexpr const char* DESK = "SCC = S0 == S1, 64-bit.";
+
+            static constexpr void execute(uint64_t S0, uint64_t S1, bool& SCC)
+            {
+                SCC = S0 == S1;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CMP_LG_U64 // Opcode: 19
+        {
+            static constexpr uint8_t  ID = 19;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMP_LG_U64";
+            static constexpr const char* DESK = "SCC = S0 != S1, 64-bit.";
+
+            static constexpr void execute(uint64_t S0, uint64_t S1, bool& SCC)
+            {
+                SCC = S0 != S1;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        using ALL = InstructionList<
+            S_CMP_EQ_I32, S_CMP_LG_I32, S_CMP_GT_I32, S_CMP_GE_I32, S_CMP_LT_I32, S_CMP_LE_I32,
+            S_CMP_EQ_U32, S_CMP_LG_U32, S_CMP_GT_U32, S_CMP_GE_U32, S_CMP_LT_U32, S_CMP_LE_U32,
+            S_BITCMP0_B32, S_BITCMP1_B32, S_BITCMP0_B64, S_BITCMP1_B64, S_CMP_EQ_U64, S_CMP_LG_U64>;
+    };
+
+    namespace SOPK // Base: 0xB0000000, SDST is also the first source; SIMM16 is the other
+    {
+        static constexpr uint32_t BASE = 0xB0000000;
+
+        constexpr uint32_t sign_extend(uint16_t SIMM16) { return static_cast<uint32_t>(static_cast<int32_t>(static_cast<int16_t>(SIMM16))); }
+
+        struct S_MOVK_I32 // Opcode: 0
+        {
+            static constexpr uint8_t  ID = 0;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_MOVK_I32";
+            static constexpr const char* DESK = "D = sign-extended SIMM16.";
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t& D)
+            {
+                D = sign_extend(SIMM16);
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 23); }
+        };
+
+        struct S_CMOVK_I32 // Opcode: 1
+        {
+            static constexpr uint8_t  ID = 1;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMOVK_I32";
+            static constexpr const char* DESK = "D = sign-extended SIMM16 if SCC.";
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t& D, bool SCC)
+            {
+                if (SCC)
+                {
+                    D = sign_extend(SIMM16);
+                }
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 23); }
+        };
+
+        struct S_CMPK_EQ_I32 // Opcode: 2
+        {
+            static constexpr uint8_t  ID = 2;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMPK_EQ_I32";
+            static constexpr const char* DESK = "SCC = D == sign-extended SIMM16, signed.";
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t D, bool& SCC)
+            {
+                SCC = static_cast<int32_t>(D) == static_cast<int32_t>(sign_extend(SIMM16));
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 23); }
+        };
+
+        struct S_CMPK_LG_I32 // Opcode: 3
+        {
+            static constexpr uint8_t  ID = 3;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMPK_LG_I32";
+            static constexpr const char* DESK = "SCC = D != sign-extended SIMM16, signed.";
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t D, bool& SCC)
+            {
+                SCC = static_cast<int32_t>(D) != static_cast<int32_t>(sign_extend(SIMM16));
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 23); }
+        };
+
+        struct S_CMPK_GT_I32 // Opcode: 4
+        {
+            static constexpr uint8_t  ID = 4;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMPK_GT_I32";
+            static constexpr const char* DESK = "SCC = D > sign-extended SIMM16, signed.";
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t D, bool& SCC)
+            {
+                SCC = static_cast<int32_t>(D) > static_cast<int32_t>(sign_extend(SIMM16));
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 23); }
+        };
+
+        struct S_CMPK_GE_I32 // Opcode: 5
+        {
+            static constexpr uint8_t  ID = 5;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMPK_GE_I32";
+            static constexpr const char* DESK = "SCC = D >= sign-extended SIMM16, signed.";
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t D, bool& SCC)
+            {
+                SCC = static_cast<int32_t>(D) >= static_cast<int32_t>(sign_extend(SIMM16));
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 23); }
+        };
+
+        struct S_CMPK_LT_I32 // Opcode: 6
+        {
+            static constexpr uint8_t  ID = 6;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMPK_LT_I32";
+            static constexpr const char* DESK = "SCC = D < sign-extended SIMM16, signed.";
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t D, bool& SCC)
+            {
+                SCC = static_cast<int32_t>(D) < static_cast<int32_t>(sign_extend(SIMM16));
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 23); }
+        };
+
+        struct S_CMPK_LE_I32 // Opcode: 7
+        {
+            static constexpr uint8_t  ID = 7;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMPK_LE_I32";
+            static constexpr const char* DESK = "SCC = D <= sign-extended SIMM16, signed.";
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t D, bool& SCC)
+            {
+                SCC = static_cast<int32_t>(D) <= static_cast<int32_t>(sign_extend(SIMM16));
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 23); }
+        };
+
+        struct S_CMPK_EQ_U32 // Opcode: 8
+        {
+            static constexpr uint8_t  ID = 8;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMPK_EQ_U32";
+            static constexpr const char* DESK = "SCC = D == zero-extended SIMM16, unsigned.";
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t D, bool& SCC)
+            {
+                SCC = D == uint32_t{ SIMM16 };
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 23); }
+        };
+
+        struct S_CMPK_LG_U32 // Opcode: 9
+        {
+            static constexpr uint8_t  ID = 9;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMPK_LG_U32";
+            static constexpr const char* DESK = "SCC = D != zero-extended SIMM16, unsigned.";
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t D, bool& SCC)
+            {
+                SCC = D != uint32_t{ SIMM16 };
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 23); }
+        };
+
+        struct S_CMPK_GT_U32 // Opcode: 10
+        {
+            static constexpr uint8_t  ID = 10;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMPK_GT_U32";
+            static constexpr const char* DESK = "SCC = D > zero-extended SIMM16, unsigned.";
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t D, bool& SCC)
+            {
+                SCC = D > uint32_t{ SIMM16 };
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 23); }
+        };
+
+        struct S_CMPK_GE_U32 // Opcode: 11
+        {
+            static constexpr uint8_t  ID = 11;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMPK_GE_U32";
+            static constexpr const char* DESK = "SCC = D >= zero-extended SIMM16, unsigned.";
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t D, bool& SCC)
+            {
+                SCC = D >= uint32_t{ SIMM16 };
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 23); }
+        };
+
+        struct S_CMPK_LT_U32 // Opcode: 12
+        {
+            static constexpr uint8_t  ID = 12;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMPK_LT_U32";
+            static constexpr const char* DESK = "SCC = D < zero-extended SIMM16, unsigned.";
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t D, bool& SCC)
+            {
+                SCC = D < uint32_t{ SIMM16 };
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 23); }
+        };
+
+        struct S_CMPK_LE_U32 // Opcode: 13
+        {
+            static constexpr uint8_t  ID = 13;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CMPK_LE_U32";
+            static constexpr const char* DESK = "SCC = D <= zero-extended SIMM16, unsigned.";
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t D, bool& SCC)
+            {
+                SCC = D <= uint32_t{ SIMM16 };
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 23); }
+        };
+
+        struct S_ADDK_I32 // Opcode: 14
+        {
+            static constexpr uint8_t  ID = 14;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_ADDK_I32";
+            static constexpr const char* DESK = "D += sign-extended SIMM16, SCC = signed overflow.";
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t& D, bool& SCC)
+            {
+                const uint32_t S0 = D;
+                const uint32_t S1 = sign_extend(SIMM16);
+                D = S0 + S1;
+                SCC = (S0 >> 31) == (S1 >> 31) && (S0 >> 31) != (D >> 31);
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 23); }
+        };
+
+        struct S_MULK_I32 // Opcode: 15
+        {
+            static constexpr uint8_t  ID = 15;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_MULK_I32";
+            static constexpr const char* DESK = "D *= sign-extended SIMM16.";
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t& D)
+            {
+                D = D * sign_extend(SIMM16);
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 23); }
+        };
+
+        using ALL = InstructionList<
+            S_MOVK_I32, S_CMOVK_I32,
+            S_CMPK_EQ_I32, S_CMPK_LG_I32, S_CMPK_GT_I32, S_CMPK_GE_I32, S_CMPK_LT_I32, S_CMPK_LE_I32,
+            S_CMPK_EQ_U32, S_CMPK_LG_U32, S_CMPK_GT_U32, S_CMPK_GE_U32, S_CMPK_LT_U32, S_CMPK_LE_U32,
+            S_ADDK_I32, S_MULK_I32>;
+    };
+
+    // PC is the address of the next instruction when execute() runs; a taken branch adds
+    // SIMM16 dwords to it. Conditional branches test the state named by CONDITION.
+    namespace SOPP // Base: 0xBF800000
+    {
+        static constexpr uint32_t BASE = 0xBF800000;
+
+        static constexpr uint32_t END_PC = 0xFFFFFFFF; // S_ENDPGM: past any program
+
+        enum class Condition : uint8_t
+        {
+            SCC,
+            VCCZ,  // VCC == 0
+            EXECZ, // EXEC == 0
+        };
+
+        constexpr uint32_t branch_offset(uint16_t SIMM16) { return static_cast<uint32_t>(static_cast<int32_t>(static_cast<int16_t>(SIMM16)) * 4); }
+
+        struct S_NOP // Opcode: 0
+        {
+            static constexpr uint8_t  ID = 0;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_NOP";
+            static constexpr const char* DESK = "Do nothing for SIMM16[3:0] + 1 wait states.";
+
+            static constexpr void execute(uint16_t) {}
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_ENDPGM // Opcode: 1
+        {
+            static constexpr uint8_t  ID = 1;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_ENDPGM";
+            static constexpr const char* DESK = "End of program; terminate the wavefront.";
+
+            static constexpr void execute(uint16_t, uint32_t& PC)
+            {
+                PC = END_PC;
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_BRANCH // Opcode: 2
+        {
+            static constexpr uint8_t  ID = 2;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_BRANCH";
+            static constexpr const char* DESK = "PC = PC + signext(SIMM16 * 4) + 4.";
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t& PC)
+            {
+                PC += branch_offset(SIMM16);
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CBRANCH_SCC0 // Opcode: 4
+        {
+            static constexpr uint8_t  ID = 4;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CBRANCH_SCC0";
+            static constexpr const char* DESK = "Branch if SCC is 0.";
+            static constexpr Condition CONDITION = Condition::SCC;
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t& PC, bool SCC)
+            {
+                if (!SCC)
+                {
+                    PC += branch_offset(SIMM16);
+                }
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CBRANCH_SCC1 // Opcode: 5
+        {
+            static constexpr uint8_t  ID = 5;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CBRANCH_SCC1";
+            static constexpr const char* DESK = "Branch if SCC is 1.";
+            static constexpr Condition CONDITION = Condition::SCC;
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t& PC, bool SCC)
+            {
+                if (SCC)
+                {
+                    PC += branch_offset(SIMM16);
+                }
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CBRANCH_VCCZ // Opcode: 6
+        {
+            static constexpr uint8_t  ID = 6;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CBRANCH_VCCZ";
+            static constexpr const char* DESK = "Branch if VCC is 0.";
+            static constexpr Condition CONDITION = Condition::VCCZ;
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t& PC, bool VCCZ)
+            {
+                if (VCCZ)
+                {
+                    PC += branch_offset(SIMM16);
+                }
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CBRANCH_VCCNZ // Opcode: 7
+        {
+            static constexpr uint8_t  ID = 7;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CBRANCH_VCCNZ";
+            static constexpr const char* DESK = "Branch if VCC is not 0.";
+            static constexpr Condition CONDITION = Condition::VCCZ;
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t& PC, bool VCCZ)
+            {
+                if (!VCCZ)
+                {
+                    PC += branch_offset(SIMM16);
+                }
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CBRANCH_EXECZ // Opcode: 8
+        {
+            static constexpr uint8_t  ID = 8;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CBRANCH_EXECZ";
+            static constexpr const char* DESK = "Branch if EXEC is 0.";
+            static constexpr Condition CONDITION = Condition::EXECZ;
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t& PC, bool EXECZ)
+            {
+                if (EXECZ)
+                {
+                    PC += branch_offset(SIMM16);
+                }
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_CBRANCH_EXECNZ // Opcode: 9
+        {
+            static constexpr uint8_t  ID = 9;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_CBRANCH_EXECNZ";
+            static constexpr const char* DESK = "Branch if EXEC is not 0.";
+            static constexpr Condition CONDITION = Condition::EXECZ;
+
+            static constexpr void execute(uint16_t SIMM16, uint32_t& PC, bool EXECZ)
+            {
+                if (!EXECZ)
+                {
+                    PC += branch_offset(SIMM16);
+                }
+            }
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        struct S_WAITCNT // Opcode: 12
+        {
+            static constexpr uint8_t  ID = 12;
+            static constexpr int LATENCY = 1;
+            static constexpr const char* NAME = "S_WAITCNT";
+            static constexpr const char* DESK = "Wait for outstanding memory counters; loads complete at issue here.";
+
+            static constexpr void execute(uint16_t) {}
+            static constexpr uint32_t hex() { return BASE | (ID << 16); }
+        };
+
+        using ALL = InstructionList<
+            S_NOP, S_ENDPGM, S_BRANCH, S_CBRANCH_SCC0, S_CBRANCH_SCC1,
+            S_CBRANCH_VCCZ, S_CBRANCH_VCCNZ, S_CBRANCH_EXECZ, S_CBRANCH_EXECNZ, S_WAITCNT>;
+    };
+
+    // Scalar memory loads, two dwords: the second holds OFFSET [20:0] and SOFFSET [31:25].
+    // They have no execute(): execute_smem() (wavefront.hpp) copies DWORDS dwords from the
+    // wavefront's memory into SDATA.. in one go. BUFFER loads take their base address and
+    // NUM_RECORDS from the four-SGPR buffer descriptor at SBASE.
+    namespace SMEM // Base: 0xC0000000
+    {
+        static constexpr uint32_t BASE = 0xC0000000;
+
+        struct S_LOAD_DWORD // Opcode: 0
+        {
+            static constexpr uint8_t  ID = 0;
+            static constexpr int LATENCY = 8;
+            static constexpr const char* NAME = "S_LOAD_DWORD";
+            static constexpr const char* DESK = "SDATA = 1 dword at SBASE[0:1] + OFFSET.";
+            static constexpr int  DWORDS = 1;
+            static constexpr bool BUFFER = false;
+
+            static constexpr uint32_t hex() { return BASE | (ID << 18); }
+        };
+
+        struct S_LOAD_DWORDX2 // Opcode: 1
+        {
+            static constexpr uint8_t  ID = 1;
+            static constexpr int LATENCY = 8;
+            static constexpr const char* NAME = "S_LOAD_DWORDX2";
+            static constexpr const char* DESK = "SDATA = 2 dwords at SBASE[0:1] + OFFSET.";
+            static constexpr int  DWORDS = 2;
+            static constexpr bool BUFFER = false;
+
+            static constexpr uint32_t hex() { return BASE | (ID << 18); }
+        };
+
+        struct S_LOAD_DWORDX4 // Opcode: 2
+        {
+            static constexpr uint8_t  ID = 2;
+            static constexpr int LATENCY = 8;
+            static constexpr const char* NAME = "S_LOAD_DWORDX4";
+            static constexpr const char* DESK = "SDATA = 4 dwords at SBASE[0:1] + OFFSET.";
+            static constexpr int  DWORDS = 4;
+            static constexpr bool BUFFER = false;
+
+            static constexpr uint32_t hex() { return BASE | (ID << 18); }
+        };
+
+        struct S_LOAD_DWORDX8 // Opcode: 3
+        {
+            static constexpr uint8_t  ID = 3;
+            static constexpr int LATENCY = 8;
+            static constexpr const char* NAME = "S_LOAD_DWORDX8";
+            static constexpr const char* DESK = "SDATA = 8 dwords at SBASE[0:1] + OFFSET.";
+            static constexpr int  DWORDS = 8;
+            static constexpr bool BUFFER = false;
+
+            static constexpr uint32_t hex() { return BASE | (ID << 18); }
+        };
+
+        struct S_LOAD_DWORDX16 // Opcode: 4
+        {
+            static constexpr uint8_t  ID = 4;
+            static constexpr int LATENCY = 8;
+            static constexpr const char* NAME = "S_LOAD_DWORDX16";
+            static constexpr const char* DESK = "SDATA = 16 dwords at SBASE[0:1] + OFFSET.";
+            static constexpr int  DWORDS = 16;
+            static constexpr bool BUFFER = false;
+
+            static constexpr uint32_t hex() { return BASE | (ID << 18); }
+        };
+
+        struct S_BUFFER_LOAD_DWORD // Opcode: 8
+        {
+            static constexpr uint8_t  ID = 8;
+            static constexpr int LATENCY = 8;
+            static constexpr const char* NAME = "S_BUFFER_LOAD_DWORD";
+            static constexpr const char* DESK = "SDATA = 1 dword of the buffer at SBASE[0:3] + OFFSET; dwords past NUM_RECORDS read 0.";
+            static constexpr int  DWORDS = 1;
+            static constexpr bool BUFFER = true;
+
+            static constexpr uint32_t hex() { return BASE | (ID << 18); }
+        };
+
+        struct S_BUFFER_LOAD_DWORDX2 // Opcode: 9
+        {
+            static constexpr uint8_t  ID = 9;
+            static constexpr int LATENCY = 8;
+            static constexpr const char* NAME = "S_BUFFER_LOAD_DWORDX2";
+            static constexpr const char* DESK = "SDATA = 2 dwords of the buffer at SBASE[0:3] + OFFSET; dwords past NUM_RECORDS read 0.";
+            static constexpr int  DWORDS = 2;
+            static constexpr bool BUFFER = true;
+
+            static constexpr uint32_t hex() { return BASE | (ID << 18); }
+        };
+
+        struct S_BUFFER_LOAD_DWORDX4 // Opcode: 10
+        {
+            static constexpr uint8_t  ID = 10;
+            static constexpr int LATENCY = 8;
+            static constexpr const char* NAME = "S_BUFFER_LOAD_DWORDX4";
+            static constexpr const char* DESK = "SDATA = 4 dwords of the buffer at SBASE[0:3] + OFFSET; dwords past NUM_RECORDS read 0.";
+            static constexpr int  DWORDS = 4;
+            static constexpr bool BUFFER = true;
+
+            static constexpr uint32_t hex() { return BASE | (ID << 18); }
+        };
+
+        struct S_BUFFER_LOAD_DWORDX8 // Opcode: 11
+        {
+            static constexpr uint8_t  ID = 11;
+            static constexpr int LATENCY = 8;
+            static constexpr const char* NAME = "S_BUFFER_LOAD_DWORDX8";
+            static constexpr const char* DESK = "SDATA = 8 dwords of the buffer at SBASE[0:3] + OFFSET; dwords past NUM_RECORDS read 0.";
+            static constexpr int  DWORDS = 8;
+            static constexpr bool BUFFER = true;
+
+            static constexpr uint32_t hex() { return BASE | (ID << 18); }
+        };
+
+        struct S_BUFFER_LOAD_DWORDX16 // Opcode: 12
+        {
+            static constexpr uint8_t  ID = 12;
+            static constexpr int LATENCY = 8;
+            static constexpr const char* NAME = "S_BUFFER_LOAD_DWORDX16";
+            static constexpr const char* DESK = "SDATA = 16 dwords of the buffer at SBASE[0:3] + OFFSET; dwords past NUM_RECORDS read 0.";
+            static constexpr int  DWORDS = 16;
+            static constexpr bool BUFFER = true;
+
+            static constexpr uint32_t hex() { return BASE | (ID << 18); }
+        };
+
+        using ALL = InstructionList<
+            S_LOAD_DWORD, S_LOAD_DWORDX2, S_LOAD_DWORDX4, S_LOAD_DWORDX8, S_LOAD_DWORDX16,
+            S_BUFFER_LOAD_DWORD, S_BUFFER_LOAD_DWORDX2, S_BUFFER_LOAD_DWORDX4, S_BUFFER_LOAD_DWORDX8, S_BUFFER_LOAD_DWORDX16>;
+    };
 }
@@ -0,0 +1,10 @@
+#include "wavefront.hpp"
+
+namespace vega
+{
+    Wavefront::Status Wavefront::run(std::span<const uint32_t> program)
+    {
+        NoObserver none;
+        return run(program, none);
+    }
+}
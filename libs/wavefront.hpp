@@ -0,0 +1,443 @@
+#pragma once
+
+#include "decoder.hpp"
+#include "memory.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+namespace vega
+{
+    template<typename F>
+    struct ExecuteTraits;
+
+    template<typename... A>
+    struct ExecuteTraits<void (*)(A...)>
+    {
+        static constexpr size_t ARITY = sizeof...(A);
+        template<size_t N>
+        using Arg = std::tuple_element_t<N, std::tuple<A...>>;
+    };
+
+    template<typename T>
+    using Execute = ExecuteTraits<decltype(&T::execute)>;
+
+    struct Translation;
+
+    struct Wavefront;
+
+    // Policy for the run loops: issue() sees each instruction before it executes, retire()
+    // right after. Both are empty here, so the plain run() compiles to the bare loop;
+    // CycleModel (timing.hpp) and Tracer (trace.hpp) are the instrumented ones.
+    struct NoObserver
+    {
+        void issue(const Wavefront&, uint32_t /*PC*/, const Instruction&, uint32_t /*literal*/) {}
+        void retire(const Wavefront&, const Instruction&) {}
+    };
+
+    // 64-bit scalar operand: SGPR[n] holds the low half, SGPR[n + 1] the high half. Pairs
+    // start on an even register of the 64-byte aligned file, so each access is one aligned
+    // 8-byte load or store instead of two 32-bit halves.
+    struct SgprPair
+    {
+        uint32_t* lo;
+
+        static uint64_t load(const uint32_t* lo)
+        {
+            uint64_t value;
+            std::memcpy(&value, lo, sizeof(value));
+            return value;
+        }
+
+        static void store(uint32_t* lo, uint64_t value) { std::memcpy(lo, &value, sizeof(value)); }
+
+        operator uint64_t() const { return load(lo); }
+        SgprPair& operator=(uint64_t value) { store(lo, value); return *this; }
+    };
+
+    // Where a scalar source operand comes from. translate() resolves it once per µop and
+    // picks the handler built for that kind (salu_handler()), so the fetch does not branch.
+    enum class Source : uint8_t
+    {
+        SGPR,    // the register file: s0..s101, VCC, M0, EXEC and the rest up to s127
+        INLINE,  // -16..64 and the float constants
+        LITERAL, // the dword after the instruction
+        SPECIAL, // VCCZ, EXECZ, SCC, the s127 pair wrapping to s0: all of read()
+    };
+
+    inline constexpr int SOURCE_KINDS = 4;
+
+    // `wide`: the operand is 64 bits, where s127 is not a plain pair.
+    constexpr Source source_kind(uint8_t src, bool wide)
+    {
+        if (src < Operand::EXEC_HI || (src == Operand::EXEC_HI && !wide)) return Source::SGPR;
+        if (src == Operand::LITERAL) return Source::LITERAL;
+        if (Operand::is_inline(src)) return Source::INLINE;
+        return Source::SPECIAL;
+    }
+
+    template<typename V>
+    constexpr std::array<V, 256> make_inline_table()
+    {
+        std::array<V, 256> table{};
+        for (int src = 0; src < 256; ++src)
+        {
+            if (!Operand::is_inline(static_cast<uint8_t>(src))) continue;
+            if constexpr (sizeof(V) == 8) table[src] = Operand::inline_b64(static_cast<uint8_t>(src));
+            else                          table[src] = Operand::inline_b32(static_cast<uint8_t>(src));
+        }
+        return table;
+    }
+
+    inline constexpr auto INLINE_B32 = make_inline_table<uint32_t>();
+    inline constexpr auto INLINE_B64 = make_inline_table<uint64_t>();
+
+    struct Wavefront
+    {
+        static constexpr int SGPR_COUNT = 102;
+        static constexpr int VGPR_COUNT = 256;
+        static constexpr int LANES      = 64;
+
+        enum class Status : uint8_t
+        {
+            ENDED,   // S_ENDPGM, or PC ran off the end of the program
+            ILLEGAL, // PC points at a word that does not decode to an implemented instruction
+        };
+
+        // Indexed by the SDST/SSRC encoding: [0..101] SGPRs, [102..127] VCC, M0, EXEC and the rest.
+        alignas(64) uint32_t SGPR[128] = {};
+        bool     SCC = false;
+        uint32_t PC  = 0; // byte offset into the program
+
+        // Lane-contiguous: VGPR[v] is one 256-byte row holding v for all 64 lanes.
+        alignas(64) uint32_t VGPR[VGPR_COUNT][LANES] = {};
+
+        Tlb tlb; // SMEM loads read guest memory through it (memory.hpp)
+
+        uint64_t exec() const { return read<uint64_t>(Operand::EXEC_LO, 0); }
+        uint64_t vcc()  const { return read<uint64_t>(Operand::VCC_LO, 0); }
+        void set_exec(uint64_t mask) { write<uint64_t>(Operand::EXEC_LO, mask); }
+        void set_vcc(uint64_t mask)  { write<uint64_t>(Operand::VCC_LO, mask); }
+
+        template<typename V>
+        V read(uint8_t src, uint32_t literal) const
+        {
+            if (src <= Operand::EXEC_HI)
+            {
+                if constexpr (sizeof(V) == 8)
+                {
+                    if (src == Operand::EXEC_HI) return SGPR[src] | (static_cast<uint64_t>(SGPR[0]) << 32);
+                    return SgprPair::load(&SGPR[src]);
+                }
+                else
+                {
+                    return SGPR[src];
+                }
+            }
+            if (src == Operand::LITERAL)
+            {
+                if constexpr (sizeof(V) == 8)
+                {
+                    return static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(literal)));
+                }
+                else
+                {
+                    return literal;
+                }
+            }
+            if (Operand::is_inline(src))
+            {
+                if constexpr (sizeof(V) == 8) return Operand::inline_b64(src);
+                else                          return Operand::inline_b32(src);
+            }
+            switch (src)
+            {
+                case Operand::VCCZ:  return vcc() == 0;
+                case Operand::EXECZ: return exec() == 0;
+                case Operand::SCC:   return SCC;
+                default:             return 0;
+            }
+        }
+
+        // read() for a source already known to be of kind KIND.
+        template<typename V, Source KIND>
+        V fetch(uint8_t src, uint32_t literal) const
+        {
+            if constexpr (KIND == Source::SGPR)
+            {
+                if constexpr (sizeof(V) == 8) return SgprPair::load(&SGPR[src]);
+                else                          return SGPR[src];
+            }
+            else if constexpr (KIND == Source::INLINE)
+            {
+                if constexpr (sizeof(V) == 8) return INLINE_B64[src];
+                else                          return INLINE_B32[src];
+            }
+            else if constexpr (KIND == Source::LITERAL)
+            {
+                if constexpr (sizeof(V) == 8) return static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(literal)));
+                else                          return literal;
+            }
+            else
+            {
+                return read<V>(src, literal);
+            }
+        }
+
+        // n < 127; the s127 pair wraps to s0 and goes through read()/write().
+        SgprPair pair(uint8_t n) { return { &SGPR[n] }; }
+
+        template<typename V>
+        void write(uint8_t sdst, V value)
+        {
+            sdst &= 0x7F;
+            if constexpr (sizeof(V) == 8)
+            {
+                if (sdst != Operand::EXEC_HI)
+                {
+                    pair(sdst) = value;
+                    return;
+                }
+                SGPR[0] = static_cast<uint32_t>(value >> 32);
+            }
+            SGPR[sdst] = static_cast<uint32_t>(value);
+        }
+
+        Status run(std::span<const uint32_t> program);
+        Status run(const Translation& translation); // see uop_cache.hpp
+
+        template<typename Observer>
+        Status run(std::span<const uint32_t> program, Observer& observer);
+        template<typename Observer>
+        Status run(const Translation& translation, Observer& observer);
+    };
+
+    using WaveHandler = void (*)(Wavefront& wave, const Instruction& inst, uint32_t literal);
+
+    // With SCC_LIVE false the handler computes SCC into a local that is then dropped, so the
+    // compiler removes the work; SCC is still read where execute() needs it (drop_dead_scc()).
+    // S0_KIND/S1_KIND are the source_kind() of SSRC0/SSRC1; the SPECIAL default takes any source.
+    template<typename T, bool SCC_LIVE = true, Source S0_KIND = Source::SPECIAL>
+    void execute_sop1(Wavefront& wave, const Instruction& inst, uint32_t literal)
+    {
+        using E   = Execute<T>;
+        using D_t = std::remove_reference_t<typename E::template Arg<1>>;
+        const auto S0 = wave.fetch<typename E::template Arg<0>, S0_KIND>(inst.SSRC0, literal);
+
+        D_t  D   = wave.read<D_t>(inst.SDST, 0); // conditional moves keep the old value
+        bool SCC = wave.SCC;
+        if constexpr (E::ARITY == 3) T::execute(S0, D, SCC_LIVE ? wave.SCC : SCC);
+        else                         T::execute(S0, D);
+        wave.write<D_t>(inst.SDST, D);
+    }
+
+    template<typename T, bool SCC_LIVE = true, Source S0_KIND = Source::SPECIAL, Source S1_KIND = Source::SPECIAL>
+    void execute_sop2(Wavefront& wave, const Instruction& inst, uint32_t literal)
+    {
+        using E   = Execute<T>;
+        using D_t = std::remove_reference_t<typename E::template Arg<2>>;
+        const auto S0 = wave.fetch<typename E::template Arg<0>, S0_KIND>(inst.SSRC0, literal);
+        const auto S1 = wave.fetch<typename E::template Arg<1>, S1_KIND>(inst.SSRC1, literal);
+
+        D_t  D   = 0;
+        bool SCC = wave.SCC;
+        if constexpr (E::ARITY == 4) T::execute(S0, S1, D, SCC_LIVE ? wave.SCC : SCC);
+        else                         T::execute(S0, S1, D);
+        wave.write<D_t>(inst.SDST, D);
+    }
+
+    template<bool SCC_LIVE = true, typename... Ts>
+    constexpr std::array<WaveHandler, SOP1_OPCODES> make_wave_sop1_table(InstructionList<Ts...>)
+    {
+        std::array<WaveHandler, SOP1_OPCODES> table{};
+        ((table[Ts::ID] = &execute_sop1<Ts, SCC_LIVE>), ...);
+        return table;
+    }
+
+    template<bool SCC_LIVE = true, typename... Ts>
+    constexpr std::array<WaveHandler, SOP2_OPCODES> make_wave_sop2_table(InstructionList<Ts...>)
+    {
+        std::array<WaveHandler, SOP2_OPCODES> table{};
+        ((table[Ts::ID] = &execute_sop2<Ts, SCC_LIVE>), ...);
+        return table;
+    }
+
+    template<typename T, bool SCC_LIVE = true, Source S0_KIND = Source::SPECIAL, Source S1_KIND = Source::SPECIAL>
+    void execute_sopc(Wavefront& wave, const Instruction& inst, uint32_t literal)
+    {
+        using E = Execute<T>;
+        const auto S0 = wave.fetch<typename E::template Arg<0>, S0_KIND>(inst.SSRC0, literal);
+        const auto S1 = wave.fetch<typename E::template Arg<1>, S1_KIND>(inst.SSRC1, literal);
+        bool SCC = wave.SCC;
+        T::execute(S0, S1, SCC_LIVE ? wave.SCC : SCC);
+    }
+
+    // SDST is read as well as written; the compares take it by value and leave it alone.
+    template<typename T, bool SCC_LIVE = true>
+    void execute_sopk(Wavefront& wave, const Instruction& inst, uint32_t)
+    {
+        using E   = Execute<T>;
+        using D_t = std::remove_reference_t<typename E::template Arg<1>>;
+        D_t  D   = wave.read<D_t>(inst.SDST, 0);
+        bool SCC = wave.SCC;
+        if constexpr (E::ARITY == 3) T::execute(simm16(inst), D, SCC_LIVE ? wave.SCC : SCC);
+        else                         T::execute(simm16(inst), D);
+        if constexpr (std::is_reference_v<typename E::template Arg<1>>) wave.write<D_t>(inst.SDST, D);
+    }
+
+    // The run loops set PC to the next instruction before calling this.
+    template<typename T>
+    void execute_sopp(Wavefront& wave, const Instruction& inst, uint32_t)
+    {
+        using E = Execute<T>;
+        if constexpr (E::ARITY == 3)
+        {
+            constexpr uint8_t CONDITION = T::CONDITION == SOPP::Condition::SCC  ? Operand::SCC
+                                        : T::CONDITION == SOPP::Condition::VCCZ ? Operand::VCCZ
+                                        :                                         Operand::EXECZ;
+            T::execute(simm16(inst), wave.PC, wave.read<uint32_t>(CONDITION, 0) != 0);
+        }
+        else if constexpr (E::ARITY == 2) T::execute(simm16(inst), wave.PC);
+        else                              T::execute(simm16(inst));
+    }
+
+    template<bool SCC_LIVE = true, typename... Ts>
+    constexpr std::array<WaveHandler, SOPC_OPCODES> make_wave_sopc_table(InstructionList<Ts...>)
+    {
+        std::array<WaveHandler, SOPC_OPCODES> table{};
+        ((table[Ts::ID] = &execute_sopc<Ts, SCC_LIVE>), ...);
+        return table;
+    }
+
+    template<bool SCC_LIVE = true, typename... Ts>
+    constexpr std::array<WaveHandler, SOPK_OPCODES> make_wave_sopk_table(InstructionList<Ts...>)
+    {
+        std::array<WaveHandler, SOPK_OPCODES> table{};
+        ((table[Ts::ID] = &execute_sopk<Ts, SCC_LIVE>), ...);
+        return table;
+    }
+
+    // The offset dword: a signed 21-bit byte offset with IMM, else the SGPR in its low byte; SOE
+    // adds the SGPR in SOFFSET. Buffer loads read only the part of the range below NUM_RECORDS
+    // (the descriptor's third dword) and zero the rest, and SDATA stops at s127.
+    template<typename T>
+    void execute_smem(Wavefront& wave, const Instruction& inst, uint32_t literal)
+    {
+        uint64_t offset = (inst.SSRC1 & SmemBits::IMM) != 0
+                        ? static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(literal << 11) >> 11))
+                        : wave.read<uint32_t>(static_cast<uint8_t>(literal), 0);
+        if ((inst.SSRC1 & SmemBits::SOE) != 0) offset += wave.read<uint32_t>(static_cast<uint8_t>(literal >> 25), 0);
+
+        uint64_t base  = wave.read<uint64_t>(inst.SSRC0, 0);
+        size_t   bytes = T::DWORDS * sizeof(uint32_t);
+        if constexpr (T::BUFFER)
+        {
+            base &= 0xFFFFFFFFFFFFULL; // BASE_ADDRESS [47:0]; STRIDE and the rest are not used
+            const uint32_t records = wave.read<uint32_t>(static_cast<uint8_t>(inst.SSRC0 + 2), 0);
+            bytes = offset >= records ? 0 : std::min<uint64_t>(bytes, (records - offset + 3) & ~uint64_t{ 3 });
+        }
+
+        uint32_t*    D     = &wave.SGPR[inst.SDST];
+        const size_t room  = sizeof(wave.SGPR) - inst.SDST * sizeof(uint32_t);
+        const size_t total = std::min<size_t>(T::DWORDS * sizeof(uint32_t), room);
+        bytes              = std::min(bytes, total);
+        wave.tlb.load((base + offset) & ~uint64_t{ 3 }, D, bytes);
+        if (bytes != total) std::memset(reinterpret_cast<uint8_t*>(D) + bytes, 0, total - bytes);
+    }
+
+    template<typename... Ts>
+    constexpr std::array<WaveHandler, SMEM_OPCODES> make_wave_smem_table(InstructionList<Ts...>)
+    {
+        std::array<WaveHandler, SMEM_OPCODES> table{};
+        ((table[Ts::ID] = &execute_smem<Ts>), ...);
+        return table;
+    }
+
+    template<typename... Ts>
+    constexpr std::array<WaveHandler, SOPP_OPCODES> make_wave_sopp_table(InstructionList<Ts...>)
+    {
+        std::array<WaveHandler, SOPP_OPCODES> table{};
+        ((table[Ts::ID] = &execute_sopp<Ts>), ...);
+        return table;
+    }
+
+    // SOPP opcodes whose execute() takes PC: the only instructions that can leave a straight line.
+    template<typename... Ts>
+    constexpr std::array<bool, SOPP_OPCODES> make_sopp_control(InstructionList<Ts...>)
+    {
+        std::array<bool, SOPP_OPCODES> table{};
+        ((table[Ts::ID] = Execute<Ts>::ARITY >= 2), ...);
+        return table;
+    }
+
+    inline constexpr auto WAVE_SOP1_TABLE = make_wave_sop1_table(SOP1::ALL{});
+    inline constexpr auto WAVE_SOP2_TABLE = make_wave_sop2_table(SOP2::ALL{});
+    inline constexpr auto WAVE_SOPC_TABLE = make_wave_sopc_table(SOPC::ALL{});
+    inline constexpr auto WAVE_SOPK_TABLE = make_wave_sopk_table(SOPK::ALL{});
+    inline constexpr auto WAVE_SOPP_TABLE = make_wave_sopp_table(SOPP::ALL{});
+    inline constexpr auto WAVE_SMEM_TABLE = make_wave_smem_table(SMEM::ALL{});
+    inline constexpr auto SOPP_CONTROL    = make_sopp_control(SOPP::ALL{});
+
+    constexpr bool is_control(const Instruction& inst) { return inst.format == Format::SOPP && SOPP_CONTROL[inst.OP]; }
+
+    // VOP1/VOP2 handlers, selected for the host's widest SIMD (valu.cpp).
+    WaveHandler valu_handler(const Instruction& inst);
+
+    // SOP1/SOP2/SOPC handlers specialised on the kind of each source (salu.cpp); any other
+    // format gets wave_handler(). scc_live false picks the drop_dead_scc() variant.
+    WaveHandler salu_handler(const Instruction& inst, bool scc_live = true);
+
+    struct SourceKinds
+    {
+        Source S0 = Source::SPECIAL;
+        Source S1 = Source::SPECIAL; // SPECIAL for SOP1, which has no SSRC1
+    };
+
+    // The kinds salu_handler() specialises a SOP1/SOP2/SOPC instruction on; SPECIAL for others.
+    SourceKinds source_kinds(const Instruction& inst);
+
+    inline WaveHandler wave_handler(const Instruction& inst)
+    {
+        switch (inst.format)
+        {
+            case Format::SOP1: return WAVE_SOP1_TABLE[inst.OP];
+            case Format::SOP2: return WAVE_SOP2_TABLE[inst.OP];
+            case Format::SOPC: return WAVE_SOPC_TABLE[inst.OP];
+            case Format::SOPK: return WAVE_SOPK_TABLE[inst.OP];
+            case Format::SOPP: return WAVE_SOPP_TABLE[inst.OP];
+            case Format::SMEM: return WAVE_SMEM_TABLE[inst.OP];
+            case Format::VOP1:
+            case Format::VOP2: return valu_handler(inst);
+            default:           return nullptr;
+        }
+    }
+
+    template<typename Observer>
+    Wavefront::Status Wavefront::run(std::span<const uint32_t> program, Observer& observer)
+    {
+        const size_t end = program.size() * sizeof(uint32_t);
+
+        while (PC < end)
+        {
+            const uint32_t*   word = program.data() + PC / sizeof(uint32_t);
+            const Instruction inst = decode(*word);
+            const bool        lit  = has_literal(inst);
+            const WaveHandler fn   = wave_handler(inst);
+
+            if (fn == nullptr || (lit && PC + 8 > end))
+            {
+                return Status::ILLEGAL;
+            }
+            observer.issue(*this, PC, inst, lit ? word[1] : 0);
+            PC += lit ? 8 : 4; // branches add to it, S_ENDPGM moves it past the end
+            fn(*this, inst, lit ? word[1] : 0);
+            observer.retire(*this, inst);
+        }
+        return Status::ENDED;
+    }
+}
@@ -1,16 +1,1815 @@
 #include "libs/vega.hpp"
-#include <ios>
-#include <iostream>
-#include <bitset>
+#include "libs/assembler.hpp"
+#include "libs/batch.hpp"
+#include "libs/checkpoint.hpp"
+#include "libs/code_object.hpp"
+#include "libs/disassembler.hpp"
+#include "libs/dispatcher.hpp"
+#include "libs/evaluate.hpp"
+#include "libs/fold.hpp"
+#include "libs/fuse.hpp"
+#include "libs/jit_x64.hpp"
+#include "libs/liveness.hpp"
+#include "libs/threaded.hpp"
+#include "libs/timing.hpp"
+#include "libs/trace.hpp"
+#include "libs/uop_cache.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <string>
+#include <memory>
+#include <random>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <unistd.h>
 
-int main()
+// Equivalence of the bit-manipulation instructions against the original loop implementations:
+// every 32-bit input for the B32 forms, edge patterns plus random words for the B64 forms.
+namespace reference
 {
-using namespace std;
-    uint32_t S0;
-    cout << "Enter the Number: ";
-    cin >> S0;
-    cout << hex << S0 << endl;
+    uint32_t wqm_b32(uint32_t S0)
+    {
+        uint32_t result = 0;
+        for (int q = 0; q < 8; ++q)
+        {
+            uint32_t quad_mask = (0xF << (q * 4));
+            if (S0 & quad_mask) result |= quad_mask;
+        }
+        return result;
+    }
 
-	return 0;
+    uint64_t wqm_b64(uint64_t S0)
+    {
+        uint64_t result = 0;
+        for (int q = 0; q < 16; ++q)
+        {
+            uint64_t quad_mask = (0xFULL << (q * 4));
+            if (S0 & quad_mask) result |= quad_mask;
+        }
+        return result;
+    }
+
+    template<typename V>
+    V brev(V S0)
+    {
+        constexpr int BITS = sizeof(V) * 8;
+        V result = 0;
+        for (int i = 0; i < BITS; ++i)
+        {
+            if ((S0 >> i) & 1) result |= (V{ 1 } << (BITS - 1 - i));
+        }
+        return result;
+    }
+
+    template<typename V>
+    uint32_t bcnt(V S0, V bit)
+    {
+        uint32_t result = 0;
+        for (int i = 0; i < int(sizeof(V) * 8); ++i)
+        {
+            if (((S0 >> i) & 1) == bit) result++;
+        }
+        return result;
+    }
+
+    template<typename V>
+    uint32_t ff(V S0, V bit)
+    {
+        for (int i = 0; i < int(sizeof(V) * 8); ++i)
+        {
+            if (((S0 >> i) & 1) == bit) return static_cast<uint32_t>(i);
+        }
+        return 0xFFFFFFFF;
+    }
+
+    template<typename V>
+    uint32_t flbit(V S0)
+    {
+        constexpr int BITS = sizeof(V) * 8;
+        for (int i = BITS - 1; i >= 0; --i)
+        {
+            if ((S0 >> i) & 1) return static_cast<uint32_t>(BITS - 1 - i);
+        }
+        return 0xFFFFFFFF;
+    }
+}
+
+static std::atomic<int> failures{ 0 };
+
+static void expect(bool ok, const char* name, uint64_t S0)
+{
+    if (!ok && failures++ < 20)
+    {
+        std::printf("FAIL %s S0=0x%016llx\n", name, static_cast<unsigned long long>(S0));
+    }
+}
+
+static void check_b32(uint32_t S0)
+{
+    using namespace vega::SOP1;
+    uint32_t D = 0;
+    bool SCC = false;
+
+    S_WQM_B32::execute(S0, D, SCC);       expect(D == reference::wqm_b32(S0) && SCC == (D != 0), "S_WQM_B32", S0);
+    S_BREV_B32::execute(S0, D);           expect(D == reference::brev(S0), "S_BREV_B32", S0);
+    vega::VOP1::V_BFREV_B32::execute(S0, D); expect(D == reference::brev(S0), "V_BFREV_B32", S0);
+    S_BCNT0_I32_B32::execute(S0, D, SCC); expect(D == reference::bcnt(S0, 0u) && SCC == (D != 0), "S_BCNT0_I32_B32", S0);
+    S_BCNT1_I32_B32::execute(S0, D, SCC); expect(D == reference::bcnt(S0, 1u) && SCC == (D != 0), "S_BCNT1_I32_B32", S0);
+    S_FF0_I32_B32::execute(S0, D);        expect(D == reference::ff(S0, 0u), "S_FF0_I32_B32", S0);
+    S_FF1_I32_B32::execute(S0, D);        expect(D == reference::ff(S0, 1u), "S_FF1_I32_B32", S0);
+    S_FLBIT_I32_B32::execute(S0, D);      expect(D == reference::flbit(S0), "S_FLBIT_I32_B32", S0);
+}
+
+static void check_b64(uint64_t S0)
+{
+    using namespace vega::SOP1;
+    uint64_t D64 = 0;
+    uint32_t D = 0;
+    bool SCC = false;
+
+    S_WQM_B64::execute(S0, D64, SCC);     expect(D64 == reference::wqm_b64(S0) && SCC == (D64 != 0), "S_WQM_B64", S0);
+    S_BREV_B64::execute(S0, D64);         expect(D64 == reference::brev(S0), "S_BREV_B64", S0);
+    S_BCNT0_I32_B64::execute(S0, D, SCC); expect(D == reference::bcnt(S0, uint64_t{ 0 }) && SCC == (D != 0), "S_BCNT0_I32_B64", S0);
+    S_BCNT1_I32_B64::execute(S0, D, SCC); expect(D == reference::bcnt(S0, uint64_t{ 1 }) && SCC == (D != 0), "S_BCNT1_I32_B64", S0);
+    S_FF0_I32_B64::execute(S0, D);        expect(D == reference::ff(S0, uint64_t{ 0 }), "S_FF0_I32_B64", S0);
+    S_FF1_I32_B64::execute(S0, D);        expect(D == reference::ff(S0, uint64_t{ 1 }), "S_FF1_I32_B64", S0);
+    S_FLBIT_I32_B64::execute(S0, D);      expect(D == reference::flbit(S0), "S_FLBIT_I32_B64", S0);
+}
+
+// The 2^32 sweep is split into contiguous slices, one per hardware thread.
+static void sweep_b32()
+{
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    const uint64_t slice   = ((1ULL << 32) + threads - 1) / threads;
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        pool.emplace_back([=] {
+            const uint64_t end = std::min<uint64_t>((t + 1) * slice, 1ULL << 32);
+            for (uint64_t S0 = t * slice; S0 < end; ++S0)
+            {
+                check_b32(static_cast<uint32_t>(S0));
+            }
+        });
+    }
+    for (std::thread& t : pool)
+    {
+        t.join();
+    }
+}
+
+static void sweep_b64()
+{
+    for (int i = 0; i < 64; ++i)
+    {
+        for (int j = 0; j < 64; ++j)
+        {
+            const uint64_t bits = (1ULL << i) | (1ULL << j);
+            check_b64(bits);
+            check_b64(~bits);
+            check_b64((1ULL << i) - 1);
+        }
+    }
+    std::mt19937_64 rng(2024);
+    for (int i = 0; i < (1 << 22); ++i)
+    {
+        const uint64_t r = rng();
+        check_b64(r);
+        check_b64(r & rng() & rng());
+        check_b64(r | rng() | rng());
+    }
+    check_b64(0);
+    check_b64(~0ULL);
+}
+
+// Superinstructions (fuse.hpp) against their two instructions run in turn, from random
+// SGPRs and SCC. Operands are drawn from a few registers so pairs overlap and alias.
+static void expect_same(const vega::Wavefront& fused, const vega::Wavefront& pair, bool scc_live, const char* name, uint64_t seed)
+{
+    const bool same = std::memcmp(fused.SGPR, pair.SGPR, sizeof fused.SGPR) == 0 && (!scc_live || fused.SCC == pair.SCC);
+    expect(same, name, seed);
+}
+
+// Carries and borrows hinge on all-zero and all-one halves, so those are common.
+static vega::Wavefront random_wave(std::mt19937_64& rng)
+{
+    vega::Wavefront wave;
+    for (uint32_t& r : wave.SGPR)
+    {
+        const uint64_t x = rng();
+        r = x % 4 == 0 ? (x & 4 ? 0 : 0xFFFFFFFF) : static_cast<uint32_t>(x >> 8);
+    }
+    wave.SCC = rng() & 1;
+    return wave;
+}
+
+template<typename First, typename Second, bool SUBTRACT>
+static void check_add64(std::mt19937_64& rng, uint64_t seed)
+{
+    using vega::HighHalf;
+    namespace Operand = vega::Operand;
+    constexpr uint8_t HIGH[] = { 0, Operand::ZERO, Operand::INT_POS_MAX + 1 };
+    vega::Instruction a, b;
+    a.format = b.format = vega::Format::SOP2;
+    a.OP     = First::ID;
+    b.OP     = Second::ID;
+    a.SDST   = static_cast<uint8_t>(rng() % 8);
+    a.SSRC0  = static_cast<uint8_t>(rng() % 8);
+    a.SSRC1  = rng() % 4 == 0 ? Operand::LITERAL : static_cast<uint8_t>(rng() % 8);
+    b.SDST   = a.SDST + 1;
+    b.SSRC0  = a.SSRC0 + 1;
+    const int high = a.SSRC1 == Operand::LITERAL ? 1 + rng() % 2 : rng() % 3;
+    b.SSRC1  = high == 0 ? a.SSRC1 + 1 : HIGH[high];
+    // fuse_pairs() keeps the pair apart when the second reads the first's result.
+    if (a.SDST == b.SSRC0 || (high == 0 && a.SDST == b.SSRC1)) return;
+
+    const uint32_t literal = static_cast<uint32_t>(rng());
+    vega::Wavefront pair = random_wave(rng);
+    vega::Wavefront fused = pair, dead = pair;
+
+    vega::execute_sop2<First>(pair, a, literal);
+    vega::execute_sop2<Second>(pair, b, literal);
+    using Add = void (*)(vega::Wavefront&, const vega::Instruction&, uint32_t);
+    constexpr Add LIVE[] = { &vega::execute_add64<SUBTRACT, HighHalf::PAIR>, &vega::execute_add64<SUBTRACT, HighHalf::ZERO>, &vega::execute_add64<SUBTRACT, HighHalf::ONES> };
+    constexpr Add DEAD[] = { &vega::execute_add64<SUBTRACT, HighHalf::PAIR, false>, &vega::execute_add64<SUBTRACT, HighHalf::ZERO, false>, &vega::execute_add64<SUBTRACT, HighHalf::ONES, false> };
+    LIVE[high](fused, a, literal);
+    DEAD[high](dead, a, literal);
+    expect_same(fused, pair, true, vega::FUSED_NAMES[SUBTRACT ? vega::Fused::SUB_SUBB : vega::Fused::ADD_ADDC], seed);
+    expect_same(dead, pair, false, vega::FUSED_NAMES[SUBTRACT ? vega::Fused::SUB_SUBB : vega::Fused::ADD_ADDC], seed);
+}
+
+template<typename First, typename Second, uint8_t KIND>
+static void check_pair(std::mt19937_64& rng, uint64_t seed)
+{
+    constexpr uint8_t SPECIAL[] = { vega::Operand::SCC, vega::Operand::VCCZ, vega::Operand::EXECZ };
+    auto operand = [&]
+    {
+        switch (rng() % 8)
+        {
+            case 0:  return static_cast<uint8_t>(vega::Operand::ZERO + rng() % 80);
+            case 1:  return SPECIAL[rng() % 3];
+            default: return static_cast<uint8_t>(rng() % 8);
+        }
+    };
+    vega::Instruction a, b;
+    a.format = b.format = vega::Format::SOP2;
+    a.OP     = First::ID;
+    b.OP     = Second::ID;
+    a.SDST   = static_cast<uint8_t>(rng() % 8);
+    b.SDST   = static_cast<uint8_t>(rng() % 8);
+    a.SSRC0  = operand();
+    a.SSRC1  = operand();
+    b.SSRC0  = operand();
+    b.SSRC1  = operand();
+
+    vega::Wavefront pair = random_wave(rng);
+    vega::Wavefront fused = pair, dead = pair;
+
+    vega::execute_sop2<First>(pair, a, 0);
+    vega::execute_sop2<Second>(pair, b, 0);
+    vega::pair_handler(KIND, b, true)(fused, a, vega::pack_second(b));
+    vega::pair_handler(KIND, b, false)(dead, a, vega::pack_second(b));
+    expect_same(fused, pair, true, vega::FUSED_NAMES[KIND], seed);
+    expect_same(dead, pair, false, vega::FUSED_NAMES[KIND], seed);
+}
+
+static void check_fuse()
+{
+    using namespace vega::SOP2;
+    for (uint64_t seed = 0; seed < (1 << 16); ++seed)
+    {
+        std::mt19937_64 rng(seed);
+        check_add64<S_ADD_U32, S_ADDC_U32, false>(rng, seed);
+        check_add64<S_SUB_U32, S_SUBB_U32, true>(rng, seed);
+        check_pair<S_ADD_U32, S_ADDC_U32, vega::Fused::ADD_ADDC>(rng, seed);
+        check_pair<S_SUB_U32, S_SUBB_U32, vega::Fused::SUB_SUBB>(rng, seed);
+        check_pair<S_LSHL_B32, S_ADD_U32, vega::Fused::LSHL_ADD>(rng, seed);
+    }
+}
+
+// Programs for the sections below, which compare whole runs.
+static std::vector<uint32_t> program(const char* source)
+{
+    std::vector<uint32_t> code;
+    const vega::AssembleResult r = vega::assemble(source, code);
+    if (!r) std::printf("FAIL assemble: %s at %u:%u\n", r.error, r.line, r.column);
+    expect(static_cast<bool>(r), "assemble", r.line);
+    return code;
+}
+
+// The cache hits on the same code without hashing it, and invalidate() catches in-place edits.
+static void check_cache()
+{
+    std::vector<uint32_t> code = program("s_mov_b32 s0, 0x1234\n s_add_u32 s1, s0, s0\n s_endpgm\n");
+    vega::UopCache cache;
+    const vega::Translation* first = &cache.get(code);
+    expect(&cache.get(code) == first && cache.hits == 1 && cache.misses == 1, "UopCache hit", 0);
+
+    cache.invalidate();
+    cache.get(code);
+    expect(cache.hits == 2 && cache.misses == 1, "UopCache unchanged after invalidate", 0);
+
+    code[1] = 7; // the literal
+    cache.invalidate();
+    vega::Wavefront wave;
+    wave.run(cache.get(code));
+    expect(cache.misses == 2 && wave.SGPR[1] == 14, "UopCache rewritten", wave.SGPR[1]);
+
+    cache.get(std::span<const uint32_t>(code.data(), 2));
+    expect(cache.misses == 3, "UopCache size change", 0);
+}
+
+template<typename... Ts>
+static std::vector<uint32_t> opcodes(vega::InstructionList<Ts...>)
+{
+    return { Ts::hex()... };
+}
+
+// Random scalar code inside a counted loop on s12, so every run ends. Forward branches may
+// land inside a literal, on the loop's tail or past the end; SDSTs stay off s12 and include VCC and EXEC so
+// the VCCZ/EXECZ branches go both ways. With `pairs`, SOP2 slots hold the pairs fuse_pairs() merges,
+// often on aligned register pairs, which branches may split.
+static std::vector<uint32_t> random_program(std::mt19937_64& rng, size_t length, bool pairs = false)
+{
+    namespace Operand = vega::Operand;
+    static const std::vector<uint32_t> SOP1 = opcodes(vega::SOP1::ALL{});
+    static const std::vector<uint32_t> SOP2 = opcodes(vega::SOP2::ALL{});
+    static const std::vector<uint32_t> SOPC = opcodes(vega::SOPC::ALL{});
+    static const std::vector<uint32_t> SOPK = opcodes(vega::SOPK::ALL{});
+    static const std::vector<uint32_t> BRANCHES = {
+        vega::SOPP::S_BRANCH::hex(), vega::SOPP::S_CBRANCH_SCC0::hex(), vega::SOPP::S_CBRANCH_SCC1::hex(),
+        vega::SOPP::S_CBRANCH_VCCZ::hex(), vega::SOPP::S_CBRANCH_VCCNZ::hex(),
+        vega::SOPP::S_CBRANCH_EXECZ::hex(), vega::SOPP::S_CBRANCH_EXECNZ::hex() };
+    constexpr uint8_t DESTS[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, Operand::VCC_LO, Operand::EXEC_LO };
+
+    const auto pick    = [&](const std::vector<uint32_t>& v) { return v[rng() % v.size()]; };
+    const auto dest    = [&] { return uint32_t{ DESTS[rng() % std::size(DESTS)] }; };
+    const auto operand = [&]() -> uint32_t
+    {
+        switch (rng() % 8)
+        {
+            case 0:  return Operand::LITERAL;
+            case 1:  return Operand::ZERO + rng() % 81;
+            case 2:  return rng() % 2 ? Operand::SCC : rng() % 2 ? Operand::VCCZ : Operand::EXECZ;
+            case 3:  return rng() % 2 ? Operand::VCC_LO : Operand::EXEC_LO;
+            default: return rng() % 12;
+        }
+    };
+
+    std::vector<uint32_t> code = { vega::SOPK::S_MOVK_I32::hex() | (12u << 16) | static_cast<uint32_t>(1 + rng() % 4) };
+    std::vector<size_t>   branches;
+    for (size_t i = 0; i < length; ++i)
+    {
+        uint32_t word = 0;
+        switch (rng() % 6)
+        {
+            case 0:  word = pick(SOP1) | (dest() << 16) | operand(); break;
+            case 1:
+            case 2:
+                if (pairs)
+                {
+                    using namespace vega::SOP2;
+                    constexpr uint32_t FIRST[]  = { S_ADD_U32::hex(), S_SUB_U32::hex(), S_LSHL_B32::hex() };
+                    constexpr uint32_t SECOND[] = { S_ADDC_U32::hex(), S_SUBB_U32::hex(), S_ADD_U32::hex() };
+                    const size_t kind = rng() % 3;
+                    uint32_t d = dest(), a = operand(), b = operand();
+                    uint32_t d2 = dest(), a2 = operand(), b2 = operand();
+                    if (rng() % 2)
+                    {
+                        d  = 2 * (rng() % 5);
+                        a  = 2 * (rng() % 5);
+                        b  = rng() % 4 ? 2 * (rng() % 5) : b;
+                        d2 = d + 1;
+                        a2 = a + 1;
+                        b2 = rng() % 3 == 0 || b >= 10 ? Operand::ZERO : rng() % 2 ? Operand::INT_POS_MAX + 1 : b + 1;
+                    }
+                    code.push_back(FIRST[kind] | (d << 16) | (b << 8) | a);
+                    if (vega::has_literal(vega::decode(code.back()))) code.push_back(static_cast<uint32_t>(rng()));
+                    word = SECOND[kind] | (d2 << 16) | (b2 << 8) | a2;
+                    break;
+                }
+                word = pick(SOP2) | (dest() << 16) | (operand() << 8) | operand();
+                break;
+            case 3:  word = pick(SOPC) | (operand() << 8) | operand(); break;
+            case 4:  word = pick(SOPK) | (dest() << 16) | static_cast<uint16_t>(rng()); break;
+            default: word = pick(BRANCHES); branches.push_back(code.size()); break;
+        }
+        code.push_back(word);
+        if (vega::has_literal(vega::decode(word))) code.push_back(static_cast<uint32_t>(rng()));
+    }
+    // Forward branches stay in the body, so none skips the decrement, or leave the program.
+    const size_t body = code.size();
+    for (size_t at : branches)
+    {
+        const size_t offset = rng() % 8 == 0 ? body + 3 - at + rng() % 3 : rng() % (body - at);
+        code[at] |= static_cast<uint16_t>(offset);
+    }
+    const uint32_t loop = static_cast<uint32_t>(code.size() + 2); // the back branch's next dword
+    code.push_back(vega::SOPK::S_ADDK_I32::hex() | (12u << 16) | 0xFFFF);
+    code.push_back(vega::SOPC::S_CMP_LG_U32::hex() | (uint32_t{ Operand::ZERO } << 8) | 12);
+    code.push_back(vega::SOPP::S_CBRANCH_SCC1::hex() | static_cast<uint16_t>(1 - static_cast<int32_t>(loop + 1)));
+    code.push_back(vega::SOPP::S_ENDPGM::hex());
+    return code;
+}
+
+static void expect_same_run(const vega::Wavefront& got, vega::Wavefront::Status got_status,
+                            const vega::Wavefront& want, vega::Wavefront::Status want_status, const char* name, uint64_t seed)
+{
+    const bool same = std::memcmp(got.SGPR, want.SGPR, sizeof got.SGPR) == 0 && got.SCC == want.SCC
+                   && got.PC == want.PC && got_status == want_status;
+    expect(same, name, seed);
+}
+
+// fuse_pairs() on whole translations: fixed cases for the SCC operand, block bounds, literals
+// and branch renumbering against the decoder, then random branching programs full of pairs,
+// fused against the unfused translation (their branches may land inside a literal).
+static size_t fused_ops(const vega::Translation& t)
+{
+    return static_cast<size_t>(std::count_if(t.ops.begin(), t.ops.end(), [](const vega::MicroOp& op) { return op.inst.format == vega::Format::FUSED; }));
+}
+
+static void check_fuse_pairs()
+{
+    const auto run_both = [](const std::vector<uint32_t>& code, const vega::Wavefront& start, size_t want_fused, const char* name)
+    {
+        vega::Translation translation = vega::translate(code);
+        const size_t ops = translation.ops.size();
+        const size_t fused = vega::fuse_pairs(translation);
+        vega::Wavefront decoded = start, uop = start;
+        const vega::Wavefront::Status want = decoded.run(code);
+        const vega::Wavefront::Status got  = uop.run(translation);
+        expect(fused == want_fused && fused_ops(translation) == fused && translation.ops.size() == ops - fused, name, fused);
+        expect_same_run(uop, got, decoded, want, name, 0);
+        return uop;
+    };
+
+    vega::Wavefront start;
+    start.SGPR[1] = 1;
+    start.SGPR[8] = 5;
+    const vega::Wavefront scc = run_both(program("s_lshl_b32 s6, s1, 2\n s_add_u32 s7, scc, s8\n s_endpgm\n"), start, 1, "fuse SCC operand");
+    expect(scc.SGPR[7] == 6, "fuse SCC operand value", scc.SGPR[7]);
+
+    // A branch target between the halves keeps them apart, as does the literal of an execute_pair<> pair.
+    run_both(program("s_add_u32 s0, s2, s4\nmid: s_addc_u32 s1, s3, s5\n s_cbranch_scc1 mid\n s_endpgm\n"), start, 0, "fuse across a block start");
+    run_both(program("s_lshl_b32 s6, s1, 2\n s_add_u32 s6, s6, 0x12345\n s_endpgm\n"), start, 0, "fuse literal");
+    run_both(program("s_add_u32 s0, s2, 0x12345\n s_addc_u32 s1, s3, 0\n s_endpgm\n"), start, 1, "fuse add64 literal");
+
+    // Two pairs inside a loop: the back branch must land on the renumbered first op.
+    const std::vector<uint32_t> loop = program(
+        "s_movk_i32 s12, 3\nloop:\n s_add_u32 s0, s0, s4\n s_addc_u32 s1, s1, s5\n s_lshl_b32 s6, s6, 1\n s_add_u32 s6, s6, s7\n"
+        "s_addk_i32 s12, -1\n s_cmp_lg_u32 s12, 0\n s_cbranch_scc1 loop\n s_endpgm\n");
+    vega::Wavefront looping;
+    looping.SGPR[4] = 0xFFFFFFFF;
+    looping.SGPR[7] = 3;
+    run_both(loop, looping, 2, "fuse in a loop");
+    vega::Translation translation = vega::translate(loop);
+    vega::fuse_pairs(translation);
+    const auto back = std::find_if(translation.ops.begin(), translation.ops.end(), [](const vega::MicroOp& op) { return vega::is_control(op.inst) && op.inst.OP == vega::SOPP::S_CBRANCH_SCC1::ID; });
+    expect(back != translation.ops.end() && back->target < translation.ops.size() && translation.ops[back->target].PC == 4
+           && translation.ops[back->target].inst.format == vega::Format::FUSED, "fuse branch target", 0);
+
+    size_t fused = 0;
+    for (uint64_t seed = 0; seed < 20000; ++seed)
+    {
+        std::mt19937_64 rng(seed);
+        const std::vector<uint32_t> code  = random_program(rng, 4 + rng() % 40, true);
+        const vega::Wavefront       first = random_wave(rng);
+        vega::Translation plain = vega::translate(code);
+        if (seed % 2) vega::drop_dead_scc(plain);
+        vega::Translation translation = plain;
+        fused += vega::fuse_pairs(translation);
+        vega::Wavefront unfused = first, uop = first;
+        const vega::Wavefront::Status want = unfused.run(plain);
+        const vega::Wavefront::Status got  = uop.run(translation);
+        expect_same_run(uop, got, unfused, want, "fuse_pairs", seed);
+    }
+    expect(fused > 20000, "fuse_pairs fuses", fused);
+}
+
+// run_threaded() against Wavefront::run(translation), plain and after every µop pass.
+static void check_threaded()
+{
+    for (uint64_t seed = 0; seed < 20000; ++seed)
+    {
+        std::mt19937_64 rng(seed);
+        const std::vector<uint32_t> code  = random_program(rng, 4 + rng() % 40);
+        const vega::Wavefront       start = random_wave(rng);
+        for (int passes = 0; passes < 2; ++passes)
+        {
+            vega::Translation translation = vega::translate(code);
+            if (passes == 1)
+            {
+                vega::fold_constants(translation);
+                vega::drop_dead_scc(translation);
+                vega::fuse_pairs(translation);
+            }
+            vega::Wavefront uop = start, threaded = start;
+            const vega::Wavefront::Status want = uop.run(translation);
+            const vega::Wavefront::Status got  = vega::run_threaded(threaded, vega::thread_code(translation));
+            expect_same_run(threaded, got, uop, want, passes == 0 ? "run_threaded" : "run_threaded after passes", seed);
+        }
+    }
+}
+
+// run_jit() against Wavefront::run(translation). One JitCache serves every program, so each
+// new translation must replace the blocks compiled for the last one at the same PCs.
+static void check_jit()
+{
+    vega::JitCache cache;
+    for (uint64_t seed = 0; seed < 20000; ++seed)
+    {
+        std::mt19937_64 rng(seed);
+        const std::vector<uint32_t> code  = random_program(rng, 4 + rng() % 40);
+        const vega::Wavefront       start = random_wave(rng);
+        for (int passes = 0; passes < 2; ++passes)
+        {
+            vega::Translation translation = vega::translate(code);
+            if (passes == 1)
+            {
+                vega::fold_constants(translation);
+                vega::drop_dead_scc(translation);
+                vega::fuse_pairs(translation);
+            }
+            vega::Wavefront uop = start, jit = start;
+            const vega::Wavefront::Status want = uop.run(translation);
+            const vega::Wavefront::Status got  = vega::run_jit(jit, translation, cache);
+            expect_same_run(jit, got, uop, want, passes == 0 ? "run_jit" : "run_jit after passes", seed);
+        }
+    }
+}
+
+// batch_sop1/batch_sop2 on the host's widest kernels against execute() lane by lane. The
+// lane count is not a multiple of any vector width, so the tails run too.
+static uint64_t random_lane(std::mt19937_64& rng)
+{
+    const uint64_t x = rng();
+    return x % 4 == 0 ? (x & 4 ? 0 : ~0ULL) : x % 4 == 1 ? x >> (x % 64) : rng();
+}
+
+template<typename T>
+static void check_batch_sop1(std::mt19937_64& rng)
+{
+    using Types = vega::BatchTypes<T>;
+    using S0    = typename Types::S0;
+    using D     = typename Types::D;
+    constexpr size_t N = 1027;
+    std::vector<S0> s0(N);
+    std::vector<D>  d(N), want(N);
+    auto scc = std::make_unique<bool[]>(N), want_scc = std::make_unique<bool[]>(N);
+    for (size_t i = 0; i < N; ++i)
+    {
+        s0[i] = static_cast<S0>(random_lane(rng));
+        d[i]  = want[i] = static_cast<D>(random_lane(rng));
+        scc[i] = want_scc[i] = rng() & 1;
+        if constexpr (vega::Execute<T>::ARITY == 3) T::execute(s0[i], want[i], want_scc[i]);
+        else                                        T::execute(s0[i], want[i]);
+    }
+    std::vector<uint8_t> in_place_scc(scc.get(), scc.get() + N);
+    vega::batch_sop1<T>(s0, d, std::span<bool>(scc.get(), N));
+    for (size_t i = 0; i < N; ++i) expect(d[i] == want[i] && scc[i] == want_scc[i], T::NAME, s0[i]);
+
+    // In place: D over S0's buffer, so D starts out as S0.
+    if constexpr (std::is_same_v<S0, D>)
+    {
+        std::vector<D> in_place = s0;
+        std::copy(in_place_scc.begin(), in_place_scc.end(), scc.get());
+        vega::batch_sop1<T>(in_place, in_place, std::span<bool>(scc.get(), N));
+        for (size_t i = 0; i < N; ++i)
+        {
+            D    r = s0[i];
+            bool c = in_place_scc[i];
+            if constexpr (vega::Execute<T>::ARITY == 3) T::execute(s0[i], r, c);
+            else                                        T::execute(s0[i], r);
+            expect(in_place[i] == r && scc[i] == c, T::NAME, s0[i]);
+        }
+    }
+}
+
+template<typename T>
+static void check_batch_sop2(std::mt19937_64& rng)
+{
+    using Types = vega::BatchTypes<T>;
+    using S0    = typename Types::S0;
+    using S1    = typename Types::S1;
+    using D     = typename Types::D;
+    constexpr size_t N = 1027;
+    std::vector<S0> s0(N);
+    std::vector<S1> s1(N);
+    std::vector<D>  d(N), want(N);
+    auto scc = std::make_unique<bool[]>(N), want_scc = std::make_unique<bool[]>(N);
+    for (size_t i = 0; i < N; ++i)
+    {
+        s0[i] = static_cast<S0>(random_lane(rng));
+        s1[i] = static_cast<S1>(random_lane(rng) % 4 == 0 ? rng() % 70 : random_lane(rng)); // shifts past the width too
+        d[i]  = want[i] = static_cast<D>(random_lane(rng));
+        scc[i] = want_scc[i] = rng() & 1;
+        if constexpr (vega::Execute<T>::ARITY == 4) T::execute(s0[i], s1[i], want[i], want_scc[i]);
+        else                                        T::execute(s0[i], s1[i], want[i]);
+    }
+    std::vector<uint8_t> in_place_scc(scc.get(), scc.get() + N);
+    vega::batch_sop2<T>(s0, s1, d, std::span<bool>(scc.get(), N));
+    for (size_t i = 0; i < N; ++i) expect(d[i] == want[i] && scc[i] == want_scc[i], T::NAME, s0[i]);
+
+    // In place: D over S0's buffer, so D starts out as S0.
+    if constexpr (std::is_same_v<S0, D>)
+    {
+        std::vector<D> in_place = s0;
+        std::copy(in_place_scc.begin(), in_place_scc.end(), scc.get());
+        vega::batch_sop2<T>(in_place, s1, in_place, std::span<bool>(scc.get(), N));
+        for (size_t i = 0; i < N; ++i)
+        {
+            D    r = s0[i];
+            bool c = in_place_scc[i];
+            if constexpr (vega::Execute<T>::ARITY == 4) T::execute(s0[i], s1[i], r, c);
+            else                                        T::execute(s0[i], s1[i], r);
+            expect(in_place[i] == r && scc[i] == c, T::NAME, s0[i]);
+        }
+    }
+}
+
+template<typename... Ts, typename... Us>
+static void check_batch(vega::InstructionList<Ts...>, vega::InstructionList<Us...>)
+{
+    std::mt19937_64 rng(6);
+    for (int round = 0; round < 16; ++round)
+    {
+        (check_batch_sop1<Ts>(rng), ...);
+        (check_batch_sop2<Us>(rng), ...);
+    }
+}
+
+// One VOP1/VOP2 instruction run through the decoder and the host's VALU kernels against
+// execute() lane by lane under EXEC. VDST often is one of the sources. Which NaN a float op
+// returns depends on the operand order the compiler picked, so any NaN matches any NaN.
+static bool is_nan(uint32_t bits)
+{
+    return (bits & 0x7F800000) == 0x7F800000 && (bits & 0x007FFFFF) != 0;
+}
+
+template<typename T, vega::Format F>
+static void check_vop(std::mt19937_64& rng, uint64_t seed)
+{
+    namespace Operand = vega::Operand;
+    vega::Wavefront before = random_wave(rng);
+    for (int v = 0; v < 8; ++v)
+    {
+        for (uint32_t& lane : before.VGPR[v]) lane = static_cast<uint32_t>(random_lane(rng));
+    }
+    const uint64_t masks[] = { ~0ULL, 0, rng(), rng() };
+    vega::SgprPair::store(&before.SGPR[Operand::EXEC_LO], masks[rng() % 4]);
+
+    const uint32_t vdst    = rng() % 8;
+    const uint32_t vsrc1   = rng() % 8;
+    const uint32_t choice  = rng() % 4;
+    const uint32_t src0    = choice == 0 ? 256 + rng() % 8 : choice == 1 ? rng() % 8 : choice == 2 ? Operand::ZERO + rng() % 81 : Operand::LITERAL;
+    const uint32_t literal = static_cast<uint32_t>(random_lane(rng));
+    std::vector<uint32_t> code = { F == vega::Format::VOP1 ? T::hex() | (vdst << 17) | src0 : T::hex() | (vdst << 17) | (vsrc1 << 9) | src0 };
+    if (src0 == Operand::LITERAL) code.push_back(literal);
+    code.push_back(vega::SOPP::S_ENDPGM::hex());
+
+    vega::Wavefront wave = before;
+    wave.run(code);
+    const bool float_op = std::string_view(T::NAME).find("_F32") != std::string_view::npos;
+    bool       same     = std::memcmp(wave.SGPR, before.SGPR, sizeof wave.SGPR) == 0;
+    for (int lane = 0; lane < vega::Wavefront::LANES; ++lane)
+    {
+        const uint32_t s0 = src0 >= 256 ? before.VGPR[src0 - 256][lane] : before.read<uint32_t>(static_cast<uint8_t>(src0), literal);
+        const uint32_t s1 = before.VGPR[vsrc1][lane];
+        uint32_t       d  = before.VGPR[vdst][lane];
+        if ((before.exec() >> lane) & 1)
+        {
+            if constexpr (F == vega::Format::VOP1)            T::execute(s0, d);
+            else if constexpr (vega::Execute<T>::ARITY == 4)  T::execute(s0, s1, d, ((before.vcc() >> lane) & 1) != 0);
+            else                                              T::execute(s0, s1, d);
+        }
+        const uint32_t got = wave.VGPR[vdst][lane];
+        same = same && (got == d || (float_op && is_nan(got) && is_nan(d)));
+    }
+    for (uint32_t v = 0; v < 8; ++v)
+    {
+        same = same && (v == vdst || std::memcmp(wave.VGPR[v], before.VGPR[v], sizeof before.VGPR[v]) == 0);
+    }
+    expect(same, T::NAME, seed);
+}
+
+template<typename... Ts, typename... Us>
+static void check_valu(vega::InstructionList<Ts...>, vega::InstructionList<Us...>)
+{
+    for (uint64_t seed = 0; seed < 2000; ++seed)
+    {
+        std::mt19937_64 rng(seed);
+        (check_vop<Ts, vega::Format::VOP1>(rng, seed), ...);
+        (check_vop<Us, vega::Format::VOP2>(rng, seed), ...);
+    }
+}
+
+// evaluate_sop1/evaluate_sop2 against execute_sop1/execute_sop2 on a wave, for every op.
+template<typename T, bool SOP2>
+static void check_evaluate(std::mt19937_64& rng, uint64_t seed)
+{
+    using E   = vega::Execute<T>;
+    using S0  = typename E::template Arg<0>;
+    using S1  = std::conditional_t<SOP2, typename E::template Arg<SOP2 ? 1 : 0>, S0>;
+    using D_t = std::remove_reference_t<typename E::template Arg<SOP2 ? 2 : 1>>;
+    vega::Instruction inst;
+    inst.format = SOP2 ? vega::Format::SOP2 : vega::Format::SOP1;
+    inst.OP     = T::ID;
+    inst.SDST   = static_cast<uint8_t>(rng() % 8);
+    inst.SSRC0  = static_cast<uint8_t>(rng() % 8);
+    inst.SSRC1  = static_cast<uint8_t>(rng() % 8);
+    vega::Wavefront wave = random_wave(rng);
+    const vega::Result before{ wave.read<D_t>(inst.SDST, 0), wave.SCC };
+    const uint64_t a = wave.read<S0>(inst.SSRC0, 0);
+    const uint64_t b = wave.read<S1>(inst.SSRC1, 0);
+
+    vega::Result want;
+    if constexpr (SOP2)
+    {
+        vega::execute_sop2<T>(wave, inst, 0);
+        want = vega::evaluate_sop2<T>(a, b, before);
+    }
+    else
+    {
+        vega::execute_sop1<T>(wave, inst, 0);
+        want = vega::evaluate_sop1<T>(a, before);
+    }
+    expect(wave.read<D_t>(inst.SDST, 0) == want.D && wave.SCC == want.SCC, "evaluate", seed);
+}
+
+template<typename... Sop1, typename... Sop2>
+static void check_evaluate_all(vega::InstructionList<Sop1...>, vega::InstructionList<Sop2...>)
+{
+    for (uint64_t seed = 0; seed < 2000; ++seed)
+    {
+        std::mt19937_64 rng(seed);
+        (check_evaluate<Sop1, false>(rng, seed), ...);
+        (check_evaluate<Sop2, true>(rng, seed), ...);
+    }
+}
+
+// Straight-line SOP1/SOP2 runs built mostly from constants, so fold_constants() has work to
+// do, broken up by SOPC/SOPK instructions it must not fold across. The folded translation
+// runs against the decoder.
+static void check_fold()
+{
+    namespace Operand = vega::Operand;
+    check_evaluate_all(vega::SOP1::ALL{}, vega::SOP2::ALL{});
+
+    static const std::vector<uint32_t> SOP1 = opcodes(vega::SOP1::ALL{});
+    static const std::vector<uint32_t> SOP2 = opcodes(vega::SOP2::ALL{});
+    static const std::vector<uint32_t> SOPC = opcodes(vega::SOPC::ALL{});
+    static const std::vector<uint32_t> SOPK = opcodes(vega::SOPK::ALL{});
+    size_t folded = 0;
+    for (uint64_t seed = 0; seed < 20000; ++seed)
+    {
+        std::mt19937_64 rng(seed);
+        const auto pick    = [&](const std::vector<uint32_t>& v) { return v[rng() % v.size()]; };
+        const auto dest    = [&] { return static_cast<uint32_t>(rng() % 11); };
+        const auto operand = [&]() -> uint32_t
+        {
+            switch (rng() % 6)
+            {
+                case 0:  return Operand::LITERAL;
+                case 1:
+                case 2:  return Operand::ZERO + rng() % 81;
+                case 3:  return Operand::SCC;
+                default: return rng() % 11;
+            }
+        };
+
+        std::vector<uint32_t> code;
+        const size_t length = 2 + rng() % 30;
+        for (size_t i = 0; i < length; ++i)
+        {
+            uint32_t word = 0;
+            switch (rng() % 8)
+            {
+                case 0:  word = pick(SOPC) | (operand() << 8) | operand(); break;
+                case 1:  word = pick(SOPK) | (dest() << 16) | static_cast<uint16_t>(rng()); break;
+                case 2:
+                case 3:  word = pick(SOP1) | (dest() << 16) | operand(); break;
+                default: word = pick(SOP2) | (dest() << 16) | (operand() << 8) | operand(); break;
+            }
+            code.push_back(word);
+            if (vega::has_literal(vega::decode(word))) code.push_back(static_cast<uint32_t>(rng() % 4 ? rng() : rng() % 64));
+        }
+        code.push_back(vega::SOPP::S_ENDPGM::hex());
+
+        const vega::Wavefront start = random_wave(rng);
+        vega::Wavefront decoded = start, uop = start;
+        vega::Translation translation = vega::translate(code);
+        folded += vega::fold_constants(translation);
+        const vega::Wavefront::Status want = decoded.run(code);
+        const vega::Wavefront::Status got  = uop.run(translation);
+        expect_same_run(uop, got, decoded, want, "fold_constants", seed);
+    }
+    expect(folded > 20000, "fold_constants folds", folded);
+}
+
+// Random scalar words through disassemble_one() and back through assemble(): every line
+// that is not .long must reassemble, disassemble to the same text, and without a literal
+// give back the same word. Disassembler::feed() in random chunks must print what one call does.
+static std::string disassemble_all(std::span<const uint8_t> code, std::mt19937_64* rng)
+{
+    std::FILE* out = std::tmpfile();
+    {
+        vega::Disassembler d(out);
+        size_t at = 0;
+        while (at < code.size())
+        {
+            const size_t chunk = rng ? std::min<size_t>(code.size() - at, 1 + (*rng)() % 64) : code.size();
+            const bool   last  = at + chunk == code.size();
+            at += d.feed(code.subspan(at, chunk), 0x1000 + at, last); // may take none of a short chunk
+        }
+    }
+    std::string text(static_cast<size_t>(std::ftell(out)), '\0');
+    std::rewind(out);
+    text.resize(std::fread(text.data(), 1, text.size(), out));
+    std::fclose(out);
+    return text;
+}
+
+static void check_disassembler()
+{
+    static const std::vector<uint32_t> OPCODES[] = {
+        opcodes(vega::SOP1::ALL{}), opcodes(vega::SOP2::ALL{}), opcodes(vega::SOPC::ALL{}),
+        opcodes(vega::SOPK::ALL{}), opcodes(vega::SOPP::ALL{}), opcodes(vega::SMEM::ALL{}) };
+    constexpr uint32_t FIELDS[] = { 0x007F00FF, 0x007FFFFF, 0x0000FFFF, 0x007FFFFF, 0x0000FFFF, 0x0003FFFF };
+
+    std::mt19937_64 rng(15);
+    uint64_t round_trips = 0;
+    char   line[vega::MAX_DISASSEMBLY_LINE], again[vega::MAX_DISASSEMBLY_LINE];
+    size_t length = 0, again_length = 0;
+    for (uint64_t i = 0; i < 2000000; ++i)
+    {
+        const size_t   format = rng() % std::size(OPCODES);
+        const auto&    ops    = OPCODES[format];
+        const uint32_t word   = ops[rng() % ops.size()] | (static_cast<uint32_t>(rng()) & FIELDS[format]);
+        const uint32_t second = rng() % 2 ? static_cast<uint32_t>(rng()) : static_cast<uint32_t>(rng() % 0x80);
+        const uint32_t words[] = { word, second };
+        const size_t covered = vega::disassemble_one(reinterpret_cast<const uint8_t*>(words), 2, line, length);
+        const std::string_view text(line, length);
+        if (text.starts_with(".long")) continue;
+
+        std::vector<uint32_t> code;
+        const vega::AssembleResult r = vega::assemble(text, code);
+        if (!r || code.empty())
+        {
+            std::printf("FAIL reassemble: %.*s: %s\n", static_cast<int>(length), line, r.error ? r.error : "nothing");
+            expect(false, "disassembler reassemble", word);
+            continue;
+        }
+        // A literal with an inline encoding comes back inline, so only the second pass is fixed.
+        vega::disassemble_one(reinterpret_cast<const uint8_t*>(code.data()), code.size(), again, again_length);
+        const std::string_view second_text(again, again_length);
+        if (code.size() == covered)
+        {
+            expect(second_text == text, "disassembler text", word);
+        }
+        else
+        {
+            std::vector<uint32_t> inline_code;
+            expect(code.size() == 1 && vega::assemble(second_text, inline_code) && inline_code == code, "disassembler inline literal", word);
+        }
+        expect(code.size() != 1 || covered != 1 || code[0] == word, "disassembler word", word);
+        ++round_trips;
+    }
+    expect(round_trips > 500000, "disassembler round trips", round_trips);
+
+    std::vector<uint32_t> stream(4096);
+    for (uint32_t& w : stream)
+    {
+        const auto& ops = OPCODES[rng() % std::size(OPCODES)];
+        w = rng() % 3 ? ops[rng() % ops.size()] | (static_cast<uint32_t>(rng()) & 0xFFFF) : static_cast<uint32_t>(rng());
+    }
+    const std::span<const uint8_t> bytes(reinterpret_cast<const uint8_t*>(stream.data()), stream.size() * 4);
+    const std::string whole = disassemble_all(bytes, nullptr);
+    for (uint64_t seed = 0; seed < 50; ++seed)
+    {
+        std::mt19937_64 chunks(seed);
+        expect(disassemble_all(bytes, &chunks) == whole, "Disassembler::feed chunks", seed);
+    }
+}
+
+// Code objects laid out the way llvm-mc writes them for gfx900: .strtab (also naming the
+// sections), .text with each kernel on a 256-byte boundary, .rodata with the 64-byte
+// descriptors, .symtab with a FUNC and an OBJECT "<name>.kd" symbol per kernel. A
+// relocatable image leaves the entry offsets to relocations; a shared one has addresses
+// and fills them in. `function` false leaves out a kernel's FUNC symbol.
+struct TestKernel
+{
+    std::string              name;
+    std::vector<uint32_t>    code;
+    vega::KernelDescriptor   descriptor;
+    bool                     function = true;
+};
+
+static std::vector<uint8_t> code_object(const std::vector<TestKernel>& kernels, bool relocatable)
+{
+    std::vector<uint8_t> image(0x100);
+    const auto put = [&](size_t at, auto value) { std::memcpy(image.data() + at, &value, sizeof value); };
+    const auto align = [&](size_t alignment) { image.resize((image.size() + alignment - 1) / alignment * alignment); };
+    const uint64_t base = relocatable ? 0 : 0x1000; // shared images: address = file offset + base
+
+    std::string strings(1, '\0');
+    const auto name = [&](const std::string& text) { strings += text + '\0'; return static_cast<uint32_t>(strings.size() - text.size() - 1); };
+
+    std::vector<size_t> code_at;
+    const size_t text_at = image.size();
+    for (const TestKernel& k : kernels)
+    {
+        align(256);
+        code_at.push_back(image.size());
+        image.resize(image.size() + k.code.size() * 4);
+        std::memcpy(image.data() + code_at.back(), k.code.data(), k.code.size() * 4);
+    }
+    const size_t text_size = image.size() - text_at;
+
+    align(64);
+    const size_t rodata_at = image.size();
+    for (size_t i = 0; i < kernels.size(); ++i)
+    {
+        const vega::KernelDescriptor& d = kernels[i].descriptor;
+        const size_t at = image.size();
+        image.resize(at + 64);
+        put(at + 0, d.group_segment_size);
+        put(at + 4, d.private_segment_size);
+        put(at + 8, d.kernarg_size);
+        put(at + 16, relocatable ? int64_t{ 0 } : static_cast<int64_t>(code_at[i]) - static_cast<int64_t>(at));
+        put(at + 44, d.rsrc3);
+        put(at + 48, d.rsrc1);
+        put(at + 52, d.rsrc2);
+        put(at + 56, d.properties);
+    }
+    const size_t rodata_size = image.size() - rodata_at;
+
+    enum : uint16_t { STRTAB = 1, TEXT, RODATA, SYMTAB, SECTIONS };
+    align(8);
+    const size_t symtab_at = image.size();
+    image.resize(image.size() + 24); // the null symbol
+    const auto symbol = [&](uint32_t name_at, uint8_t type, uint16_t section, uint64_t value, uint64_t size)
+    {
+        const size_t at = image.size();
+        image.resize(at + 24);
+        put(at + 0x00, name_at);
+        put(at + 0x04, static_cast<uint8_t>(0x10 | type)); // STB_GLOBAL
+        put(at + 0x06, section);
+        put(at + 0x08, value);
+        put(at + 0x10, size);
+    };
+    for (size_t i = 0; i < kernels.size(); ++i)
+    {
+        const size_t rodata_offset = rodata_at + i * 64;
+        if (kernels[i].function) symbol(name(kernels[i].name), vega::elf::STT_FUNC, TEXT, (relocatable ? code_at[i] - text_at : code_at[i] + base), kernels[i].code.size() * 4);
+        symbol(name(kernels[i].name + ".kd"), 1 /* STT_OBJECT */, RODATA, relocatable ? rodata_offset - rodata_at : rodata_offset + base, 64);
+    }
+    const size_t symtab_size = image.size() - symtab_at;
+
+    const uint32_t names[SECTIONS] = { 0, name(".strtab"), name(".text"), name(".rodata"), name(".symtab") };
+    const size_t strtab_at = image.size();
+    image.insert(image.end(), strings.begin(), strings.end());
+
+    align(8);
+    const size_t headers = image.size();
+    image.resize(headers + SECTIONS * 64);
+    const auto section = [&](uint16_t index, uint32_t type, uint64_t flags, size_t offset, size_t size, uint64_t address, uint64_t alignment)
+    {
+        const size_t at = headers + index * 64;
+        put(at + 0x00, names[index]);
+        put(at + 0x04, type);
+        put(at + 0x08, flags);
+        put(at + 0x10, address);
+        put(at + 0x18, static_cast<uint64_t>(offset));
+        put(at + 0x20, static_cast<uint64_t>(size));
+        put(at + 0x30, alignment);
+    };
+    section(STRTAB, 3, 0, strtab_at, strings.size(), 0, 1);
+    section(TEXT, 1, 0x6 /* AX */, text_at, text_size, relocatable ? 0 : text_at + base, 256);
+    section(RODATA, 1, 0x2 /* A */, rodata_at, rodata_size, relocatable ? 0 : rodata_at + base, 64);
+    section(SYMTAB, 2, 0, symtab_at, symtab_size, 0, 8);
+    put(headers + SYMTAB * 64 + 0x28, uint32_t{ STRTAB }); // sh_link
+    put(headers + SYMTAB * 64 + 0x2C, uint32_t{ 1 });      // sh_info: first global symbol
+    put(headers + SYMTAB * 64 + 0x38, uint64_t{ 24 });     // sh_entsize
+
+    std::memcpy(image.data(), "\x7F" "ELF\x02\x01\x01\x40\x02", 9); // ELFOSABI_AMDGPU_HSA, code object v4
+    put(0x10, relocatable ? vega::elf::ET_REL : vega::elf::ET_DYN);
+    put(0x12, vega::elf::EM_AMDGPU);
+    put(0x14, uint32_t{ 1 });
+    put(0x30, uint32_t{ 0x12C }); // EF_AMDGPU_MACH_AMDGCN_GFX900, xnack any
+    put(0x28, static_cast<uint64_t>(headers));
+    put(0x34, uint16_t{ 64 });
+    put(0x3A, uint16_t{ 64 });
+    put(0x3C, uint16_t{ SECTIONS });
+    put(0x3E, uint16_t{ STRTAB });
+    return image;
+}
+
+static void check_code_object()
+{
+    using Status = vega::CodeObject::Status;
+    std::mt19937_64 rng(16);
+    std::vector<TestKernel> kernels;
+    for (const char* name : { "add_one", "add", "scale_by_two" })
+    {
+        TestKernel k;
+        k.name = name;
+        k.code = program("s_add_u32 s2, s2, 1\n s_lshl_b32 s3, s2, 1\n s_endpgm\n");
+        k.code.insert(k.code.begin(), rng() % 6, vega::SOPP::S_NOP::hex());
+        k.descriptor.group_segment_size   = static_cast<uint32_t>(rng() % 65536);
+        k.descriptor.private_segment_size = static_cast<uint32_t>(rng() % 4096);
+        k.descriptor.kernarg_size         = static_cast<uint32_t>(rng() % 256);
+        k.descriptor.rsrc3                = static_cast<uint32_t>(rng());
+        k.descriptor.rsrc1                = static_cast<uint32_t>(rng());
+        k.descriptor.rsrc2                = static_cast<uint32_t>(rng());
+        k.descriptor.properties           = static_cast<uint16_t>(rng());
+        kernels.push_back(k);
+    }
+
+    for (bool relocatable : { true, false })
+    {
+        kernels[1].function = relocatable; // a shared image without it runs to the end of .text
+        const std::vector<uint8_t> image = code_object(kernels, relocatable);
+        vega::CodeObject object;
+        expect(object.open(image) == Status::OK, "CodeObject open", relocatable);
+
+        std::vector<std::string_view> names;
+        expect(object.kernel_names(names) == Status::OK && names.size() == 3 && names[0] == "add_one" && names[1] == "add"
+               && names[2] == "scale_by_two", "CodeObject kernel_names", relocatable);
+        for (const TestKernel& want : kernels)
+        {
+            vega::Kernel k;
+            const bool found = object.find(want.name, k) == Status::OK;
+            expect(found, "CodeObject find", relocatable);
+            if (!found) continue;
+            const vega::KernelDescriptor& d = k.descriptor;
+            expect(k.name == want.name && d.group_segment_size == want.descriptor.group_segment_size
+                   && d.private_segment_size == want.descriptor.private_segment_size && d.kernarg_size == want.descriptor.kernarg_size
+                   && d.rsrc1 == want.descriptor.rsrc1 && d.rsrc2 == want.descriptor.rsrc2 && d.rsrc3 == want.descriptor.rsrc3
+                   && d.properties == want.descriptor.properties, "CodeObject descriptor", relocatable);
+            vega::elf::Section text;
+            vega::elf::find_section(image, ".text", text);
+            const uint8_t* end = want.function ? reinterpret_cast<const uint8_t*>(k.code.data()) + want.code.size() * 4 : image.data() + text.offset + text.size;
+            expect(k.code.size() >= want.code.size() && std::equal(want.code.begin(), want.code.end(), k.code.begin())
+                   && reinterpret_cast<const uint8_t*>(k.code.data() + k.code.size()) == end, "CodeObject code", relocatable);
+
+            vega::Wavefront wave;
+            wave.SGPR[2] = 41;
+            expect(wave.run(k.code) == vega::Wavefront::Status::ENDED && wave.SGPR[2] == 42 && wave.SGPR[3] == 84, "CodeObject run", relocatable);
+        }
+        vega::Kernel k;
+        expect(object.find("add_on", k) == Status::NO_KERNEL && object.find("scale", k) == Status::NO_KERNEL, "CodeObject NO_KERNEL", relocatable);
+
+        // Every truncation fails cleanly or finds code inside what is left.
+        for (size_t size = 0; size < image.size(); ++size)
+        {
+            const std::span<const uint8_t> cut(image.data(), size);
+            vega::CodeObject truncated;
+            if (truncated.open(cut) != Status::OK) continue;
+            for (const TestKernel& want : kernels)
+            {
+                if (truncated.find(want.name, k) != Status::OK) continue;
+                const uint8_t* begin = reinterpret_cast<const uint8_t*>(k.code.data());
+                expect(begin >= cut.data() && begin + k.code.size_bytes() <= cut.data() + cut.size(), "CodeObject truncated", size);
+            }
+        }
+    }
+
+    kernels[1].function = false;
+    std::vector<uint8_t> image = code_object(kernels, true);
+    vega::CodeObject object;
+    vega::Kernel     k;
+    expect(object.open(image) == Status::OK && object.find("add", k) == Status::BAD_DESCRIPTOR, "CodeObject relocatable without FUNC", 0);
+    image[0x12] = 62; // EM_X86_64
+    expect(object.open(image) == Status::NOT_AMDGPU, "CodeObject NOT_AMDGPU", 0);
+
+    // Through a mapped file.
+    kernels[1].function = true;
+    image = code_object(kernels, true);
+    char path[] = "/tmp/vega_code_object_XXXXXX";
+    const int fd = mkstemp(path);
+    const bool written = fd >= 0 && write(fd, image.data(), image.size()) == static_cast<ssize_t>(image.size());
+    if (fd >= 0) close(fd);
+    vega::CodeObject mapped;
+    expect(written && mapped.open(path) == Status::OK && mapped.find("scale_by_two", k) == Status::OK
+           && k.descriptor.rsrc1 == kernels[2].descriptor.rsrc1, "CodeObject open(path)", 0);
+    expect(vega::CodeObject{}.open("/nonexistent/vega.o") == Status::CANNOT_OPEN, "CodeObject CANNOT_OPEN", 0);
+    if (fd >= 0) unlink(path);
+}
+
+// CycleModel issue times: independent and forwarded SALU ops issue every ISSUE_CYCLES, a use
+// of an SMEM result waits out the load's latency less whatever issued in between.
+static vega::CycleModel issue_all(const std::vector<uint32_t>& code)
+{
+    vega::CycleModel timing;
+    for (size_t at = 0; at < code.size(); ++at)
+    {
+        const vega::Instruction inst = vega::decode(code[at]);
+        const uint32_t literal = vega::has_literal(inst) ? code[++at] : 0;
+        timing.issue(inst, literal);
+    }
+    return timing;
+}
+
+static void check_timing()
+{
+    constexpr uint64_t SLOT = vega::CycleModel::ISSUE_CYCLES;
+    constexpr uint64_t LOAD = vega::SMEM::S_LOAD_DWORD::LATENCY;
+
+    std::string independent, dependent;
+    for (int i = 0; i < 8; ++i)
+    {
+        independent += "s_add_u32 s" + std::to_string(i) + ", s" + std::to_string(i + 8) + ", 1\n";
+        dependent   += "s_add_u32 s0, s0, 1\n";
+    }
+    const vega::CycleModel apart = issue_all(program(independent.c_str()));
+    const vega::CycleModel chain = issue_all(program(dependent.c_str()));
+    expect(apart.cycles() == 8 * SLOT && apart.stalls == 0 && apart.instructions == 8, "CycleModel independent", apart.cycles());
+    expect(chain.cycles() == 8 * SLOT && chain.stalls == 0, "CycleModel forwarded", chain.cycles());
+
+    for (uint64_t between = 0; between <= LOAD; ++between)
+    {
+        std::string source = "s_load_dword s2, s[0:1], 0x0\n";
+        for (uint64_t i = 0; i < between; ++i) source += "s_add_u32 s4, s5, 1\n";
+        source += "s_add_u32 s3, s2, 1\n";
+        const vega::CycleModel t = issue_all(program(source.c_str()));
+        const uint64_t stall = between + 1 < LOAD ? (LOAD - 1 - between) * SLOT : 0;
+        expect(t.stalls == stall && t.cycles() == (between + 2) * SLOT + stall, "CycleModel load use", between);
+    }
+
+    // SCC written by a load-dependent compare holds up the branch behind it.
+    const vega::CycleModel branch = issue_all(program("s_load_dword s2, s[0:1], 0x0\n s_cmp_eq_u32 s2, 0\n s_cbranch_scc1 1\n s_nop 0\n"));
+    expect(branch.stalls == (LOAD - 1) * SLOT && branch.SOPP[vega::SOPP::S_CBRANCH_SCC1::ID].cycles == SLOT, "CycleModel SCC", branch.stalls);
+
+    // A lone load: cycles() runs until its result is ready.
+    const vega::CycleModel alone = issue_all(program("s_load_dword s2, s[0:1], 0x0\n"));
+    expect(alone.cycles() == LOAD * SLOT, "CycleModel finish", alone.cycles());
+
+    // As a run-loop observer every executed instruction is counted once.
+    vega::Wavefront  wave;
+    vega::CycleModel observed;
+    const std::vector<uint32_t> loop = program("s_movk_i32 s2, 5\nloop:\n s_addk_i32 s2, -1\n s_cmp_lg_u32 s2, 0\n s_cbranch_scc1 loop\n s_endpgm\n");
+    wave.run(loop, observed);
+    expect(observed.instructions == 1 + 5 * 3 + 1 && observed.SOPK[vega::SOPK::S_ADDK_I32::ID].count == 5, "CycleModel observer", observed.instructions);
+}
+
+// A loop long enough to wrap the Tracer's ring: every instruction reaches the file once, in
+// order, and a TraceFile that could not be opened takes the records without stalling.
+static void check_trace()
+{
+    const std::vector<uint32_t> loop = program("s_mov_b32 s2, 30000\nloop:\n s_addk_i32 s2, -1\n s_cmp_lg_u32 s2, 0\n s_cbranch_scc1 loop\n s_endpgm\n");
+    constexpr uint64_t EXECUTED = 1 + 30000 * 3 + 1;
+    static_assert(EXECUTED > vega::TraceRing::CAPACITY);
+
+    {
+        vega::TraceFile nowhere("/nonexistent/dir/x.vtrace");
+        vega::Tracer    tracer(nowhere, 0);
+        vega::Wavefront wave;
+        expect(!nowhere.ok() && wave.run(loop, tracer) == vega::Wavefront::Status::ENDED && tracer.pending.seq == EXECUTED,
+               "TraceFile unopened", tracer.pending.seq);
+    }
+
+    char path[] = "/tmp/vega_trace_XXXXXX";
+    const int fd = mkstemp(path);
+    if (fd < 0)
+    {
+        expect(false, "TraceFile mkstemp", 0);
+        return;
+    }
+    close(fd);
+    {
+        vega::TraceFile file(path);
+        vega::Tracer    tracer(file, 7);
+        vega::Wavefront wave;
+        wave.run(loop, tracer);
+        expect(file.ok(), "TraceFile ok", 0);
+    }
+
+    std::FILE* in = std::fopen(path, "rb");
+    vega::TraceHeader header;
+    bool ok = in != nullptr && std::fread(&header, sizeof header, 1, in) == 1 && header.magic == vega::TraceHeader::MAGIC
+           && header.record_size == sizeof(vega::TraceRecord);
+    uint64_t seen = 0;
+    uint32_t chunk[2];
+    while (ok && std::fread(chunk, sizeof chunk, 1, in) == 1)
+    {
+        ok = chunk[0] == 7;
+        for (uint32_t i = 0; ok && i < chunk[1]; ++i)
+        {
+            vega::TraceRecord r;
+            ok = std::fread(&r, sizeof r, 1, in) == 1 && r.seq == seen;
+            // The loop body is s_addk_i32, s_cmp_lg_u32, s_cbranch_scc1 at 8, 12, 16.
+            ok = ok && (seen == 0 || seen == EXECUTED - 1 ? true : r.PC == 8 + (seen - 1) % 3 * 4);
+            ++seen;
+        }
+    }
+    if (in != nullptr) std::fclose(in);
+    unlink(path);
+    expect(ok && seen == EXECUTED, "TraceFile records", seen);
+}
+
+// Checkpointer snapshots of a VALU loop against copies of the wave taken at the same
+// instructions. Enough snapshots are taken to pass two keyframes, so restore() replays deltas
+// from each; a restored wave resumes to the same end state; save()/load() keep all of it,
+// and load() rejects files whose counts or encoded runs do not fit.
+struct Recorder
+{
+    vega::Checkpointer&          checkpoints;
+    std::vector<vega::Wavefront> states; // the wave as each snapshot saw it
+
+    void issue(const vega::Wavefront& w, uint32_t PC, const vega::Instruction& inst, uint32_t literal)
+    {
+        const size_t taken = checkpoints.snapshots.size();
+        checkpoints.issue(w, PC, inst, literal);
+        if (checkpoints.snapshots.size() != taken)
+        {
+            states.push_back(w);
+            states.back().PC = PC;
+        }
+    }
+
+    void retire(const vega::Wavefront&, const vega::Instruction&) {}
+};
+
+static bool same_state(const vega::Wavefront& a, const vega::Wavefront& b)
+{
+    return std::memcmp(a.SGPR, b.SGPR, sizeof a.SGPR) == 0 && a.SCC == b.SCC && a.PC == b.PC
+        && std::memcmp(a.VGPR, b.VGPR, sizeof a.VGPR) == 0;
+}
+
+static bool restores(const vega::Checkpointer& checkpoints, const std::vector<vega::Wavefront>& states)
+{
+    bool ok = checkpoints.snapshots.size() == states.size();
+    for (size_t k = 0; ok && k < states.size(); ++k)
+    {
+        auto again = std::make_unique<vega::Wavefront>();
+        ok = checkpoints.restore(k, *again) && same_state(*again, states[k]);
+    }
+    return ok;
+}
+
+static void check_checkpoint()
+{
+    static const std::vector<uint32_t> VOP1 = opcodes(vega::VOP1::ALL{});
+    static const std::vector<uint32_t> VOP2 = opcodes(vega::VOP2::ALL{});
+    std::mt19937_64 rng(20);
+    std::vector<uint32_t> code = { vega::SOPK::S_MOVK_I32::hex() | (12u << 16) | 150 };
+    for (int i = 0; i < 12; ++i)
+    {
+        const uint32_t vdst = static_cast<uint32_t>(rng() % vega::Wavefront::VGPR_COUNT);
+        const uint32_t src0 = rng() % 2 ? 256 + static_cast<uint32_t>(rng() % vega::Wavefront::VGPR_COUNT) : static_cast<uint32_t>(rng() % 12);
+        const uint32_t word = rng() % 3 ? VOP2[rng() % VOP2.size()] | (static_cast<uint32_t>(rng() % vega::Wavefront::VGPR_COUNT) << 9) : VOP1[rng() % VOP1.size()];
+        code.push_back(word | (vdst << 17) | src0);
+    }
+    code.push_back(vega::SOPK::S_ADDK_I32::hex() | (12u << 16) | 0xFFFF);
+    code.push_back(vega::SOPC::S_CMP_LG_U32::hex() | (uint32_t{ vega::Operand::ZERO } << 8) | 12);
+    code.push_back(vega::SOPP::S_CBRANCH_SCC1::hex() | static_cast<uint16_t>(-15)); // back to the first VOP
+    code.push_back(vega::SOPP::S_ENDPGM::hex());
+
+    auto start = std::make_unique<vega::Wavefront>(random_wave(rng));
+    for (auto& row : start->VGPR)
+    {
+        for (uint32_t& lane : row) lane = rng() % 4 ? 0 : static_cast<uint32_t>(rng());
+    }
+    vega::SgprPair::store(&start->SGPR[vega::Operand::EXEC_LO], rng());
+
+    vega::Checkpointer checkpoints;
+    checkpoints.interval = 11;
+    Recorder recorder{ checkpoints, {} };
+    auto ended = std::make_unique<vega::Wavefront>(*start);
+    ended->run(code, recorder);
+    expect(checkpoints.snapshots.size() > 2 * vega::Checkpointer::KEYFRAME_INTERVAL, "Checkpointer keyframes", checkpoints.snapshots.size());
+    expect(restores(checkpoints, recorder.states), "Checkpointer restore", 0);
+
+    for (size_t k : { size_t{ 1 }, size_t{ vega::Checkpointer::KEYFRAME_INTERVAL + 5 }, checkpoints.snapshots.size() - 1 })
+    {
+        auto resumed = std::make_unique<vega::Wavefront>();
+        checkpoints.restore(k, *resumed);
+        resumed->run(code);
+        expect(same_state(*resumed, *ended), "Checkpointer resume", k);
+    }
+    vega::Wavefront unused;
+    expect(!checkpoints.restore(checkpoints.snapshots.size(), unused), "Checkpointer restore past the end", 0);
+
+    char path[] = "/tmp/vega_checkpoint_XXXXXX";
+    const int fd = mkstemp(path);
+    if (fd < 0)
+    {
+        expect(false, "Checkpointer mkstemp", 0);
+        return;
+    }
+    close(fd);
+    vega::Checkpointer loaded;
+    expect(checkpoints.save(path) && loaded.load(path) && loaded.interval == checkpoints.interval
+           && restores(loaded, recorder.states), "Checkpointer save/load", 0);
+
+    // Damaged files: truncated, a snapshot offset past `data`, a run longer than its page, a
+    // run reaching past the end of `data`.
+    const auto damaged = [&](const auto& damage)
+    {
+        vega::Checkpointer copy = checkpoints;
+        std::vector<char> bytes;
+        damage(copy, bytes);
+        if (bytes.empty() && !copy.save(path)) return false;
+        if (!bytes.empty())
+        {
+            std::FILE* f = std::fopen(path, "wb");
+            const bool written = f != nullptr && std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+            if (f != nullptr) std::fclose(f);
+            if (!written) return false;
+        }
+        vega::Checkpointer bad;
+        return !bad.load(path) && bad.snapshots.empty() && bad.data.empty();
+    };
+    expect(damaged([&](vega::Checkpointer&, std::vector<char>& bytes)
+    {
+        checkpoints.save(path);
+        std::FILE* f = std::fopen(path, "rb");
+        bytes.resize(4096);
+        bytes.resize(f ? std::fread(bytes.data(), 1, bytes.size(), f) : 0);
+        if (f) std::fclose(f);
+    }), "Checkpointer truncated", 0);
+    expect(damaged([](vega::Checkpointer& c, std::vector<char>&) { c.snapshots[3].offset = c.data.size() + 1; }), "Checkpointer offset", 0);
+    expect(damaged([](vega::Checkpointer& c, std::vector<char>&) { c.data[c.snapshots[0].offset] = vega::Checkpointer::PAGE_DWORDS + 1; }), "Checkpointer run", 0);
+    expect(damaged([](vega::Checkpointer& c, std::vector<char>&) { c.data[c.snapshots[5].offset] = 0; }), "Checkpointer empty run", 0);
+    expect(damaged([](vega::Checkpointer& c, std::vector<char>&)
+    {
+        c.snapshots.back().pages = ~uint64_t{ 0 };
+        c.data.resize(c.snapshots.back().offset + 1);
+        c.data.back() = 0xFFFF0000; // 65535 XOR dwords that are not there
+    }), "Checkpointer overrun", 0);
+    unlink(path);
+}
+
+// SOPC and SOPK against the ISA's definitions, written out here apart from vega.hpp, through
+// the decoder and through a translation.
+template<typename V>
+static bool compare(std::string_view cc, V a, V b)
+{
+    if (cc == "EQ") return a == b;
+    if (cc == "LG") return a != b;
+    if (cc == "GT") return a > b;
+    if (cc == "GE") return a >= b;
+    if (cc == "LT") return a < b;
+    return a <= b; // LE
+}
+
+static bool reference_sopc(std::string_view name, uint64_t a, uint64_t b)
+{
+    if (name.starts_with("S_BITCMP"))
+    {
+        const bool wide = name.ends_with("B64");
+        const bool bit  = ((wide ? a : static_cast<uint32_t>(a)) >> (b & (wide ? 63 : 31))) & 1;
+        return bit == (name[8] == '1');
+    }
+    const std::string_view cc = name.substr(6, 2);
+    if (name.ends_with("I32")) return compare(cc, static_cast<int32_t>(a), static_cast<int32_t>(b));
+    if (name.ends_with("U32")) return compare(cc, static_cast<uint32_t>(a), static_cast<uint32_t>(b));
+    return compare(cc, a, b);
+}
+
+// D and SCC after a SOPK instruction.
+static std::pair<uint32_t, bool> reference_sopk(std::string_view name, uint16_t imm, uint32_t D, bool SCC)
+{
+    const int32_t  sext = static_cast<int16_t>(imm);
+    if (name == "S_MOVK_I32")  return { static_cast<uint32_t>(sext), SCC };
+    if (name == "S_CMOVK_I32") return { SCC ? static_cast<uint32_t>(sext) : D, SCC };
+    if (name == "S_MULK_I32")  return { static_cast<uint32_t>(static_cast<int64_t>(static_cast<int32_t>(D)) * sext), SCC };
+    if (name == "S_ADDK_I32")
+    {
+        const int64_t sum = static_cast<int64_t>(static_cast<int32_t>(D)) + sext;
+        return { static_cast<uint32_t>(sum), sum != static_cast<int32_t>(sum) };
+    }
+    const std::string_view cc = name.substr(7, 2);
+    return { D, name.ends_with("I32") ? compare(cc, static_cast<int32_t>(D), sext) : compare(cc, D, uint32_t{ imm }) };
+}
+
+template<typename T>
+static void check_sopc(std::mt19937_64& rng, uint64_t seed)
+{
+    const bool     wide0 = std::string_view(T::NAME).ends_with("64");
+    const bool     wide1 = wide0 && !std::string_view(T::NAME).starts_with("S_BITCMP");
+    const uint32_t src0  = rng() % 3 == 0 ? vega::Operand::ZERO + rng() % 81 : (rng() % 8) & (wide0 ? ~1u : ~0u);
+    const uint32_t src1  = rng() % 3 == 0 ? vega::Operand::LITERAL : (rng() % 8) & (wide1 ? ~1u : ~0u);
+    const uint32_t literal = static_cast<uint32_t>(rng() % 2 ? rng() : rng() % 70);
+    std::vector<uint32_t> code = { T::hex() | (src1 << 8) | src0 };
+    if (src1 == vega::Operand::LITERAL) code.push_back(literal);
+    code.push_back(vega::SOPP::S_ENDPGM::hex());
+
+    const vega::Wavefront start = random_wave(rng);
+    const uint64_t a = wide0 ? start.read<uint64_t>(static_cast<uint8_t>(src0), literal) : start.read<uint32_t>(static_cast<uint8_t>(src0), literal);
+    const uint64_t b = wide1 ? start.read<uint64_t>(static_cast<uint8_t>(src1), literal) : start.read<uint32_t>(static_cast<uint8_t>(src1), literal);
+    const bool want = reference_sopc(T::NAME, a, b);
+    vega::Wavefront decoded = start, uop = start;
+    decoded.run(code);
+    uop.run(vega::translate(code));
+    expect(decoded.SCC == want && uop.SCC == want && std::memcmp(decoded.SGPR, start.SGPR, sizeof start.SGPR) == 0, T::NAME, seed);
+}
+
+template<typename T>
+static void check_sopk(std::mt19937_64& rng, uint64_t seed)
+{
+    const uint32_t sdst = static_cast<uint32_t>(rng() % 8);
+    const uint16_t imm  = static_cast<uint16_t>(rng() % 2 ? rng() : rng() % 8 - 4);
+    const std::vector<uint32_t> code = { T::hex() | (sdst << 16) | imm, vega::SOPP::S_ENDPGM::hex() };
+
+    const vega::Wavefront start = random_wave(rng);
+    const auto [D, SCC] = reference_sopk(T::NAME, imm, start.SGPR[sdst], start.SCC);
+    vega::Wavefront decoded = start, uop = start;
+    decoded.run(code);
+    uop.run(vega::translate(code));
+    for (const vega::Wavefront* w : { &decoded, &uop })
+    {
+        bool same = w->SGPR[sdst] == D && w->SCC == SCC;
+        for (uint32_t r = 0; r < 128; ++r) same = same && (r == sdst || w->SGPR[r] == start.SGPR[r]);
+        expect(same, T::NAME, seed);
+    }
+}
+
+template<typename... Cs, typename... Ks>
+static void check_compares(vega::InstructionList<Cs...>, vega::InstructionList<Ks...>)
+{
+    for (uint64_t seed = 0; seed < 5000; ++seed)
+    {
+        std::mt19937_64 rng(seed);
+        (check_sopc<Cs>(rng, seed), ...);
+        (check_sopk<Ks>(rng, seed), ...);
+    }
+}
+
+// Branches: every SOPP branch taken and not taken, a chain through thousands of labelled
+// blocks laid out in random order (forward and backward references, run by every backend),
+// translate()'s block links and LEAVE targets, and the assembler's label errors.
+static void check_control()
+{
+    check_compares(vega::SOPC::ALL{}, vega::SOPK::ALL{});
+
+    struct Case
+    {
+        const char* setup;
+        const char* branch;
+        bool        taken;
+    };
+    const Case cases[] = {
+        { "s_cmp_eq_u32 0, 0",       "s_cbranch_scc1", true  }, { "s_cmp_eq_u32 0, 1",       "s_cbranch_scc1", false },
+        { "s_cmp_eq_u32 0, 1",       "s_cbranch_scc0", true  }, { "s_cmp_eq_u32 0, 0",       "s_cbranch_scc0", false },
+        { "s_mov_b64 vcc, 0",        "s_cbranch_vccz", true  }, { "s_mov_b32 vcc_hi, 1",     "s_cbranch_vccz", false },
+        { "s_mov_b32 vcc_hi, 1",     "s_cbranch_vccnz", true }, { "s_mov_b64 vcc, 0",        "s_cbranch_vccnz", false },
+        { "s_mov_b64 exec, 0",       "s_cbranch_execz", true }, { "s_mov_b32 exec_lo, 4",    "s_cbranch_execz", false },
+        { "s_mov_b32 exec_lo, 4",    "s_cbranch_execnz", true }, { "s_mov_b64 exec, 0",      "s_cbranch_execnz", false },
+        { "s_nop 0",                 "s_branch", true },
+    };
+    for (const Case& c : cases)
+    {
+        const std::string source = std::string(c.setup) + "\n " + c.branch + " over\n s_mov_b32 s0, 1\nover:\n s_endpgm\n";
+        const std::vector<uint32_t> code = program(source.c_str());
+        vega::Wavefront decoded, uop;
+        decoded.set_exec(~0ULL);
+        uop.set_exec(~0ULL);
+        decoded.run(code);
+        uop.run(vega::translate(code));
+        expect(decoded.SGPR[0] == (c.taken ? 0u : 1u) && uop.SGPR[0] == decoded.SGPR[0], c.branch, c.taken);
+    }
+
+    // s0 counts the blocks visited, s1 accumulates their numbers.
+    constexpr int CHAIN = 3000;
+    std::mt19937_64 rng(21);
+    std::vector<int> order(CHAIN), layout(CHAIN);
+    for (int i = 0; i < CHAIN; ++i) order[i] = layout[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+    std::shuffle(layout.begin(), layout.end(), rng);
+    std::vector<int> after(CHAIN);
+    for (int i = 0; i < CHAIN; ++i) after[order[i]] = i + 1 < CHAIN ? order[i + 1] : -1;
+    std::string source = "s_branch block" + std::to_string(order[0]) + "\n";
+    for (int block : layout)
+    {
+        const std::string next = after[block] < 0 ? "done" : "block" + std::to_string(after[block]);
+        source += "block" + std::to_string(block) + ": s_add_u32 s0, s0, 1\n s_add_u32 s1, s1, " + std::to_string(block) + "\n";
+        source += (block % 2 ? " s_cbranch_scc0 " : " s_branch ") + next + "\n";
+    }
+    source += "done:\n s_endpgm\n";
+    const std::vector<uint32_t> chain = program(source.c_str());
+    const vega::Translation translation = vega::translate(chain);
+    vega::JitCache cache;
+    vega::Wavefront decoded, uop, threaded, jit;
+    const vega::Wavefront::Status statuses[] = {
+        decoded.run(chain), uop.run(translation), vega::run_threaded(threaded, vega::thread_code(translation)), vega::run_jit(jit, translation, cache) };
+    constexpr uint32_t SUM = CHAIN * (CHAIN - 1) / 2;
+    int backend = 0;
+    for (const vega::Wavefront* w : { &decoded, &uop, &threaded, &jit })
+    {
+        expect(statuses[backend] == vega::Wavefront::Status::ENDED && w->SGPR[0] == CHAIN && w->SGPR[1] == SUM, "branch chain", backend);
+        ++backend;
+    }
+
+    // The loop's branch links back to the block at the label.
+    const vega::Translation loop = vega::translate(program("s_movk_i32 s2, 3\nloop:\n s_addk_i32 s2, -1\n s_cmp_lg_u32 s2, 0\n s_cbranch_scc1 loop\n s_endpgm\n"));
+    const auto back = std::find_if(loop.blocks.begin(), loop.blocks.end(), [&](const vega::Block& b) { return b.control && loop.ops[b.end].inst.OP == vega::SOPP::S_CBRANCH_SCC1::ID; });
+    expect(back != loop.blocks.end() && back->taken < loop.blocks.size() && loop.ops[loop.blocks[back->taken].first].PC == 4, "translate back branch", 0);
+
+    // Into a literal: ILLEGAL at that PC. Past the end: ENDED there.
+    vega::Wavefront wave;
+    expect(wave.run(vega::translate(program("s_mov_b32 s0, 0x12345678\n s_branch -2\n s_endpgm\n"))) == vega::Wavefront::Status::ILLEGAL && wave.PC == 4,
+           "branch into a literal", wave.PC);
+    wave = vega::Wavefront{};
+    expect(wave.run(vega::translate(program("s_branch 5\n s_endpgm\n"))) == vega::Wavefront::Status::ENDED && wave.PC == 24, "branch past the end", wave.PC);
+
+    // Labels: on an instruction's line, before and after use; errors point at the label.
+    const std::vector<uint32_t> inline_label = program("start: s_branch end\n s_nop 0\nend: s_cbranch_scc1 start\n");
+    expect(inline_label.size() == 3 && inline_label[0] == (vega::SOPP::S_BRANCH::hex() | 1) && inline_label[2] == (vega::SOPP::S_CBRANCH_SCC1::hex() | 0xFFFD),
+           "assemble labels", inline_label.size());
+    std::vector<uint32_t> out;
+    vega::AssembleResult r = vega::assemble("a: s_nop 0\n  a: s_nop 0\n", out);
+    expect(!r && std::string_view(r.error) == "label defined twice" && r.line == 2 && r.column == 3, "label defined twice", r.line);
+    r = vega::assemble("s_nop 0\n s_nop 0\n  s_branch  nowhere\n", out);
+    expect(!r && std::string_view(r.error) == "undefined label" && r.line == 3 && r.column == 13, "undefined label", r.column);
+    std::string far = "s_branch far\n";
+    for (int i = 0; i < 33000; ++i) far += "s_nop 0\n";
+    far += "far: s_endpgm\n";
+    r = vega::assemble(far, out);
+    expect(!r && std::string_view(r.error) == "branch target out of range" && r.line == 1, "branch target out of range", r.line);
+}
+
+// salu_handler() and run_threaded() against wave_handler() for every SSRC0/SSRC1 encoding of
+// every SOP1, SOP2 and SOPC opcode, from a random wave each. The scc_live false and scc_dead
+// variants may leave SCC stale.
+template<size_t N>
+static size_t check_kinds(vega::Format format, const std::array<vega::WaveHandler, N>& table, bool two_sources)
+{
+    size_t cases = 0;
+    for (uint32_t op = 0; op < N; ++op)
+    {
+        if (table[op] == nullptr) continue;
+        for (uint32_t sources = 0; sources < (two_sources ? 1u << 16 : 1u << 8); ++sources)
+        {
+            std::mt19937_64 rng(op << 16 | sources);
+            vega::Instruction inst;
+            inst.format = format;
+            inst.OP     = static_cast<uint8_t>(op);
+            inst.SDST   = static_cast<uint8_t>(rng() % 128);
+            inst.SSRC0  = static_cast<uint8_t>(sources);
+            inst.SSRC1  = static_cast<uint8_t>(sources >> 8);
+            const uint32_t literal = static_cast<uint32_t>(rng());
+
+            vega::Wavefront want = random_wave(rng);
+            want.PC = 4 * static_cast<uint32_t>(rng() % 1024);
+            const vega::Wavefront start = want;
+            vega::Wavefront live = want, dead = want;
+            vega::wave_handler(inst)(want, inst, literal);
+            vega::salu_handler(inst, true)(live, inst, literal);
+            vega::salu_handler(inst, false)(dead, inst, literal);
+            dead.SCC = want.SCC;
+            expect(same_state(live, want), "salu_handler", op << 16 | sources);
+            expect(same_state(dead, want), "salu_handler scc dead", op << 16 | sources);
+
+            // run_threaded() picks its label from the same kinds.
+            vega::Translation translation;
+            translation.ops     = { vega::MicroOp{ vega::salu_handler(inst), inst, literal } };
+            translation.exit_pc = want.PC;
+            for (const bool scc_dead : { false, true })
+            {
+                translation.ops[0].scc_dead = scc_dead;
+                vega::Wavefront threaded = start;
+                vega::run_threaded(threaded, vega::thread_code(translation));
+                if (scc_dead) threaded.SCC = want.SCC;
+                expect(same_state(threaded, want), scc_dead ? "run_threaded scc dead" : "run_threaded", op << 16 | sources);
+            }
+            ++cases;
+        }
+    }
+    return cases;
+}
+
+static void check_salu()
+{
+    size_t cases = check_kinds(vega::Format::SOP1, vega::WAVE_SOP1_TABLE, false);
+    cases += check_kinds(vega::Format::SOP2, vega::WAVE_SOP2_TABLE, true);
+    cases += check_kinds(vega::Format::SOPC, vega::WAVE_SOPC_TABLE, true);
+    expect(cases > 3000000, "salu_handler cases", cases);
+}
+
+// Memory, Tlb and the SMEM loads: random loads straddling pages against Memory::read(), the
+// NUM_RECORDS clamp of the buffer loads, and map_file() pages that are copied on first write.
+static uint32_t memory_word(uint64_t address)
+{
+    return static_cast<uint32_t>(address * 0x9E3779B1ULL >> 7) | 1;
+}
+
+static void check_memory()
+{
+    constexpr uint64_t HIGH = 0x7F1234560000ULL;
+    vega::Memory memory;
+    std::vector<uint32_t> words(4 * vega::Memory::PAGE_SIZE / sizeof(uint32_t));
+    for (size_t i = 0; i < words.size(); ++i) words[i] = memory_word(HIGH + 4 * i);
+    memory.write(HIGH, words.data(), words.size() * sizeof(uint32_t));
+    expect(memory.resident == 4, "Memory resident", memory.resident);
+    uint32_t far = 1;
+    memory.read(0x123456789000ULL, &far, sizeof far);
+    expect(far == 0 && memory.resident == 4, "Memory unwritten reads zero", far);
+
+    // Loads of every width at offsets around the page boundaries, so many straddle two pages.
+    constexpr const char* LOADS[] = { "s_load_dword s8", "s_load_dwordx2 s[8:9]", "s_load_dwordx4 s[8:11]",
+                                      "s_load_dwordx8 s[8:15]", "s_load_dwordx16 s[8:23]" };
+    std::mt19937_64 rng(25);
+    vega::Wavefront wave;
+    wave.tlb.attach(&memory);
+    for (int i = 0; i < 20000; ++i)
+    {
+        const int      width  = static_cast<int>(rng() % 5);
+        const uint64_t page   = 1 + rng() % 3;
+        const int64_t  offset = static_cast<int64_t>(rng() % 32) * 4 - 64;
+        const uint64_t at     = HIGH + page * vega::Memory::PAGE_SIZE + offset;
+        char source[96];
+        std::snprintf(source, sizeof source, "%s, s[0:1], 0x%x\n s_endpgm\n", LOADS[width],
+                      static_cast<unsigned>(at & 0xFFFF));
+        wave.PC = 0;
+        wave.SGPR[0] = static_cast<uint32_t>(at & ~uint64_t{ 0xFFFF });
+        wave.SGPR[1] = static_cast<uint32_t>(at >> 32);
+        wave.run(program(source));
+        uint32_t want[16];
+        memory.read(at, want, sizeof(uint32_t) << width);
+        expect(std::memcmp(&wave.SGPR[8], want, sizeof(uint32_t) << width) == 0, "SMEM page-crossing load", i);
+    }
+    expect(wave.tlb.misses < 20000, "Tlb hits", wave.tlb.misses);
+
+    // s_buffer_load_dwordx8 from base HIGH with NUM_RECORDS in s14: dwords from NUM_RECORDS on read zero.
+    for (uint32_t records = 0; records < 48; ++records)
+    {
+        for (uint32_t offset = 0; offset < 40; offset += 4)
+        {
+            char source[96];
+            std::snprintf(source, sizeof source, "s_buffer_load_dwordx8 s[16:23], s[12:15], 0x%x\n s_endpgm\n", offset);
+            vega::Wavefront buffer;
+            buffer.tlb.attach(&memory);
+            buffer.SGPR[12] = static_cast<uint32_t>(HIGH);
+            buffer.SGPR[13] = static_cast<uint32_t>(HIGH >> 32) | 0xFFFF0000; // STRIDE is not part of the base
+            buffer.SGPR[14] = records;
+            std::fill(&buffer.SGPR[16], &buffer.SGPR[24], 0xDEADBEEF);
+            buffer.run(program(source));
+            bool ok = true;
+            for (uint32_t d = 0; d < 8; ++d)
+            {
+                const uint32_t want = offset + 4 * d < records ? words[offset / 4 + d] : 0;
+                ok &= buffer.SGPR[16 + d] == want;
+            }
+            expect(ok, "SMEM NUM_RECORDS clamp", uint64_t{ records } << 32 | offset);
+        }
+    }
+
+    // No memory attached: every load reads zeros.
+    vega::Wavefront detached;
+    detached.SGPR[0] = static_cast<uint32_t>(HIGH);
+    detached.SGPR[1] = static_cast<uint32_t>(HIGH >> 32);
+    detached.SGPR[8] = 0xDEADBEEF;
+    detached.run(program("s_load_dwordx2 s[8:9], s[0:1], 0x0\n s_endpgm\n"));
+    expect(detached.SGPR[8] == 0 && detached.SGPR[9] == 0, "SMEM without memory", detached.SGPR[8]);
+
+    // A mapped file: one whole page into the mapping and a copied tail.
+    char path[] = "/tmp/vega_memory_XXXXXX";
+    const int fd = mkstemp(path);
+    std::vector<uint32_t> file(2000);
+    for (uint32_t i = 0; i < file.size(); ++i) file[i] = i;
+    const bool written = fd >= 0 && write(fd, file.data(), file.size() * sizeof(uint32_t)) == static_cast<ssize_t>(file.size() * sizeof(uint32_t));
+    if (fd >= 0) close(fd);
+    constexpr uint64_t MAPPED = 0x200000000ULL;
+    expect(!memory.map_file(MAPPED + 4, path), "Memory map_file unaligned", 0);
+    expect(!memory.map_file(MAPPED, "/nonexistent/vega.bin"), "Memory map_file missing", 0);
+    const size_t resident = memory.resident;
+    expect(written && memory.map_file(MAPPED, path) && memory.resident == resident + 1, "Memory map_file", memory.resident);
+
+    vega::Wavefront mapped;
+    mapped.tlb.attach(&memory);
+    mapped.SGPR[0] = static_cast<uint32_t>(MAPPED);
+    mapped.SGPR[1] = static_cast<uint32_t>(MAPPED >> 32);
+    const std::vector<uint32_t> load = program("s_load_dwordx2 s[8:9], s[0:1], 0x190\n s_load_dword s10, s[0:1], 0x1f3c\n s_endpgm\n");
+    mapped.run(load);
+    expect(mapped.SGPR[8] == 100 && mapped.SGPR[9] == 101 && mapped.SGPR[10] == 1999, "SMEM mapped file", mapped.SGPR[8]);
+
+    // A write copies the page: the load sees it through a stale Tlb, the file does not.
+    const uint32_t value = 77;
+    memory.write(MAPPED + 4 * 100, &value, sizeof value);
+    mapped.PC = 0;
+    mapped.run(load);
+    expect(mapped.SGPR[8] == 77 && mapped.SGPR[9] == 101 && memory.resident == resident + 2, "Memory copy on write", mapped.SGPR[8]);
+    uint32_t on_disk = 0;
+    std::FILE* in = std::fopen(path, "rb");
+    const bool reread = in != nullptr && std::fseek(in, 4 * 100, SEEK_SET) == 0 && std::fread(&on_disk, sizeof on_disk, 1, in) == 1;
+    if (in != nullptr) std::fclose(in);
+    expect(reread && on_disk == 100, "Memory copy on write leaves the file", on_disk);
+    if (fd >= 0) unlink(path);
+}
+
+// Every workgroup runs once with its own ids: the loop at PC 28 runs x + 7y + 13z + 1 times
+// per wavefront, and the profile's count there must add up. Uneven loop counts across
+// several workers make them steal from each other.
+static void check_dispatch()
+{
+    const std::vector<uint32_t> kernel = program(
+        "s_mov_b32 s20, s3\n s_mulk_i32 s20, 7\n s_add_u32 s20, s20, s2\n"
+        "s_mov_b32 s21, s4\n s_mulk_i32 s21, 13\n s_add_u32 s20, s20, s21\n s_addk_i32 s20, 1\n"
+        "loop:\n s_nop 0\n s_addk_i32 s20, -1\n s_cmp_lg_u32 s20, 0\n s_cbranch_scc1 loop\n s_endpgm\n");
+    constexpr uint32_t LOOP = 28 / 4;
+
+    vega::Dispatcher dispatcher(4);
+    dispatcher.profiling = true;
+    std::mt19937_64 rng(8);
+    for (int round = 0; round < 200; ++round)
+    {
+        vega::DispatchParams p;
+        p.kernel = kernel;
+        uint64_t waves = 0, loops = 0, groups = 1, items = 1;
+        uint32_t count[3];
+        for (int d = 0; d < 3; ++d)
+        {
+            p.workgroup[d] = d == 0 ? 1 + rng() % 130 : 1 + rng() % 2;
+            p.grid[d]      = 1 + rng() % (d == 0 ? 400 : 5);
+            count[d]       = (p.grid[d] + p.workgroup[d] - 1) / p.workgroup[d];
+            groups        *= count[d];
+            items         *= p.workgroup[d];
+        }
+        const uint64_t per_group = (items + vega::Wavefront::LANES - 1) / vega::Wavefront::LANES;
+        for (uint32_t z = 0; z < count[2]; ++z)
+            for (uint32_t y = 0; y < count[1]; ++y)
+                for (uint32_t x = 0; x < count[0]; ++x)
+                {
+                    waves += per_group;
+                    loops += per_group * (x + 7 * y + 13 * z + 1);
+                }
+
+        const vega::DispatchResult r       = dispatcher.dispatch(p);
+        const vega::Profiler       profile = dispatcher.take_profile();
+        const uint64_t             seen    = profile.sites.size() > LOOP ? profile.sites[LOOP].count : 0;
+        expect(r.status == vega::Wavefront::Status::ENDED && r.workgroups == groups && r.wavefronts == waves && seen == loops,
+               "dispatch", static_cast<uint64_t>(round));
+    }
+
+    // Kernel arguments through Memory: the loop count is the first kernarg dword.
+    vega::Memory memory;
+    const uint32_t trips = 5;
+    memory.write(0x7F0000001000ULL, &trips, sizeof trips);
+    const std::vector<uint32_t> loader = program(
+        "s_load_dword s20, s[0:1], 0x0\n s_waitcnt 0\n"
+        "loop:\n s_nop 0\n s_addk_i32 s20, -1\n s_cmp_lg_u32 s20, 0\n s_cbranch_scc1 loop\n s_endpgm\n");
+    vega::DispatchParams p;
+    p.kernel          = loader;
+    p.grid[0]         = 64 * 9;
+    p.memory          = &memory;
+    p.kernarg_address = 0x7F0000001000ULL;
+    const vega::DispatchResult r       = dispatcher.dispatch(p);
+    const vega::Profiler       profile = dispatcher.take_profile();
+    expect(r.wavefronts == 9 && profile.sites.size() > 3 && profile.sites[3].count == 9 * trips, "dispatch kernarg", r.wavefronts);
+
+    // The first status other than ENDED is reported.
+    const uint32_t illegal[] = { 0xFFFFFFFF };
+    p = vega::DispatchParams{};
+    p.kernel  = illegal;
+    p.grid[0] = 64 * 3;
+    expect(dispatcher.dispatch(p).status == vega::Wavefront::Status::ILLEGAL, "dispatch ILLEGAL", 0);
+
+    // Workgroups past MAX_WORKGROUP_SIZE are refused, even when the work-item count wraps.
+    p = vega::DispatchParams{};
+    p.kernel = kernel;
+    const uint32_t sizes[][3] = { { 1024, 1, 1 }, { 32, 32, 1 }, { 1025, 1, 1 }, { 16, 16, 5 }, { 65536, 65536, 1 } };
+    for (const auto& size : sizes)
+    {
+        std::copy(size, size + 3, p.workgroup);
+        std::copy(size, size + 3, p.grid);
+        const vega::DispatchResult r = dispatcher.dispatch(p);
+        const bool fits = uint64_t{ size[0] } * size[1] * size[2] <= vega::DispatchParams::MAX_WORKGROUP_SIZE;
+        expect(fits ? r.status == vega::Wavefront::Status::ENDED && r.workgroups == 1 && r.wavefronts == 16
+                    : r.status == vega::Wavefront::Status::ILLEGAL && r.workgroups == 0 && r.wavefronts == 0,
+               "dispatch workgroup size", uint64_t{ size[0] } * size[1] * size[2]);
+    }
+    dispatcher.take_profile();
+}
+
+// Usage: test [b32|b64|fuse|cache|threaded|jit|batch|valu|dispatch|fold|disasm|elf|timing|trace|checkpoint|control|fuse_pairs|salu|memory] - no argument runs every section.
+int main(int argc, char** argv)
+{
+    const char* only = argc > 1 ? argv[1] : nullptr;
+    if (!only || std::strcmp(only, "b32") == 0) sweep_b32();
+    if (!only || std::strcmp(only, "b64") == 0) sweep_b64();
+    if (!only || std::strcmp(only, "fuse") == 0) check_fuse();
+    if (!only || std::strcmp(only, "cache") == 0) check_cache();
+    if (!only || std::strcmp(only, "threaded") == 0) check_threaded();
+    if (!only || std::strcmp(only, "jit") == 0) check_jit();
+    if (!only || std::strcmp(only, "batch") == 0) check_batch(vega::SOP1::ALL{}, vega::SOP2::ALL{});
+    if (!only || std::strcmp(only, "valu") == 0) check_valu(vega::VOP1::ALL{}, vega::VOP2::ALL{});
+    if (!only || std::strcmp(only, "dispatch") == 0) check_dispatch();
+    if (!only || std::strcmp(only, "fold") == 0) check_fold();
+    if (!only || std::strcmp(only, "disasm") == 0) check_disassembler();
+    if (!only || std::strcmp(only, "elf") == 0) check_code_object();
+    if (!only || std::strcmp(only, "timing") == 0) check_timing();
+    if (!only || std::strcmp(only, "trace") == 0) check_trace();
+    if (!only || std::strcmp(only, "checkpoint") == 0) check_checkpoint();
+    if (!only || std::strcmp(only, "control") == 0) check_control();
+    if (!only || std::strcmp(only, "fuse_pairs") == 0) check_fuse_pairs();
+    if (!only || std::strcmp(only, "salu") == 0) check_salu();
+    if (!only || std::strcmp(only, "memory") == 0) check_memory();
+
+    std::printf(failures == 0 ? "PASS\n" : "FAILED (%d)\n", failures.load());
+    return failures == 0 ? 0 : 1;
 }
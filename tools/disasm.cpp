@@ -0,0 +1,89 @@
+#include "../libs/code_object.hpp"
+#include "../libs/disassembler.hpp"
+#include "../libs/elf.hpp"
+#include "../libs/mapped_file.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+// Usage: disasm [--raw] [--bare] [--kernel <name>] <file>
+//   ELF code objects are disassembled from .text, anything else as raw little-endian words.
+//   --raw     treat an ELF file as raw words too
+//   --bare    no "// address: words" annotations
+//   --kernel  only the code of one kernel of an AMDGPU code object
+//
+// The file is mapped, not read: pages are faulted in as the single pass reaches them and
+// dropped again behind it, so memory stays flat however large the dump is.
+int main(int argc, char** argv)
+{
+    bool raw = false, bare = false;
+    const char* path   = nullptr;
+    const char* kernel = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--raw") == 0)                         raw = true;
+        else if (std::strcmp(argv[i], "--bare") == 0)                   bare = true;
+        else if (std::strcmp(argv[i], "--kernel") == 0 && i + 1 < argc) kernel = argv[++i];
+        else path = argv[i];
+    }
+    if (path == nullptr)
+    {
+        std::fprintf(stderr, "usage: disasm [--raw] [--bare] [--kernel <name>] <file>\n");
+        return 2;
+    }
+
+    vega::MappedFile file;
+    if (!file.open(path, true))
+    {
+        std::fprintf(stderr, "disasm: cannot open %s\n", path);
+        return 1;
+    }
+
+    size_t   begin = 0, end = file.size;
+    uint64_t address = 0;
+    if (kernel != nullptr)
+    {
+        vega::CodeObject object;
+        vega::Kernel     k;
+        if (object.open(file.bytes()) != vega::CodeObject::Status::OK || object.find(kernel, k) != vega::CodeObject::Status::OK)
+        {
+            std::fprintf(stderr, "disasm: no kernel %s in %s\n", kernel, path);
+            return 1;
+        }
+        begin   = static_cast<size_t>(reinterpret_cast<const uint8_t*>(k.code.data()) - file.data);
+        end     = begin + k.code.size_bytes();
+        address = begin; // file offset: a relocatable object has no load address
+    }
+    else if (!raw && vega::elf::is_elf64(file.bytes()))
+    {
+        vega::elf::Section text;
+        if (!vega::elf::find_section(file.bytes(), ".text", text))
+        {
+            std::fprintf(stderr, "disasm: %s has no .text section\n", path);
+            return 1;
+        }
+        begin   = static_cast<size_t>(text.offset);
+        end     = static_cast<size_t>(text.offset + text.size);
+        address = text.address;
+    }
+
+    constexpr size_t CHUNK = 16 << 20;
+    vega::Disassembler out(stdout);
+    out.annotate = !bare;
+    for (size_t at = begin; at < end && !out.failed;)
+    {
+        const size_t n    = std::min(CHUNK, end - at);
+        const size_t done = out.feed(file.bytes().subspan(at, n), address + (at - begin), at + n == end);
+        file.release(at, done);
+        at += done;
+    }
+    out.flush();
+    if (out.failed)
+    {
+        std::fprintf(stderr, "disasm: write failed\n");
+        return 1;
+    }
+    std::fprintf(stderr, "%llu instructions, %llu unknown words\n",
+                 static_cast<unsigned long long>(out.instructions), static_cast<unsigned long long>(out.unknown));
+    return 0;
+}
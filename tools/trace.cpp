@@ -0,0 +1,145 @@
+#include "../libs/disassembler.hpp"
+#include "../libs/mapped_file.hpp"
+#include "../libs/trace.hpp"
+#include <cstdio>
+#include <cstring>
+
+// Usage: trace [--json] <file.vtrace>
+//   Renders a trace written by TraceFile, one line per instruction, or as Chrome trace JSON
+//   (chrome://tracing, Perfetto) with one event per instruction: the timestamp is the
+//   instruction's position in its thread's stream, in microseconds.
+namespace
+{
+    using vega::TraceRecord;
+
+    // Re-encodes the instruction so the disassembler can print it with its operands.
+    size_t text(const TraceRecord& r, char* line)
+    {
+        uint32_t words[2] = { 0, 0 };
+        const auto format = static_cast<vega::Format>(r.format);
+        if (format == vega::Format::SOP1)
+        {
+            words[0] = vega::SOP1::BASE | (uint32_t{ r.SDST } << 16) | (uint32_t{ r.OP } << 8) | r.SSRC0;
+            words[1] = static_cast<uint32_t>(r.S0);
+        }
+        else if (format == vega::Format::SOP2)
+        {
+            words[0] = vega::SOP2::BASE | (uint32_t{ r.OP } << 23) | (uint32_t{ r.SDST } << 16) | (uint32_t{ r.SSRC1 } << 8) | r.SSRC0;
+            words[1] = static_cast<uint32_t>(r.SSRC0 == vega::Operand::LITERAL ? r.S0 : r.S1);
+        }
+        else if (format == vega::Format::SOPC)
+        {
+            words[0] = vega::SOPC::BASE | (uint32_t{ r.OP } << 16) | (uint32_t{ r.SSRC1 } << 8) | r.SSRC0;
+            words[1] = static_cast<uint32_t>(r.SSRC0 == vega::Operand::LITERAL ? r.S0 : r.S1);
+        }
+        else if (format == vega::Format::SOPK)
+        {
+            words[0] = vega::SOPK::BASE | (uint32_t{ r.OP } << 23) | (uint32_t{ r.SDST } << 16) | (uint32_t{ r.SSRC1 } << 8) | r.SSRC0;
+        }
+        else if (format == vega::Format::SOPP)
+        {
+            words[0] = vega::SOPP::BASE | (uint32_t{ r.OP } << 16) | (uint32_t{ r.SSRC1 } << 8) | r.SSRC0;
+        }
+        else if (format == vega::Format::SMEM)
+        {
+            using namespace vega::SmemBits;
+            words[0] = vega::SMEM::BASE | (uint32_t{ r.OP } << 18) | (r.SSRC1 & IMM ? 1u << 17 : 0) | (r.SSRC1 & GLC ? 1u << 16 : 0) |
+                       (r.SSRC1 & NV ? 1u << 15 : 0) | (r.SSRC1 & SOE ? 1u << 14 : 0) | (uint32_t{ r.SDST } << 6) | (r.SSRC0 >> 1u);
+            words[1] = static_cast<uint32_t>(r.S1);
+        }
+        else
+        {
+            vega::Instruction inst;
+            inst.format = format;
+            inst.OP     = r.OP;
+            const char* name = format == vega::Format::FOLDED ? "(folded)" : vega::instruction_name(inst);
+            return static_cast<size_t>(std::sprintf(line, "%s", name != nullptr ? name : "(unknown)"));
+        }
+        size_t length = 0;
+        vega::disassemble_one(reinterpret_cast<const uint8_t*>(words), 2, line, length);
+        return length;
+    }
+
+    void print_text(const TraceRecord& r, uint32_t thread)
+    {
+        char line[vega::MAX_DISASSEMBLY_LINE];
+        const size_t length = text(r, line);
+        std::printf("t%-3u w%-4u %10llu  %06x  %-40.*s  S0=%llx S1=%llx D=%llx SCC=%d->%d\n",
+                    thread, r.wave, static_cast<unsigned long long>(r.seq), r.PC, static_cast<int>(length), line,
+                    static_cast<unsigned long long>(r.S0), static_cast<unsigned long long>(r.S1),
+                    static_cast<unsigned long long>(r.D),
+                    (r.flags & TraceRecord::SCC_BEFORE) != 0, (r.flags & TraceRecord::SCC_AFTER) != 0);
+    }
+
+    void print_json(const TraceRecord& r, uint32_t thread, bool first)
+    {
+        char line[vega::MAX_DISASSEMBLY_LINE];
+        const size_t length = text(r, line);
+        size_t name = 0;
+        while (name < length && line[name] != ' ') ++name;
+        std::printf("%s\n{\"name\":\"%.*s\",\"ph\":\"X\",\"pid\":%u,\"tid\":%u,\"ts\":%llu,\"dur\":1,"
+                    "\"args\":{\"pc\":\"0x%x\",\"text\":\"%.*s\",\"S0\":\"0x%llx\",\"S1\":\"0x%llx\",\"D\":\"0x%llx\",\"SCC\":%d}}",
+                    first ? "" : ",", static_cast<int>(name), line, r.wave, thread,
+                    static_cast<unsigned long long>(r.seq), r.PC, static_cast<int>(length), line,
+                    static_cast<unsigned long long>(r.S0), static_cast<unsigned long long>(r.S1),
+                    static_cast<unsigned long long>(r.D), (r.flags & TraceRecord::SCC_AFTER) != 0);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool json = false;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--json") == 0) json = true;
+        else path = argv[i];
+    }
+    if (path == nullptr)
+    {
+        std::fprintf(stderr, "usage: trace [--json] <file.vtrace>\n");
+        return 2;
+    }
+
+    vega::MappedFile file;
+    vega::TraceHeader header;
+    if (!file.open(path, true) || file.size < sizeof(header))
+    {
+        std::fprintf(stderr, "trace: cannot read %s\n", path);
+        return 1;
+    }
+    std::memcpy(&header, file.data, sizeof(header));
+    if (header.magic != vega::TraceHeader::MAGIC || header.version != vega::TraceHeader::VERSION || header.record_size != sizeof(TraceRecord))
+    {
+        std::fprintf(stderr, "trace: %s is not a version %u trace\n", path, vega::TraceHeader::VERSION);
+        return 1;
+    }
+
+    if (json) std::printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    bool     first   = true;
+    uint64_t records = 0;
+    size_t   at      = sizeof(header);
+    while (at + 8 <= file.size)
+    {
+        uint32_t chunk[2];
+        std::memcpy(chunk, file.data + at, sizeof(chunk));
+        at += sizeof(chunk);
+        if (chunk[1] > (file.size - at) / sizeof(TraceRecord))
+        {
+            std::fprintf(stderr, "trace: truncated chunk at offset %zu\n", at - sizeof(chunk));
+            break;
+        }
+        for (uint32_t i = 0; i < chunk[1]; ++i, at += sizeof(TraceRecord))
+        {
+            TraceRecord r;
+            std::memcpy(&r, file.data + at, sizeof(r));
+            if (json) print_json(r, chunk[0], first);
+            else      print_text(r, chunk[0]);
+            first = false;
+            ++records;
+        }
+    }
+    if (json) std::printf("\n]}\n");
+    std::fprintf(stderr, "%llu records\n", static_cast<unsigned long long>(records));
+    return 0;
+}